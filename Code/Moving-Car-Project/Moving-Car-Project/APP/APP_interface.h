@@ -22,12 +22,23 @@
 #include "../HAL/EXTI_manager/EXTI_manager_interface.h"
 #include "../HAL/CAR_CONTROL/CAR_CONTROL_interface.h"
 #include "../HAL/TIMER_manager/TIMER_manger_interface.h"
+#include "../HAL/POWER/POWER_interface.h"
+#include "../HAL/PARAM/PARAM_interface.h"
+#include "../HAL/LOG/LOG_interface.h"
+#include "../HAL/TELEMETRY/TELEMETRY_interface.h"
+#include "../HAL/COMMAND/COMMAND_interface.h"
+#include "../HAL/SUPERVISOR/SUPERVISOR_interface.h"
+#include "../MCAL/STACK/STACK_interface.h"
+#include "MISSION/MISSION_interface.h"
+#include "FAULT/FAULT_interface.h"
+#include "PROFILE/PROFILE_interface.h"
+#include "SCHEDULER/SCHEDULER_interface.h"
 #include "../STD_LIB/bit_math.h"
 #include "../STD_LIB/std_types.h"
-/** @brief Motor 1 ID for application */
+/** @brief Motor 1 ID for application (left wheel) */
 #define	APP_MOTOR_1					0
 
-/** @brief Motor 2 ID for application */
+/** @brief Motor 2 ID for application (right wheel) */
 #define	APP_MOTOR_2					1
 
 /** @brief Maximum number of buttons in the application */
@@ -39,24 +50,155 @@
 /** @brief Start index for buttons in the application */
 #define APP_BTN_START_INDEX			0
 
-/** @brief Initial value for Timer 1 */
-#define APP_TIMER_1_INIT_VALUE		61628
+/** @brief Velocity of the motors on the long side in percent */
+#define APP_LONG_SIDE_SPEED			50
 
-/** @brief Initial value for Timer 0 */
-#define APP_TIMER_0_INIT_VALUE		240
+/** @brief Velocity of the motors on the short side in percent */
+#define APP_SHORT_SIDE_SPEED		30
+
+/** @brief Length of the long side in mm, driven by odometry within its 3.5 s timeout */
+#define APP_LONG_SIDE_MM			1000
+
+/** @brief Length of the short side in mm, driven by odometry within its 2 s timeout */
+#define APP_SHORT_SIDE_MM			400
+
+/** @brief Angle of the rotation at the corners in degrees (negative = right) */
+#define APP_ROTATE_ANGLE			(-90)
+
+/** @brief Route segment the car loops back to after the last one (the long side, after the 1 s start delay) */
+#define APP_ROUTE_LOOP_INDEX		1
+
+/** @brief Number of segments of the default route */
+#define APP_DEFAULT_ROUTE_SEGMENTS	9
+
+/** @brief Maximum number of segments of a route stored in the EEPROM */
+#define APP_ROUTE_MAX_SEGMENTS		16
+
+/** @brief EEPROM address of the parameter store */
+#define APP_PARAM_ADDRESS			0
+
+/** @brief Layout version of the parameter store, to be changed with app_str_params_t */
+#define APP_PARAM_VERSION			3
+
+/** @brief Number of system ticks per motor ramp tick */
+#define APP_MOTOR_RAMP_TICK_DIV		MOTOR_RAMP_TICK_MS
+
+/** @brief Number of system ticks per encoder sample */
+#define APP_ENCODER_TICK_DIV		ENCODER_POLL_MS
+
+/** @brief Number of system ticks per wheel speed control period */
+#define APP_SPEED_CTRL_TICK_DIV		CAR_SPEED_CTRL_PERIOD_MS
+
+/** @brief Default LED brightness level (0 .. 255), about 25% to save the battery */
+#define APP_LED_BRIGHTNESS			64
+
+/** @brief Timer 2 compare value for the 1 ms system tick (prescaler 64 and F_CPU = 8M) */
+#define APP_SYS_TICK_COMPARE_VALUE	124
+
+/** @brief Period of the control task in ms (program state and route) */
+#define APP_CONTROL_TASK_MS			1
+
+/** @brief Period of the button task in ms */
+#define APP_BUTTON_TASK_MS			10
+
+/** @brief Period of the LED task in ms, the time unit of the LED patterns */
+#define APP_LED_TASK_MS				10
+
+/** @brief Period of the event log task in ms */
+#define APP_LOG_TASK_MS				100
+
+/** @brief Period of the telemetry task in ms (a 24 byte status frame takes 6.3 ms at 38400 baud) */
+#define APP_TELEMETRY_TASK_MS		50
+
+/** @brief Period of the host command task in ms, a teleoperation setpoint reaches the car within one control tick */
+#define APP_COMMAND_TASK_MS			1
+
+/** @brief Period of the stack guard task in ms, a scan over 1.5 KB of unused stack takes 0.5 s */
+#define APP_STACK_TASK_MS			10
+
+/** @brief Stack that must stay unused in bytes, about one more interrupt with its call-used registers and a call deep */
+#define APP_STACK_GUARD_BYTES		64
+
+/** @brief Default time without a teleoperation setpoint before the car brakes in ms (10 setpoints at 50 Hz) */
+#define APP_TELEOP_TIMEOUT_MS		200
+
+/** @brief Shortest teleoperation timeout in ms */
+#define APP_TELEOP_TIMEOUT_MIN_MS	20
+
+/** @brief Longest teleoperation timeout in ms */
+#define APP_TELEOP_TIMEOUT_MAX_MS	2000
+
+/** @brief Default time the start button must stay pushed to start the car in ms */
+#define APP_BUTTON_DEBOUNCE_MS		30
+
+/** @brief Longest start button debounce time in ms */
+#define APP_BUTTON_DEBOUNCE_MAX_MS	200
+
+/** @brief Default time parked without a start press before the car powers down in ms (start button wakes it up) */
+#define APP_PARK_SLEEP_MS			30000
 
 /**
  * @brief Enumeration for the application's state based on button press
  */
 typedef enum {
     BTN_START = 0, /**< Start button pressed state */
-    BTN_STOP       /**< Stop button pressed state */
+    BTN_STOP,      /**< Stop button pressed state */
+    BTN_TELEOP     /**< Teleoperation state: the car follows the host setpoints */
 } app_enu_state_t;
 
 
 
 
 
+/**
+ * @brief Parameters of the application: the route and the tuning values.
+ *
+ * They are loaded from the EEPROM parameter store at boot, a blank or corrupt store is replaced by the defaults.
+ */
+typedef struct {
+    mission_str_segment_t astr_route[APP_ROUTE_MAX_SEGMENTS];	/**< Segments of the route. */
+    uint8_t  u8_route_segments_num;							/**< Number of segments of the route. */
+    uint8_t  u8_route_loop_index;							/**< Segment the route loops back to after the last one. */
+    uint8_t  u8_led_brightness;								/**< LED brightness level (0 .. 255). */
+    uint8_t  u8_heading_hold;								/**< TRUE to keep the straight segments on their heading. */
+    uint16_t u16_park_sleep_ms;								/**< Time parked before the car powers down in ms. */
+    uint8_t  u8_button_debounce_ms;							/**< Time the start button must stay pushed in ms. */
+    uint16_t u16_teleop_timeout_ms;							/**< Time without a teleoperation setpoint before the car brakes in ms. */
+} app_str_params_t;
+
+/**
+ * @brief Enumeration of the runtime parameters the host can read and change (the parameter number of the commands).
+ */
+typedef enum {
+    APP_PARAM_SEGMENT_DURATION = 0,		/**< Duration (or timeout) of a route segment in ms, index: segment. */
+    APP_PARAM_SEGMENT_SPEED,			/**< Velocity (duty cycle) of a route segment in percent, index: segment. */
+    APP_PARAM_SEGMENT_GOAL,				/**< Distance, angle or turn rate of a route segment, index: segment. */
+    APP_PARAM_LED_BRIGHTNESS,			/**< LED brightness level (0 .. 255). */
+    APP_PARAM_HEADING_HOLD,				/**< TRUE to keep the straight segments on their heading. */
+    APP_PARAM_PARK_SLEEP,				/**< Time parked before the car powers down in ms. */
+    APP_PARAM_BUTTON_DEBOUNCE,			/**< Time the start button must stay pushed in ms. */
+    APP_PARAM_TELEOP_TIMEOUT,			/**< Time without a teleoperation setpoint before the car brakes in ms. */
+    APP_PARAM_MAX						/**< Number of runtime parameters. */
+} app_enu_param_t;
+
+/**
+ * @brief Payload of the status frame sent by the telemetry task (#TELEMETRY_FRAME_STATUS, 16 bytes, little endian).
+ *
+ * The host decoder in Tools/telemetry_decode.py unpacks the same layout, both are to be changed together.
+ */
+typedef struct {
+    uint16_t u16_time_ms;				/**< Scheduler clock when the frame was built in ms. */
+    uint8_t  u8_state;					/**< Program state, see app_enu_state_t. */
+    uint8_t  u8_segment;				/**< Index of the current route segment. */
+    sint8_t  s8_velocity_left;			/**< Velocity (duty cycle) of the left motor in percent. */
+    sint8_t  s8_velocity_right;			/**< Velocity (duty cycle) of the right motor in percent. */
+    uint16_t u16_heading;				/**< Heading, binary angle counterclockwise from the start. */
+    uint32_t u32_distance_mm;			/**< Path length since the start in mm. */
+    uint16_t u16_speed_ctrl_cycles;		/**< Longest run of the speed control tick in CPU cycles. */
+    uint8_t  u8_idle_percent;			/**< Idle time of the last second in percent. */
+    uint8_t  u8_fault_mask;				/**< Overcurrent fault latches, one bit per motor. */
+} app_str_telemetry_t;
+
 /**
  * @brief LED IDs for the application
  */
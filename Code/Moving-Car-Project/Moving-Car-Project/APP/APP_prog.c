@@ -11,35 +11,97 @@
  */
 
 #include "APP_interface.h"
+#include "../MCAL/AVR_ARCH/ISR_interface.h"
+
+/** @brief Source file of the faults checked here */
+#define FAULT_UNIT	FAULT_UNIT_APP
 
 /***************************************************************************/
 /*******				Static function prototypes					*******/
 /***************************************************************************/
 
 static void APP_init(void);
-static void APP_timer0OvfHandeler(void);
-static void APP_timer1OvfHandeler(void);
+static void APP_timer0CompHandler(void);
+static void APP_sysTickHandler(void);
 static void APP_extInt0OvfHandeler(void);
-static void APP_longSide(void);
-static void APP_shortSide(void);
-static void APP_stop(void);
-static void App_rotate(void);
+static void APP_extInt1WakeHandler(void);
+static void APP_powerDown(void);
+static void APP_loadParams(void);
+static void APP_controlTask(void);
+static void APP_buttonTask(void);
+static void APP_ledTask(void);
+static void APP_telemetryTask(void);
+static void APP_stackTask(void);
+static uint8_t APP_saveParams(void);
+static void APP_applyBrightness(void);
+static void APP_applyHeadingHold(void);
+static void APP_enterStart(void);
+static void APP_enterStop(void);
 static void APP_startState(void);
-static void APP_stopState(void);
+static void APP_enterTeleop(void);
+static void APP_teleopState(void);
+static void APP_teleopHandler(sint8_t copy_s8_linear, sint8_t copy_s8_angular);
+static void APP_teleopWatch(void);
+static void APP_faultStop(void);
+static uint8_t APP_motorFault(void);
+static profile_enu_probe_t APP_stageProbe(app_enu_state_t copy_enu_state);
+static void APP_faultReaction(fault_enu_module_t copy_enu_module, fault_enu_reaction_t copy_enu_reaction);
 
 
 
 /** @brief External Interrupt 0 configuration structure */
 static extim_str_config_t gs_str_extim_config_0 ;
 
-/** @brief Program state */
-static app_enu_state_t gs_enu_app_state = BTN_STOP;
+/** @brief External Interrupt 1 configuration structure (start button, wakes the parked car up) */
+static extim_str_config_t gs_str_extim_config_1 ;
+
+/** @brief Time the car has been parked without a start press in ms */
+static uint16_t gs_u16_park_ms = 0;
+
+/** @brief Time the start button has been pushed in ms, counted up to the debounce time */
+static uint8_t gs_u8_start_pushed_ms = 0;
+
+/** @brief Program state, set to stop by the emergency stop interrupt */
+static volatile app_enu_state_t gv_enu_app_state = BTN_STOP;
+
+/** @brief Program state the control task has entered, starts different so the stop state is entered first */
+static app_enu_state_t gs_enu_app_entered_state = BTN_START;
+
+/** @brief Linear velocity of the last teleoperation setpoint in percent */
+static sint8_t gs_s8_teleop_linear = 0;
+
+/** @brief Angular velocity of the last teleoperation setpoint in percent */
+static sint8_t gs_s8_teleop_angular = 0;
+
+/** @brief Set by a new teleoperation setpoint until the control task applies it */
+static uint8_t gs_u8_teleop_new = FALSE;
 
-/** @brief Delay counter */
-uint8_t volatile gv_u8_delay = 0;
+/** @brief Scheduler clock of the last teleoperation setpoint in ms */
+static uint16_t gs_u16_teleop_last_ms = 0;
 
-/** @brief PWM counter */
-uint8_t volatile gv_u8_pwm = 0;
+/** @brief Set while the host streams setpoints, cleared when they stop for the teleoperation timeout */
+static uint8_t gs_u8_teleop_streaming = FALSE;
+
+/** @brief Set when a motor was cut by the overcurrent guard, cleared by the start button */
+static uint8_t gs_u8_motor_fault = FALSE;
+
+/** @brief Strongest reaction to a driver fault since the boot (fault_enu_reaction_t), a safe stop holds until the next reset */
+static volatile uint8_t gv_u8_fault_reaction = FAULT_REACTION_IGNORE;
+
+/** @brief Reaction to a driver fault the program state was entered with */
+static uint8_t gs_u8_fault_shown = FAULT_REACTION_IGNORE;
+
+/** @brief System ticks counted towards the next motor ramp tick */
+static uint8_t gs_u8_motor_ramp_tick_div = 0;
+
+/** @brief System ticks counted towards the next encoder sample */
+static uint8_t gs_u8_encoder_tick_div = 0;
+
+/** @brief System ticks counted towards the next speed control period */
+static uint8_t gs_u8_speed_ctrl_tick_div = 0;
+
+/** @brief Compare value of the LED modulation slot that starts on the next timer 0 compare match */
+static uint8_t gs_u8_led_bam_compare = LED_BAM_FIRST_SLOT_COMPARE;
 
 
 /**
@@ -62,19 +124,137 @@ const led_str_config_t gc_st_leds_config[] = {
     {PORTB, PIN0}
 };
 
+/** @brief Slow blink shown while the car is parked and armed: 500 ms on, 500 ms off */
+const led_str_pattern_t gc_st_led_pattern_armed = {
+	0x00000001, 2, 50
+};
+
+/** @brief Teleoperation: 2 fast flashes (100 ms) then a 700 ms pause */
+const led_str_pattern_t gc_st_led_pattern_teleop = {
+	0x00000005, 10, 10
+};
+
+/** @brief Motor fault code: 3 fast flashes (100 ms) then a 700 ms pause */
+const led_str_pattern_t gc_st_led_pattern_motor_fault = {
+	0x00000015, 10, 10
+};
+
+/** @brief Driver fault code, the car is stopped until the next reset: 4 fast flashes (100 ms) then a 500 ms pause */
+const led_str_pattern_t gc_st_led_pattern_driver_fault = {
+	0x00000055, 12, 10
+};
+
+/** @brief Shown while the car is parked and armed but runs degraded: 300 ms on, 700 ms off */
+const led_str_pattern_t gc_st_led_pattern_degraded = {
+	0x00000007, 10, 10
+};
+
+/**
+ * @brief Reactions to the driver faults, in fault_enu_module_t order
+ *
+ * Whatever could leave a motor driving or the stop button dead stops the car, so does a stack about to
+ * overwrite the variables; the car drives on without the watchdog, the power saving or the host link;
+ * a dark LED is only logged.
+ */
+const fault_enu_reaction_t gc_enu_app_fault_reactions[FAULT_MODULE_MAX] = {
+	FAULT_REACTION_IGNORE,		// LED
+	FAULT_REACTION_DEGRADE,		// BUTTON
+	FAULT_REACTION_SAFE_STOP,	// TIMER
+	FAULT_REACTION_SAFE_STOP,	// EXTI
+	FAULT_REACTION_SAFE_STOP,	// CAR
+	FAULT_REACTION_SAFE_STOP,	// MOTOR
+	FAULT_REACTION_SAFE_STOP,	// MISSION
+	FAULT_REACTION_SAFE_STOP,	// SCHED
+	FAULT_REACTION_DEGRADE,		// SUPERVISOR
+	FAULT_REACTION_DEGRADE,		// POWER
+	FAULT_REACTION_DEGRADE,		// COMMS
+	FAULT_REACTION_SAFE_STOP	// STACK
+};
+
+/**
+ * @brief Default parameters, used until the EEPROM holds a valid parameter store
+ *
+ * The route is a rectangle driven clockwise. Each segment gives the action, its duration in ms (the timeout of the sides
+ * and rotations, which end on the measured distance or angle), the speed in percent, the distance in mm or angle in degrees
+ * and the LED shown.
+ */
+const app_str_params_t gc_str_params_default = {
+	{
+		{MISSION_ACTION_STOP,   1000, 0,                    0,                 LED_STOP},			// Wait 1 s before starting
+		{MISSION_ACTION_DRIVE,  3500, APP_LONG_SIDE_SPEED,  APP_LONG_SIDE_MM,  LED_LONG_SIDE},		// Long side, loop starts here
+		{MISSION_ACTION_STOP,    500, 0,                    0,                 LED_STOP},
+		{MISSION_ACTION_ROTATE, 1000, 0,                    APP_ROTATE_ANGLE,  LED_ROTATE},
+		{MISSION_ACTION_STOP,    500, 0,                    0,                 LED_STOP},
+		{MISSION_ACTION_DRIVE,  2000, APP_SHORT_SIDE_SPEED, APP_SHORT_SIDE_MM, LED_SHORT_SIDE},
+		{MISSION_ACTION_STOP,    500, 0,                    0,                 LED_STOP},
+		{MISSION_ACTION_ROTATE, 1000, 0,                    APP_ROTATE_ANGLE,  LED_ROTATE},
+		{MISSION_ACTION_STOP,    500, 0,                    0,                 LED_STOP}
+	},
+	APP_DEFAULT_ROUTE_SEGMENTS, APP_ROUTE_LOOP_INDEX,
+	APP_LED_BRIGHTNESS, TRUE, APP_PARK_SLEEP_MS, APP_BUTTON_DEBOUNCE_MS, APP_TELEOP_TIMEOUT_MS
+};
+
+/** @brief Parameters in use, loaded at boot and changed by the host commands */
+static app_str_params_t gs_str_params;
+
+/** @brief Copy of the parameters being saved, the EEPROM reads it in the background while the host changes the parameters */
+static app_str_params_t gs_str_params_saved;
+
+/**
+ * @brief Runtime parameters of the host commands, in app_enu_param_t order
+ *
+ * A segment duration takes effect at once, even on the running segment; the speed and goal take effect
+ * the next time their segment starts. The other parameters take effect at once.
+ */
+const cmd_str_param_t gc_str_app_params[] = {
+	{&gs_str_params.astr_route[0].u16_duration_ms, 2, FALSE, APP_ROUTE_MAX_SEGMENTS, sizeof(mission_str_segment_t), 0, 65535, NULL},
+	{&gs_str_params.astr_route[0].s8_speed, 1, TRUE, APP_ROUTE_MAX_SEGMENTS, sizeof(mission_str_segment_t), -100, 100, NULL},
+	{&gs_str_params.astr_route[0].s16_goal, 2, TRUE, APP_ROUTE_MAX_SEGMENTS, sizeof(mission_str_segment_t), -32768, 32767, NULL},
+	{&gs_str_params.u8_led_brightness, 1, FALSE, 1, 0, 0, 255, APP_applyBrightness},
+	{&gs_str_params.u8_heading_hold, 1, FALSE, 1, 0, FALSE, TRUE, APP_applyHeadingHold},
+	{&gs_str_params.u16_park_sleep_ms, 2, FALSE, 1, 0, APP_BUTTON_TASK_MS, 65535, NULL},
+	{&gs_str_params.u8_button_debounce_ms, 1, FALSE, 1, 0, 0, APP_BUTTON_DEBOUNCE_MAX_MS, NULL},
+	{&gs_str_params.u16_teleop_timeout_ms, 2, FALSE, 1, 0, APP_TELEOP_TIMEOUT_MIN_MS, APP_TELEOP_TIMEOUT_MAX_MS, NULL}
+};
+
+/** @brief Route driven while started, made of the parameters segments */
+static mission_str_route_t gs_str_route;
+
+/**
+ * @brief Task table of the cooperative scheduler, in priority order (period and offset in ms)
+ *
+ * The offsets keep the 10 ms tasks off the same tick. The commands run first, the control task applies
+ * a teleoperation setpoint on the tick it was received.
+ */
+const sched_str_task_t gc_str_app_tasks[] = {
+	{COMMAND_task,      APP_COMMAND_TASK_MS,   0},
+	{APP_controlTask,   APP_CONTROL_TASK_MS,   0},
+	{APP_buttonTask,    APP_BUTTON_TASK_MS,    1},
+	{APP_ledTask,       APP_LED_TASK_MS,       2},
+	{LOG_task,          APP_LOG_TASK_MS,       3},
+	{APP_telemetryTask, APP_TELEMETRY_TASK_MS, 5},
+	{APP_stackTask,     APP_STACK_TASK_MS,     4}
+};
+
+/** @brief Wheel encoders configuration structure (left wheel, right wheel) */
+const encoder_str_config_t gc_str_encoder_config[]={
+	{PORTC,PIN0},
+	{PORTC,PIN1}
+};
+
 /** @brief Buttons configuration structure */
 const btn_str_config_t gc_str_btn_config[]={
 	{PORTD,PIN3},
 	{PORTD,PIN2}
 };
 
-/** @brief Motors configuration structure  */
+/** @brief Motors configuration structure (pins, Timer 1 compare unit, gain trim, offset trim, current shunt input) */
 const motor_str_config_t gc_str_motor_config[]={
 	{
-		PORTA,PIN3,PIN4
+		PORTA,PIN3,PIN4,TIMER_COMPARE_UNIT_A,MOTOR_GAIN_NO_TRIM,0,ANA_COMP_NEG_ADC2		// shunt on PA2
 	},
 	{
-		PORTA,PIN0,PIN1
+		PORTA,PIN0,PIN1,TIMER_COMPARE_UNIT_B,MOTOR_GAIN_NO_TRIM,0,ANA_COMP_NEG_AIN1		// shunt on PB3
 	}
 };
 
@@ -84,15 +264,22 @@ const motor_str_config_t gc_str_motor_config[]={
 
 
 
-// Will be used to generate delay 
+// Timer 1 configuration structure
+// Free running at F_CPU, its compare units generate the motors duty cycle (no overflow interrupt)
 const timerm_str_config_t gc_st_timer_1 = {
-		TIMER_1 , TIMER_NORMAL_MODE , APP_TIMER_1_INIT_VALUE , ((uint16_t)NULL) , APP_timer1OvfHandeler
+		TIMER_1 , TIMER_NORMAL_MODE , INTIALIZE_TIMER_WITH_ZERO , 0 , NULL
 };
 
 // Timer 0 configuration structure 
-// Will be used to generate PWM
+// Will be used to generate the LED bit-angle modulation slots
 const timerm_str_config_t gc_st_timer_0 = {
-	TIMER_0 , TIMER_NORMAL_MODE , APP_TIMER_0_INIT_VALUE , ((uint16_t)NULL) , APP_timer0OvfHandeler
+	TIMER_0 , TIMER_CTC_MODE , INTIALIZE_TIMER_WITH_ZERO , LED_BAM_FIRST_SLOT_COMPARE , APP_timer0CompHandler
+};
+
+// Timer 2 configuration structure
+// Will be used to generate the 1 ms system tick
+const timerm_str_config_t gc_st_timer_2 = {
+	TIMER_2 , TIMER_CTC_MODE , INTIALIZE_TIMER_WITH_ZERO , APP_SYS_TICK_COMPARE_VALUE , APP_sysTickHandler
 };
 
 void APP_start(void)
@@ -102,16 +289,8 @@ void APP_start(void)
 	
 	while(1)
 	{
-		while (gs_enu_app_state == BTN_STOP)
-		{
-			// Perform stop state routine 
-			APP_stopState();
-		}
-		while (gs_enu_app_state == BTN_START)
-		{
-			// Perform start state routine
-			APP_startState();
-		}
+		// Run the tasks as they are released by the system tick
+		SCHED_dispatch();
 	}
 }
 
@@ -122,265 +301,697 @@ void APP_start(void)
  */
 void APP_init(void)
 {
+	// Read why the car was reset, before the watchdog can run again
+	SUPERVISOR_init();
+	
+	// Find the end of the event log before anything else writes the EEPROM
+	LOG_init();
+	LOG_event(LOG_EVENT_BOOT,SUPERVISOR_get_reset_cause(),SUPERVISOR_get_missed());
+	
+	// Every driver call is checked from now on
+	FAULT_init(gc_enu_app_fault_reactions,APP_faultReaction);
+	
+	// Switch the unused peripherals off
+	FAULT_CHECK(FAULT_MODULE_POWER,POWER_init());
+	
+	// Route and tuning from the EEPROM
+	APP_loadParams();
+	
 	// Initialize all LEDs
 	for(uint8_t u8_index = U8_ZERO_VALUE ; u8_index < APP_LED_MAX_NUM ; u8_index++)
 	{
-		LED_init(&gc_st_leds_config[u8_index]);
+		FAULT_CHECK(FAULT_MODULE_LED,LED_init(&gc_st_leds_config[u8_index]));
 	}
 	
+	// Hand all LEDs to the pattern engine and dim them with bit-angle modulation
+	FAULT_CHECK(FAULT_MODULE_LED,LED_group_init(gc_st_leds_config,APP_LED_MAX_NUM));
+	FAULT_CHECK(FAULT_MODULE_LED,LED_bam_init());
+	APP_applyBrightness();
+	
 	// Initialize all buttons
 	for (uint8_t u8_index = U8_ZERO_VALUE ; u8_index < APP_BUTTON_MAX_NUM ; u8_index++)
 	{
-		BTN_init((gc_str_btn_config+u8_index));
+		FAULT_CHECK(FAULT_MODULE_BUTTON,BTN_init((gc_str_btn_config+u8_index)));
 	}
 	
+	// Initialize Timer 1 and let it run freely for the motors duty cycle
+	FAULT_CHECK(FAULT_MODULE_TIMER,TIMER_MANGER_init(&gc_st_timer_1));
+	FAULT_CHECK(FAULT_MODULE_TIMER,TIMER_MANGER_start(F_CPU_CLOCK,TIMER_1));
+	
 	// Initialize car module
 	
-	CAR_INIT(&gc_str_motor_config[APP_MOTOR_1],&gc_str_motor_config[APP_MOTOR_2]);
-
+	FAULT_CHECK(FAULT_MODULE_CAR,CAR_INIT(&gc_str_motor_config[APP_MOTOR_1],&gc_str_motor_config[APP_MOTOR_2]));
+	
+	// Hold the wheel speeds with the encoders, whatever the battery level and the floor
+	FAULT_CHECK(FAULT_MODULE_CAR,CAR_speed_control_init(&gc_str_encoder_config[APP_MOTOR_1],&gc_str_encoder_config[APP_MOTOR_2]));
+	
+	// Keep the sides straight despite the motors mismatch
+	APP_applyHeadingHold();
+	
+	// Watch the motors current with the analog comparator
+	FAULT_CHECK(FAULT_MODULE_MOTOR,MOTOR_guard_init());
+	
+	// Stream the status of the car to the host, which can tune the parameters
+	FAULT_CHECK(FAULT_MODULE_COMMS,TELEMETRY_init());
+	FAULT_CHECK(FAULT_MODULE_COMMS,COMMAND_init(gc_str_app_params,APP_PARAM_MAX,APP_saveParams));
+	COMMAND_set_teleop_handler(APP_teleopHandler);
+	
+	// The route segments show their LED
+	FAULT_CHECK(FAULT_MODULE_MISSION,MISSION_init(gc_st_leds_config,APP_LED_MAX_NUM));
 	
-	// Initialize Timer 1
-	TIMER_MANGER_init(&gc_st_timer_1);
+	// Tasks are released by the system tick
+	FAULT_CHECK(FAULT_MODULE_SCHED,SCHED_init(gc_str_app_tasks,sizeof(gc_str_app_tasks) / sizeof(gc_str_app_tasks[0])));
 	
+	// Every task must return within the supervisor window, or the watchdog resets the car with the motors off
+	FAULT_CHECK(FAULT_MODULE_SUPERVISOR,SUPERVISOR_start(sizeof(gc_str_app_tasks) / sizeof(gc_str_app_tasks[0])));
+
+	
+	// Initialize Timer 0 and start the LED modulation
+	FAULT_CHECK(FAULT_MODULE_TIMER,TIMER_MANGER_init(&gc_st_timer_0));
+	FAULT_CHECK(FAULT_MODULE_TIMER,TIMER_MANGER_start(F_CPU_256,TIMER_0));
 	
-	// Initialize Timer 0
-	TIMER_MANGER_init(&gc_st_timer_0);
+	// Initialize Timer 2 and start the system tick
+	FAULT_CHECK(FAULT_MODULE_TIMER,TIMER_MANGER_init(&gc_st_timer_2));
+	FAULT_CHECK(FAULT_MODULE_TIMER,TIMER_MANGER_start(F_CPU_64,TIMER_2));
 	
 	// Initialize External Interrupt module
 	
 	gs_str_extim_config_0.enu_exti_interrupt_no = EXTI_0;
 	gs_str_extim_config_0.enu_edge_detection = EXTI_FALLING_EDGE;
-	extim_init(&gs_str_extim_config_0,APP_extInt0OvfHandeler);
+	FAULT_CHECK(FAULT_MODULE_EXTI,extim_init(&gs_str_extim_config_0,APP_extInt0OvfHandeler));
+	
+	// Only a low level on INT1 wakes the CPU from Power-down, it is enabled just before
+	gs_str_extim_config_1.enu_exti_interrupt_no = EXTI_1;
+	gs_str_extim_config_1.enu_edge_detection = EXTI_LOW_LEVEL;
+	FAULT_CHECK(FAULT_MODULE_EXTI,extim_init(&gs_str_extim_config_1,APP_extInt1WakeHandler));
 	
 
 }
 
 
 /**
- * @brief Timer 0 overflow handler.
+ * @brief Timer 0 compare match handler.
  *
- * This function is called when timer 0 overflows. It increments the PWM counter and sets the timer for generating PWM.
+ * This function is called at the end of every LED modulation slot. It loads the length of the new slot first,
+ * then outputs the LEDs of the slot (LSB slot is 64 us with prescaler 256 and F_CPU = 8M, frame is 16.3 ms).
  */
-void APP_timer0OvfHandeler(void)
+void APP_timer0CompHandler(void)
 {
-	// Increment PWM counter
-	gv_u8_pwm++;
-	// Set timer 0 with the Initial value to generate interrupt every 2 ms
-	TIMER_MANGER_setValue(TIMER_0,gc_st_timer_0.u16_timer_initial_value);		// 2 ms with prescaler 1024 and F_CPU = 8M
+	FAULT_CHECK(FAULT_MODULE_TIMER,TIMER_MANGER_setCompare(TIMER_0,gs_u8_led_bam_compare));
+	gs_u8_led_bam_compare = LED_bam_tick();
 }
 
 /**
- * @brief Timer 1 overflow handler.
+ * @brief System tick handler.
  *
- * This function is called when timer 1 overflows. It increments the delay counter and sets the timer for generating a delay.
+ * This function is called every 1 ms by timer 2 compare match. It releases the application tasks,
+ * closes the watchdog supervisor window, counts the time of the route segment, moves the overcurrent guard
+ * to the next motor, samples the wheel encoders, ramps the motors every 2 ms, and runs the wheel speed
+ * control every 10 ms.
  */
-void APP_timer1OvfHandeler(void)
+void APP_sysTickHandler(void)
 {
-	// Increment Delay counter
-	gv_u8_delay++;
-	// Set timer 1 value to generate interrupt every 500 ms
-	TIMER_MANGER_setValue(TIMER_1,gc_st_timer_1.u16_timer_initial_value);	// 500 ms with prescaler 1024 and F_CPU = 8M
+	// Watch the next motor current
+	MOTOR_guard_tick();
+	
+
+	// Release the due tasks and service the watchdog if they all checked in
+	SCHED_tick();
+	SUPERVISOR_tick();
+	
+	// Count the time of the route segment
+	MISSION_tick();
+	
+	// Count the wheel encoder edges
+	gs_u8_encoder_tick_div++;
+	if (gs_u8_encoder_tick_div >= APP_ENCODER_TICK_DIV)
+	{
+		gs_u8_encoder_tick_div = U8_ZERO_VALUE;
+		ENCODER_poll();
+	}
+	
+	// Correct the motors velocity from the measured wheel speeds
+	gs_u8_speed_ctrl_tick_div++;
+	if (gs_u8_speed_ctrl_tick_div >= APP_SPEED_CTRL_TICK_DIV)
+	{
+		gs_u8_speed_ctrl_tick_div = U8_ZERO_VALUE;
+		CAR_speed_control_tick();
+	}
+	
+	// Move the motors velocity towards their targets
+	gs_u8_motor_ramp_tick_div++;
+	if (gs_u8_motor_ramp_tick_div >= APP_MOTOR_RAMP_TICK_DIV)
+	{
+		gs_u8_motor_ramp_tick_div = U8_ZERO_VALUE;
+		MOTOR_ramp_tick();
+	}
 }
 
 /**
  * @brief External Interrupt 0 overflow handler.
  *
- * This function is called when external interrupt 0 is triggered. It resets the delay and PWM counters and changes the program state to stop.
+ * This function is called when external interrupt 0 is triggered. It brakes the car at once, stops the route
+ * and changes the program state to stop.
  */
 void APP_extInt0OvfHandeler(void)
 {
-	// Set Delay counter and PWM Counter to zero
-	gv_u8_delay = U8_ZERO_VALUE;
-	gv_u8_pwm = U8_ZERO_VALUE;
+	// Emergency stop: short both motors with one precomputed port write for the shortest stopping distance
+	FAULT_CHECK(FAULT_MODULE_CAR,CAR_apply(CAR_PRIMITIVE_BRAKE));
+	LOG_event(LOG_EVENT_ESTOP,MISSION_get_segment(),U8_ZERO_VALUE);
+	
+
+	// Stop the route, it restarts from its first segment
+	MISSION_stop();
 	
 	// Change program state to stop 
-	gs_enu_app_state = BTN_STOP;
+	gv_enu_app_state = BTN_STOP;
 }
 
 
 /**
- * @brief Handles the long side routine.
+ * @brief Loads the parameters from the EEPROM parameter store.
  *
- * This function turns off other LEDs and turns on the long side LED, then moves the car forward with 50% speed for a certain duration.
+ * A blank or corrupt store, or one from another layout version, is replaced by the defaults,
+ * which are saved in the background for the next boot.
  */
-void APP_longSide(void)
+void APP_loadParams(void)
 {
-	// Turn all LEDs off and turn long side LED on
-	LED_off((gc_st_leds_config+LED_SHORT_SIDE));
-	LED_on((gc_st_leds_config+LED_LONG_SIDE));
-	LED_off((gc_st_leds_config+LED_ROTATE));
-	LED_off((gc_st_leds_config+LED_STOP));
-	
+	gs_str_params = gc_str_params_default;
+	if ((PARAM_load(APP_PARAM_ADDRESS,&gs_str_params,sizeof(gs_str_params),APP_PARAM_VERSION) != PARAM_OK)
+		|| (gs_str_params.u8_route_segments_num > APP_ROUTE_MAX_SEGMENTS))
+	{
+		gs_str_params = gc_str_params_default;
+		APP_saveParams();
+	}
 	
-	// car move forward with 50% speed
+	gs_str_route.ptr_str_segments = gs_str_params.astr_route;
+	gs_str_route.u8_segments_num = gs_str_params.u8_route_segments_num;
+	gs_str_route.u8_loop_index = gs_str_params.u8_route_loop_index;
+}
+
+/**
+ * @brief Saves the parameters to the EEPROM parameter store in the background.
+ *
+ * @return TRUE if the save was started, FALSE if the EEPROM is still writing.
+ */
+uint8_t APP_saveParams(void)
+{
+	uint8_t u8_started = FALSE;
 	
-	gv_u8_pwm = 0;
-	TIMER_MANGER_start(F_CPU_1024,TIMER_0);							// start timer 0
-	while (gv_u8_pwm <= 5)						// 10 ms ON
+	// The copy must not change until the EEPROM is idle again
+	if (EEPROM_is_idle() == TRUE)
 	{
-		CAR_FORWARD(&gc_str_motor_config[0],&gc_str_motor_config[1]);
+		gs_str_params_saved = gs_str_params;
+		u8_started = (PARAM_save(APP_PARAM_ADDRESS,&gs_str_params_saved,sizeof(gs_str_params_saved),APP_PARAM_VERSION) == PARAM_OK) ? TRUE : FALSE;
 	}
-	while (gv_u8_pwm > 5 && gv_u8_pwm <= 10)	// 10 ms OFF
+	return u8_started;
+}
+
+/**
+ * @brief Applies the LED brightness parameter to all LEDs.
+ */
+void APP_applyBrightness(void)
+{
+	for(uint8_t u8_index = U8_ZERO_VALUE ; u8_index < APP_LED_MAX_NUM ; u8_index++)
 	{
-		CAR_STOP(&gc_str_motor_config[0],&gc_str_motor_config[1]);
+		FAULT_CHECK(FAULT_MODULE_LED,LED_bam_set_brightness(u8_index,gs_str_params.u8_led_brightness));
 	}
-	TIMER_MANGER_stop(TIMER_0);										// stop timer 0
-	gv_u8_pwm = 0;
 }
 
+/**
+ * @brief Applies the heading hold parameter.
+ */
+void APP_applyHeadingHold(void)
+{
+	CAR_set_heading_hold(gs_str_params.u8_heading_hold);
+}
 
 /**
- * @brief Handles the short side routine.
+ * @brief External Interrupt 1 handler.
  *
- * This function turns off other LEDs and turns on the short side LED, then moves the car forward with 30% speed for a certain duration.
+ * This function is called when the start button wakes the parked car up. The low level interrupt is disabled
+ * at once or it would fire again until the button is released.
  */
-void APP_shortSide(void)
+void APP_extInt1WakeHandler(void)
 {
-	// Turn all LEDs off and turn short side LED on
-	LED_on((gc_st_leds_config+LED_SHORT_SIDE));
-	LED_off((gc_st_leds_config+LED_LONG_SIDE));
-	LED_off((gc_st_leds_config+LED_ROTATE));
-	LED_off((gc_st_leds_config+LED_STOP));
+	FAULT_CHECK(FAULT_MODULE_EXTI,extim_disable(&gs_str_extim_config_1));
+}
+
+/**
+ * @brief Powers the parked car down until the start button is pressed.
+ *
+ * The LEDs go dark while asleep and the watchdog is stopped, the system tick can't service it.
+ * After the wake up the watchdog, the LED modulation and the overcurrent guard are started again and the stop LED blinks,
+ * the button task then reads the press that woke the car up and starts it. Only the start button wakes it up,
+ * the host can neither send commands nor teleoperate a powered down car.
+ */
+void APP_powerDown(void)
+{
+	const led_str_pattern_t *ptr_str_pattern;
 	
+	FAULT_CHECK(FAULT_MODULE_LED,LED_pattern_stop(LED_STOP));
 	
-	// move forward with 30% speed
+	// The modulation only writes the pins on its next slot, the LEDs are blanked before the clocks stop
+	FAULT_CHECK(FAULT_MODULE_TIMER,TIMER_MANGER_stop(TIMER_0));
+	FAULT_CHECK(FAULT_MODULE_LED,LED_group_blank());
 	
-	gv_u8_pwm = 0;
-	TIMER_MANGER_start(F_CPU_1024,TIMER_0);									// start timer 0
-	while (gv_u8_pwm <= 3)							// 6 ms ON
+	FAULT_CHECK(FAULT_MODULE_EXTI,extim_enable(&gs_str_extim_config_1));
+	SUPERVISOR_suspend();
+	FAULT_CHECK(FAULT_MODULE_POWER,POWER_power_down());
+	SUPERVISOR_resume();
+	FAULT_CHECK(FAULT_MODULE_TIMER,TIMER_MANGER_start(F_CPU_256,TIMER_0));
+	
+	// Awake: the comparator was powered off while asleep
+	FAULT_CHECK(FAULT_MODULE_MOTOR,MOTOR_guard_init());
+	if (gv_u8_fault_reaction == FAULT_REACTION_DEGRADE)
 	{
-		CAR_FORWARD(&gc_str_motor_config[0],&gc_str_motor_config[1]);
+		ptr_str_pattern = &gc_st_led_pattern_degraded;
 	}
-	while (gv_u8_pwm > 3 && gv_u8_pwm <= 10)		// 14 ms OFF
+	else
 	{
-		CAR_STOP(&gc_str_motor_config[0],&gc_str_motor_config[1]);
+		ptr_str_pattern = &gc_st_led_pattern_armed;
 	}
-	TIMER_MANGER_stop(TIMER_0);										// stop timer 0
-	gv_u8_pwm = 0;
+	FAULT_CHECK(FAULT_MODULE_LED,LED_pattern_start(LED_STOP,ptr_str_pattern,U8_ZERO_VALUE));
+	gs_u16_park_ms = U8_ZERO_VALUE;
 }
 
 /**
- * @brief Handles the stop routine.
+ * @brief Control task, runs every 1 ms.
  *
- * This function turns off other LEDs and turns on the stop LED, then stops the car motors.
+ * This function enters the program state on its change, runs the route while the car is started
+ * and follows the host setpoints during teleoperation. The profiler times every state and route action.
  */
-void APP_stop(void)
+void APP_controlTask(void)
 {
-	// Turn all LEDs off and turn stop LED on
-	LED_off((gc_st_leds_config+LED_SHORT_SIDE));
-	LED_off((gc_st_leds_config+LED_LONG_SIDE));
-	LED_off((gc_st_leds_config+LED_ROTATE));
-	LED_on((gc_st_leds_config+LED_STOP));
+	app_enu_state_t enu_state;
+	uint8_t u8_fault_reaction;
+	profile_enu_probe_t enu_probe;
+	profile_str_start_t str_start;
+	
+	// Brake first if the host setpoints stopped
+	APP_teleopWatch();
+	enu_state = gv_enu_app_state;
+	u8_fault_reaction = gv_u8_fault_reaction;
 	
+	// Time the state, a route segment by its action (taken before the route moves on)
+	enu_probe = APP_stageProbe(enu_state);
+	PROFILE_start(&str_start);
 	
-	// Here We Will STOP motors
-	CAR_STOP(&gc_str_motor_config[0],&gc_str_motor_config[1]);
+	// A new fault reaction enters the state again to show it
+	if ((enu_state != gs_enu_app_entered_state) || (u8_fault_reaction != gs_u8_fault_shown))
+	{
+		gs_enu_app_entered_state = enu_state;
+		gs_u8_fault_shown = u8_fault_reaction;
+		if (enu_state == BTN_START)
+		{
+			APP_enterStart();
+		}
+		else if (enu_state == BTN_TELEOP)
+		{
+			APP_enterTeleop();
+		}
+		else
+		{
+			APP_enterStop();
+		}
+	}
+	
+	if (enu_state == BTN_START)
+	{
+		APP_startState();
+	}
+	else if (enu_state == BTN_TELEOP)
+	{
+		APP_teleopState();
+	}
+	else
+	{
+		// Parked
+	}
+	PROFILE_stop(enu_probe,&str_start);
 }
 
-
 /**
- * @brief Handles the rotation routine.
+ * @brief Finds the profiler probe of a program state.
  *
- * This function turns off other LEDs and turns on the rotate LED, then rotates the car to the right with 50% speed to achieve a 90-degree rotation.
+ * @param copy_enu_state The program state.
+ * @return The probe of the state, or of the action of the current route segment in the start state.
  */
-void App_rotate(void)
+profile_enu_probe_t APP_stageProbe(app_enu_state_t copy_enu_state)
 {
-	// Turn all LEDs off and turn rotate LED on
-	LED_off((gc_st_leds_config+LED_SHORT_SIDE));
-	LED_off((gc_st_leds_config+LED_LONG_SIDE));
-	LED_on((gc_st_leds_config+LED_ROTATE));
-	LED_off((gc_st_leds_config+LED_STOP));
-	
+	profile_enu_probe_t enu_probe = PROFILE_PROBE_STOP_STATE;
+	uint8_t u8_segment;
 	
-	
-	// rotate to right with 50% speed for 0.5 s to achieve 90 degree rotate to side
-	gv_u8_pwm = 0;
-	TIMER_MANGER_start(F_CPU_1024,TIMER_0);									// start timer 0
-	while (gv_u8_pwm <= 5)							// 10 ms ON
+	if (copy_enu_state == BTN_START)
+	{
+		u8_segment = MISSION_get_segment();
+		enu_probe = (profile_enu_probe_t)(PROFILE_PROBE_ROUTE_FIRST + ((u8_segment < gs_str_route.u8_segments_num) ?
+																	  gs_str_route.ptr_str_segments[u8_segment].enu_action : MISSION_ACTION_STOP));
+	}
+	else if (copy_enu_state == BTN_TELEOP)
 	{
-		CAR_REVERSE_RIGHT(&gc_str_motor_config[0],&gc_str_motor_config[1]);
+		enu_probe = PROFILE_PROBE_TELEOP_STATE;
 	}
-	while (gv_u8_pwm > 5 && gv_u8_pwm <= 10)		// 10 ms OFF
+	else
 	{
-		CAR_STOP(&gc_str_motor_config[0],&gc_str_motor_config[1]);
+		// Parked
 	}
-	TIMER_MANGER_stop(TIMER_0);										// stop timer 0
-	gv_u8_pwm = 0;
+	return enu_probe;
 }
 
 /**
- * @brief Handles the start state routine.
+ * @brief Button task, runs every 10 ms.
  *
- * This function enables external interrupt 0, starts timer 1, and performs specific actions based on delay value for the start state.
+ * This function reads the start button while the car is parked, it starts the car once pushed for the debounce time. Starting clears the motor faults
+ * and starts the route from the origin of the odometry. A car parked for the park sleep time powers down,
+ * unless it shows a motor fault. Every frame of the host restarts the park time: the link can't wake the car up.
  */
-void APP_startState(void)
+void APP_buttonTask(void)
 {
-	extim_enable(&gs_str_extim_config_0);											// Enable External interrupt 0
-	TIMER_MANGER_start(F_CPU_1024,TIMER_1);						// start timer 1
-	if (gv_u8_delay>= 2)										// 1s delay
+	btn_enu_state_t enu_btn_state = BTN_RELEASED;
+	
+	if (gv_enu_app_state == BTN_STOP)
 	{
-		if (gv_u8_delay <= 8 )									// longest side for 3s with speed 50%
+		// Read Start Button state
+		FAULT_CHECK(FAULT_MODULE_BUTTON,BTN_get_state(&gc_str_btn_config[APP_BTN_START_INDEX],&enu_btn_state));
+		
+		// The button must stay pushed for the debounce time, a glitch does not start the car
+		if (enu_btn_state == BTN_RELEASED)
 		{
-			APP_longSide();
+			gs_u8_start_pushed_ms = U8_ZERO_VALUE;
 		}
-		else if (gv_u8_delay>8 && gv_u8_delay <=9)				// stop for 0.5
+		else if (gs_u8_start_pushed_ms < APP_BUTTON_DEBOUNCE_MAX_MS)
 		{
-			APP_stop();
+			gs_u8_start_pushed_ms += APP_BUTTON_TASK_MS;
 		}
-		else if (gv_u8_delay >9 && gv_u8_delay <=10)			// rotate 90 degree to right
+		else
 		{
-			App_rotate();
+			// Pushed for longer than any debounce time
 		}
-		else if (gv_u8_delay > 10 && gv_u8_delay <=11)			// Stop the car for 0.5 s
+		
+		if (gv_u8_fault_reaction == FAULT_REACTION_SAFE_STOP)
 		{
-			APP_stop();
+			// Stopped by a driver fault until the next reset, showing the fault code
 		}
-		else if (gv_u8_delay > 11 && gv_u8_delay <= 15)				// short size for 2 s with speed 30%
+		else if ((enu_btn_state == BTN_PUSHED) && (gs_u8_start_pushed_ms >= gs_str_params.u8_button_debounce_ms))
 		{
-			APP_shortSide();
+			gs_u8_start_pushed_ms = U8_ZERO_VALUE;
+			
+			// Restart clears the overcurrent faults
+			FAULT_CHECK(FAULT_MODULE_MOTOR,MOTOR_clear_fault(&gc_str_motor_config[APP_MOTOR_1]));
+			FAULT_CHECK(FAULT_MODULE_MOTOR,MOTOR_clear_fault(&gc_str_motor_config[APP_MOTOR_2]));
+			gs_u8_motor_fault = FALSE;
+			
+			// The route starts from the origin of the odometry
+			ODOMETRY_reset();
+			FAULT_CHECK(FAULT_MODULE_MISSION,MISSION_start(&gs_str_route));
+			LOG_event(LOG_EVENT_START,U8_ZERO_VALUE,U8_ZERO_VALUE);
+			gv_enu_app_state = BTN_START;
 		}
-		else if (gv_u8_delay>15 && gv_u8_delay <=16)				// stop for 0.5 s
+		else if ((enu_btn_state == BTN_RELEASED) && (gs_u8_motor_fault == FALSE))
 		{
-			APP_stop();
+			if (COMMAND_get_activity() == TRUE)
+			{
+				// The USART can't wake the car up: stay awake while the host talks to it
+				gs_u16_park_ms = U8_ZERO_VALUE;
+			}
+			else
+			{
+				// Compares the time left: the counter stops below the sleep time and never wraps
+				if ((gs_str_params.u16_park_sleep_ms - gs_u16_park_ms) <= APP_BUTTON_TASK_MS)
+				{
+					APP_powerDown();
+				}
+				else
+				{
+					gs_u16_park_ms += APP_BUTTON_TASK_MS;
+				}
+			}
 		}
-		else if (gv_u8_delay >16 && gv_u8_delay <=17)			// rotate 90 degree to right
+		else
 		{
-			App_rotate();
+			// Debouncing, or showing the fault code
 		}
-		else if (gv_u8_delay > 17 && gv_u8_delay <=18)			// Stop the car for 0.5 s
+	}
+}
+
+/**
+ * @brief LED task, runs every 10 ms (the time unit of the LED patterns).
+ */
+void APP_ledTask(void)
+{
+	LED_pattern_tick();
+}
+
+/**
+ * @brief Telemetry task, runs every 50 ms.
+ *
+ * This function sends the status of the car in one frame. A frame the link has no room for is dropped,
+ * the host sees the gap in the sequence numbers.
+ */
+void APP_telemetryTask(void)
+{
+	app_str_telemetry_t str_status;
+	
+	str_status.u16_time_ms = SCHED_get_time();
+	str_status.u8_state = (uint8_t)gv_enu_app_state;
+	str_status.u8_segment = MISSION_get_segment();
+	FAULT_CHECK(FAULT_MODULE_MOTOR,MOTOR_get_velocity(&gc_str_motor_config[APP_MOTOR_1],&str_status.s8_velocity_left));
+	FAULT_CHECK(FAULT_MODULE_MOTOR,MOTOR_get_velocity(&gc_str_motor_config[APP_MOTOR_2],&str_status.s8_velocity_right));
+	str_status.u16_heading = ODOMETRY_get_heading();
+	str_status.u32_distance_mm = ODOMETRY_get_distance_mm();
+	str_status.u16_speed_ctrl_cycles = CAR_get_speed_control_cycles();
+	str_status.u8_idle_percent = SCHED_get_idle_percent();
+	str_status.u8_fault_mask = MOTOR_get_fault_mask();
+	
+	TELEMETRY_send(TELEMETRY_FRAME_STATUS,&str_status,sizeof(str_status));
+}
+
+/**
+ * @brief Stack guard task, runs every 10 ms.
+ *
+ * This function scans the next bytes of the painted SRAM for the high-water mark of the stack. Once less
+ * than the guard is left unused, the stack fault stops the car before the stack reaches the variables.
+ */
+void APP_stackTask(void)
+{
+	FAULT_CHECK(FAULT_MODULE_STACK,STACK_check(APP_STACK_GUARD_BYTES));
+}
+
+/**
+ * @brief Enters the start state.
+ *
+ * This function enables external interrupt 0, the stop button can brake the car from now on.
+ */
+void APP_enterStart(void)
+{
+	FAULT_CHECK(FAULT_MODULE_EXTI,extim_enable(&gs_str_extim_config_0));			// Enable External interrupt 0
+}
+
+/**
+ * @brief Enters the stop state.
+ *
+ * This function disables external interrupt 0, holds the car with the brake and blinks the stop LED to show the car is armed
+ * (or blinks the driver fault code, the motor fault code after an overcurrent, or shows the car runs degraded).
+ */
+void APP_enterStop(void)
+{
+	const led_str_pattern_t *ptr_str_pattern;
+	
+	FAULT_CHECK(FAULT_MODULE_EXTI,extim_disable(&gs_str_extim_config_0));		// Disable External interrupt 0
+	
+	
+	// Turn other LEDs off and slow blink the stop LED while waiting for the start button
+	FAULT_CHECK(FAULT_MODULE_LED,LED_off((gc_st_leds_config+LED_SHORT_SIDE)));
+	FAULT_CHECK(FAULT_MODULE_LED,LED_off((gc_st_leds_config+LED_LONG_SIDE)));
+	FAULT_CHECK(FAULT_MODULE_LED,LED_off((gc_st_leds_config+LED_ROTATE)));
+	if (gv_u8_fault_reaction == FAULT_REACTION_SAFE_STOP)
+	{
+		ptr_str_pattern = &gc_st_led_pattern_driver_fault;
+	}
+	else if (gs_u8_motor_fault == TRUE)
+	{
+		ptr_str_pattern = &gc_st_led_pattern_motor_fault;
+	}
+	else if (gv_u8_fault_reaction == FAULT_REACTION_DEGRADE)
+	{
+		ptr_str_pattern = &gc_st_led_pattern_degraded;
+	}
+	else
+	{
+		ptr_str_pattern = &gc_st_led_pattern_armed;
+	}
+	FAULT_CHECK(FAULT_MODULE_LED,LED_pattern_start(LED_STOP,ptr_str_pattern,U8_ZERO_VALUE));
+	
+	// Hold the motors braked while parked
+	FAULT_CHECK(FAULT_MODULE_CAR,CAR_BRAKE(&gc_str_motor_config[APP_MOTOR_1],&gc_str_motor_config[APP_MOTOR_2]));
+	gs_u16_park_ms = U8_ZERO_VALUE;
+}
+
+/**
+ * @brief Handles the start state routine.
+ *
+ * This function parks the car on a motor fault, otherwise it runs the route segment by segment.
+ */
+void APP_startState(void)
+{
+	if (APP_motorFault() == TRUE)
+	{
+		APP_faultStop();
+	}
+	else
+	{
+		MISSION_run();
+	}
+}
+
+/**
+ * @brief Parks the car on a motor fault.
+ *
+ * A motor was cut by the overcurrent guard: the route is stopped and the stop state shows the fault code.
+ */
+void APP_faultStop(void)
+{
+	LOG_event(LOG_EVENT_MOTOR_FAULT,MOTOR_get_fault_mask(),U8_ZERO_VALUE);
+	MISSION_stop();
+	gs_u8_motor_fault = TRUE;
+	gv_enu_app_state = BTN_STOP;
+}
+
+/**
+ * @brief Enters the teleoperation state.
+ *
+ * This function enables external interrupt 0, the stop button brakes the car as during the route,
+ * and flashes the stop LED twice a second while the host drives the car.
+ */
+void APP_enterTeleop(void)
+{
+	FAULT_CHECK(FAULT_MODULE_EXTI,extim_enable(&gs_str_extim_config_0));
+	
+	FAULT_CHECK(FAULT_MODULE_LED,LED_off((gc_st_leds_config+LED_SHORT_SIDE)));
+	FAULT_CHECK(FAULT_MODULE_LED,LED_off((gc_st_leds_config+LED_LONG_SIDE)));
+	FAULT_CHECK(FAULT_MODULE_LED,LED_off((gc_st_leds_config+LED_ROTATE)));
+	FAULT_CHECK(FAULT_MODULE_LED,LED_pattern_start(LED_STOP,&gc_st_led_pattern_teleop,U8_ZERO_VALUE));
+}
+
+/**
+ * @brief Handles the teleoperation state routine.
+ *
+ * This function parks the car on a motor fault, otherwise it gives the car the new host setpoint.
+ * It runs on the tick the setpoint was received, the command task runs first.
+ */
+void APP_teleopState(void)
+{
+	if (APP_motorFault() == TRUE)
+	{
+		APP_faultStop();
+	}
+	else if (gs_u8_teleop_new == TRUE)
+	{
+		gs_u8_teleop_new = FALSE;
+		FAULT_CHECK(FAULT_MODULE_CAR,CAR_set_twist(gs_s8_teleop_linear,gs_s8_teleop_angular));
+	}
+	else
+	{
+		// Keep the last setpoint until the next one or the timeout
+	}
+}
+
+/**
+ * @brief Brakes the car when the host setpoints stop.
+ *
+ * This function runs every control tick. Once no setpoint came for the teleoperation timeout the stream is over:
+ * a car in teleoperation brakes at once and parks.
+ */
+void APP_teleopWatch(void)
+{
+	if ((gs_u8_teleop_streaming == TRUE)
+		&& ((uint16_t)(SCHED_get_time() - gs_u16_teleop_last_ms) > gs_str_params.u16_teleop_timeout_ms))
+	{
+		gs_u8_teleop_streaming = FALSE;
+		if (gv_enu_app_state == BTN_TELEOP)
 		{
-			APP_stop();
+			// Lost link or host: stop on the spot
+			FAULT_CHECK(FAULT_MODULE_CAR,CAR_apply(CAR_PRIMITIVE_BRAKE));
+			LOG_event(LOG_EVENT_TELEOP_TIMEOUT,U8_ZERO_VALUE,gs_str_params.u16_teleop_timeout_ms);
+			gv_enu_app_state = BTN_STOP;
 		}
-		else{
-			gv_u8_delay = 2;
-		}
-		
 	}
 }
 
 /**
- * @brief Handles the stop state routine.
+ * @brief Teleoperation setpoint handler.
  *
- * This function disables external interrupt 0, stops timer 1, stops the car, and reads the start button state to determine the program state.
+ * This function is called by the command task for every setpoint of the host. The first setpoint of a stream
+ * takes a parked car without a motor fault over, a running route is never taken over. A stream that goes on
+ * after the stop button or a fault keeps the car parked: the host must stop it for the timeout to drive again.
+ *
+ * @param copy_s8_linear Forward velocity in percent (-100 .. 100).
+ * @param copy_s8_angular Turning velocity in percent (-100 .. 100, positive = left).
  */
-void APP_stopState(void)
+void APP_teleopHandler(sint8_t copy_s8_linear, sint8_t copy_s8_angular)
 {
-	btn_enu_state_t enu_btn_state = BTN_RELEASED;
+	uint8_t u8_sreg;
 	
-	extim_disable(&gs_str_extim_config_0);						// Disable External interrupt 0
-	
-	TIMER_MANGER_stop(TIMER_1);				// stop timer 1
+	// The emergency stop interrupt may park the car between the check and the change of state
+	ISR_ENTER_CRITICAL(u8_sreg);
+	if ((gv_enu_app_state == BTN_TELEOP)
+		|| ((gv_enu_app_state == BTN_STOP) && (gs_u8_teleop_streaming == FALSE) && (gs_u8_motor_fault == FALSE)
+			&& (gv_u8_fault_reaction != FAULT_REACTION_SAFE_STOP)))
+	{
+		gs_s8_teleop_linear = (copy_s8_linear > 100) ? 100 : ((copy_s8_linear < -100) ? -100 : copy_s8_linear);
+		gs_s8_teleop_angular = (copy_s8_angular > 100) ? 100 : ((copy_s8_angular < -100) ? -100 : copy_s8_angular);
+		gs_u8_teleop_new = TRUE;
+		gv_enu_app_state = BTN_TELEOP;
+	}
+	ISR_EXIT_CRITICAL(u8_sreg);
 	
+	gs_u16_teleop_last_ms = SCHED_get_time();
+	gs_u8_teleop_streaming = TRUE;
+}
+
+/**
+ * @brief Checks the overcurrent fault latch of both motors.
+ *
+ * @return TRUE if a motor was cut by the overcurrent guard, FALSE otherwise.
+ */
+uint8_t APP_motorFault(void)
+{
+	uint8_t u8_fault_1 = FALSE;
+	uint8_t u8_fault_2 = FALSE;
 	
-	APP_stop();							
+	FAULT_CHECK(FAULT_MODULE_MOTOR,MOTOR_get_fault(&gc_str_motor_config[APP_MOTOR_1],&u8_fault_1));
+	FAULT_CHECK(FAULT_MODULE_MOTOR,MOTOR_get_fault(&gc_str_motor_config[APP_MOTOR_2],&u8_fault_2));
 	
+	return ((u8_fault_1 == TRUE) || (u8_fault_2 == TRUE)) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Driver fault reaction handler.
+ *
+ * This function is called by the fault manager from the context of the failed call, interrupts included.
+ * A safe stop brakes the car at once like the stop button and keeps it parked until the next reset.
+ * The control task enters the program state again to show the fault on the stop LED.
+ *
+ * @param copy_enu_module The module of the fault.
+ * @param copy_enu_reaction The reaction, degrade or safe stop.
+ */
+void APP_faultReaction(fault_enu_module_t copy_enu_module, fault_enu_reaction_t copy_enu_reaction)
+{
+	// The reaction alone decides, the fault manager already counted and logged the module
+	(void)copy_enu_module;
 	
-	// Read Start Button state
-	BTN_get_state(&gc_str_btn_config[APP_BTN_START_INDEX],&enu_btn_state);
+	if (copy_enu_reaction == FAULT_REACTION_SAFE_STOP)
+	{
+		// Not checked: a failing brake would report itself again
+		CAR_apply(CAR_PRIMITIVE_BRAKE);
+		MISSION_stop();
+		gv_enu_app_state = BTN_STOP;
+	}
 	
-	if (enu_btn_state == BTN_PUSHED)
+	// Only ever raised: a degrade never takes a safe stop back
+	if ((uint8_t)copy_enu_reaction > gv_u8_fault_reaction)
 	{
-		gs_enu_app_state = BTN_START;
+		gv_u8_fault_reaction = (uint8_t)copy_enu_reaction;
 	}
-	gv_u8_delay = 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,150 @@
+/**
+ * @file FAULT_interface.h
+ * @brief Fault Manager Interface Header File
+ *
+ * This header file defines the interface of the fault manager. The application checks the return state of the
+ * driver calls with #FAULT_CHECK: every driver returns 0 (its OK state) on success, anything else is reported
+ * as a fault of the module it was called on.
+ *
+ * The fault manager counts the faults of every module, keeps a snapshot of the first fault since the boot and logs
+ * the first fault of every module. Each module has its reaction, given by the application: ignore the fault,
+ * run degraded, or stop the car safely. The reaction handler of the application carries the reaction out.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef FAULT_INTERFACE_H_
+#define FAULT_INTERFACE_H_
+
+#include "../../STD_LIB/bit_math.h"
+#include "../../STD_LIB/std_types.h"
+
+
+/**
+ * @brief Check the return state of a driver call and report it if it is not OK.
+ *
+ * Without a fault its cost is one compare and branch on the return state, the report is out of line.
+ * Can be used in any context, interrupts included. The file using it defines FAULT_UNIT to its fault_enu_unit_t,
+ * the line alone can't tell the files apart.
+ *
+ * @param module The module called, see fault_enu_module_t.
+ * @param call The driver call, returning 0 on success.
+ */
+#define FAULT_CHECK(module, call)	do { \
+										uint8_t u8_fault_status = (uint8_t)(call); \
+										if (u8_fault_status != U8_ZERO_VALUE) \
+										{ \
+											FAULT_report((module), u8_fault_status, FAULT_UNIT, __LINE__); \
+										} \
+									} while (0)
+
+/**
+ * @brief Enumeration of the modules whose faults are managed.
+ */
+typedef enum {
+    FAULT_MODULE_LED = 0,		/**< LEDs and their patterns. */
+    FAULT_MODULE_BUTTON,		/**< Buttons. */
+    FAULT_MODULE_TIMER,			/**< Timers (motors duty cycle, LED modulation and system tick). */
+    FAULT_MODULE_EXTI,			/**< External interrupts (stop button and wake up). */
+    FAULT_MODULE_CAR,			/**< Car control and wheel speed control. */
+    FAULT_MODULE_MOTOR,			/**< Motors and their overcurrent guard. */
+    FAULT_MODULE_MISSION,		/**< Route. */
+    FAULT_MODULE_SCHED,			/**< Scheduler. */
+    FAULT_MODULE_SUPERVISOR,	/**< Watchdog supervisor. */
+    FAULT_MODULE_POWER,			/**< Power management. */
+    FAULT_MODULE_COMMS,			/**< Telemetry link and host commands. */
+    FAULT_MODULE_STACK,			/**< Stack guard: less stack left unused than the guard. */
+    FAULT_MODULE_MAX			/**< Number of modules. */
+} fault_enu_module_t;
+
+/**
+ * @brief Enumeration of the source files checking driver calls with #FAULT_CHECK.
+ */
+typedef enum {
+    FAULT_UNIT_APP = 0,			/**< APP_prog.c */
+    FAULT_UNIT_MISSION			/**< MISSION_prog.c */
+} fault_enu_unit_t;
+
+/**
+ * @brief Enumeration of the reactions to a fault.
+ */
+typedef enum {
+    FAULT_REACTION_IGNORE = 0,	/**< Count and log the fault only. */
+    FAULT_REACTION_DEGRADE,		/**< Go on without the feature of the module. */
+    FAULT_REACTION_SAFE_STOP	/**< Brake and park the car until the next reset. */
+} fault_enu_reaction_t;
+
+/**
+ * @brief Snapshot of a fault.
+ */
+typedef struct {
+    uint16_t u16_time_ms;	/**< Scheduler clock of the fault in ms. */
+    uint16_t u16_line;		/**< Line of the failed call in the source file. */
+    uint8_t  u8_unit;		/**< Source file of the failed call, see fault_enu_unit_t. */
+    uint8_t  u8_module;		/**< Module of the fault, see fault_enu_module_t. */
+    uint8_t  u8_status;		/**< Return state of the failed call. */
+} fault_str_snapshot_t;
+
+/**
+ * @brief Enumeration defining return states for fault manager functions.
+ */
+typedef enum {
+    FAULT_OK,	/**< Operation was successful. */
+    FAULT_NOK	/**< NULL pointer, no such module, or no fault yet. */
+} fault_enu_return_state_t;
+
+
+/**
+ * @brief Initialize the fault manager with the reactions of the modules.
+ *
+ * Must be called at boot, before the first #FAULT_CHECK: the faults reported before are counted and ignored.
+ *
+ * @param ptr_enu_reactions Pointer to the reactions table, #FAULT_MODULE_MAX entries in fault_enu_module_t order.
+ * @param ptr_func_reaction Function carrying a degrade or safe stop reaction out, called on every such fault
+ *                          from the context of the failed call.
+ * @return The return state of the initialization.
+ *     - #FAULT_OK: Initialization successful.
+ *     - #FAULT_NOK: NULL pointer.
+ */
+fault_enu_return_state_t FAULT_init(const fault_enu_reaction_t *ptr_enu_reactions,
+									void (*ptr_func_reaction)(fault_enu_module_t copy_enu_module, fault_enu_reaction_t copy_enu_reaction));
+
+/**
+ * @brief Report a fault, usually through #FAULT_CHECK.
+ *
+ * Can be called from any context, interrupts included.
+ *
+ * @param copy_enu_module The module of the fault.
+ * @param copy_u8_status Return state of the failed call.
+ * @param copy_enu_unit Source file of the failed call.
+ * @param copy_u16_line Line of the failed call in the source file.
+ */
+void FAULT_report(fault_enu_module_t copy_enu_module, uint8_t copy_u8_status, fault_enu_unit_t copy_enu_unit, uint16_t copy_u16_line);
+
+/**
+ * @brief Read the number of faults of a module.
+ *
+ * @param copy_enu_module The module.
+ * @return The number of faults since the boot (saturates at 255), 0 for no such module.
+ */
+uint8_t FAULT_get_count(fault_enu_module_t copy_enu_module);
+
+/**
+ * @brief Read the modules that had a fault.
+ *
+ * @return One bit per module, in fault_enu_module_t order.
+ */
+uint16_t FAULT_get_mask(void);
+
+/**
+ * @brief Read the snapshot of the first fault since the boot.
+ *
+ * @param ptr_str_snapshot Pointer to store the snapshot.
+ * @return The return state of reading the snapshot.
+ *     - #FAULT_OK: Snapshot read successfully.
+ *     - #FAULT_NOK: NULL pointer, or no fault yet.
+ */
+fault_enu_return_state_t FAULT_get_first(fault_str_snapshot_t *ptr_str_snapshot);
+
+#endif /* FAULT_INTERFACE_H_ */
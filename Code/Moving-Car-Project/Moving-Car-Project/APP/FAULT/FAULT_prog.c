@@ -0,0 +1,133 @@
+/**
+ * @file FAULT_prog.c
+ * @brief Fault Manager Implementation File
+ *
+ * This file implements the fault manager: it counts the faults of the modules, keeps the first one
+ * and hands the degrade and safe stop reactions to the application.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "FAULT_interface.h"
+#include "../SCHEDULER/SCHEDULER_interface.h"
+#include "../../HAL/LOG/LOG_interface.h"
+#include "../../MCAL/AVR_ARCH/ISR_interface.h"
+
+
+/** @brief Reactions of the modules, NULL until the fault manager is initialized */
+static const fault_enu_reaction_t *gs_ptr_enu_reactions = NULL;
+
+/** @brief Function carrying the degrade and safe stop reactions out */
+static void (*gs_ptr_func_reaction)(fault_enu_module_t copy_enu_module, fault_enu_reaction_t copy_enu_reaction) = NULL;
+
+/** @brief Faults of every module, shared with the interrupts */
+static volatile uint8_t gv_au8_fault_count[FAULT_MODULE_MAX];
+
+/** @brief Snapshot of the first fault, valid once gv_u8_fault_first_valid is set */
+static volatile fault_str_snapshot_t gv_str_fault_first;
+
+/** @brief Set by the first fault since the boot */
+static volatile uint8_t gv_u8_fault_first_valid = FALSE;
+
+
+fault_enu_return_state_t FAULT_init(const fault_enu_reaction_t *ptr_enu_reactions,
+									void (*ptr_func_reaction)(fault_enu_module_t copy_enu_module, fault_enu_reaction_t copy_enu_reaction))
+{
+	fault_enu_return_state_t enu_return_state = FAULT_OK;
+
+	if ((ptr_enu_reactions == NULL) || (ptr_func_reaction == NULL))
+	{
+		enu_return_state = FAULT_NOK;
+	}
+	else
+	{
+		gs_ptr_func_reaction = ptr_func_reaction;
+		gs_ptr_enu_reactions = ptr_enu_reactions;
+	}
+	return enu_return_state;
+}
+
+void FAULT_report(fault_enu_module_t copy_enu_module, uint8_t copy_u8_status, fault_enu_unit_t copy_enu_unit, uint16_t copy_u16_line)
+{
+	fault_enu_reaction_t enu_reaction = FAULT_REACTION_IGNORE;
+	uint8_t u8_first = FALSE;
+	uint8_t u8_sreg;
+
+	if (copy_enu_module < FAULT_MODULE_MAX)
+	{
+		// A fault in an interrupt may come between the read and the write of the count
+		ISR_ENTER_CRITICAL(u8_sreg);
+		if (gv_au8_fault_count[copy_enu_module] == U8_ZERO_VALUE)
+		{
+			u8_first = TRUE;
+		}
+		if (gv_au8_fault_count[copy_enu_module] < 0xFF)
+		{
+			gv_au8_fault_count[copy_enu_module]++;
+		}
+		if (gv_u8_fault_first_valid == FALSE)
+		{
+			gv_str_fault_first.u16_time_ms = SCHED_get_time();
+			gv_str_fault_first.u16_line = copy_u16_line;
+			gv_str_fault_first.u8_unit = (uint8_t)copy_enu_unit;
+			gv_str_fault_first.u8_module = (uint8_t)copy_enu_module;
+			gv_str_fault_first.u8_status = copy_u8_status;
+			gv_u8_fault_first_valid = TRUE;
+		}
+		ISR_EXIT_CRITICAL(u8_sreg);
+
+		if (u8_first == TRUE)
+		{
+			LOG_event(LOG_EVENT_FAULT, (uint8_t)copy_enu_module, copy_u16_line);
+		}
+
+		if (gs_ptr_enu_reactions != NULL)
+		{
+			enu_reaction = gs_ptr_enu_reactions[copy_enu_module];
+		}
+		if (enu_reaction != FAULT_REACTION_IGNORE)
+		{
+			gs_ptr_func_reaction(copy_enu_module, enu_reaction);
+		}
+	}
+}
+
+uint8_t FAULT_get_count(fault_enu_module_t copy_enu_module)
+{
+	return (copy_enu_module < FAULT_MODULE_MAX) ? gv_au8_fault_count[copy_enu_module] : U8_ZERO_VALUE;
+}
+
+uint16_t FAULT_get_mask(void)
+{
+	uint16_t u16_mask = U8_ZERO_VALUE;
+
+	for (uint8_t u8_index = U8_ZERO_VALUE ; u8_index < FAULT_MODULE_MAX ; u8_index++)
+	{
+		if (gv_au8_fault_count[u8_index] != U8_ZERO_VALUE)
+		{
+			SET_BIT(u16_mask, u8_index);
+		}
+	}
+	return u16_mask;
+}
+
+fault_enu_return_state_t FAULT_get_first(fault_str_snapshot_t *ptr_str_snapshot)
+{
+	fault_enu_return_state_t enu_return_state = FAULT_OK;
+
+	if ((ptr_str_snapshot == NULL) || (gv_u8_fault_first_valid == FALSE))
+	{
+		enu_return_state = FAULT_NOK;
+	}
+	else
+	{
+		// Never written again once valid
+		ptr_str_snapshot->u16_time_ms = gv_str_fault_first.u16_time_ms;
+		ptr_str_snapshot->u16_line = gv_str_fault_first.u16_line;
+		ptr_str_snapshot->u8_unit = gv_str_fault_first.u8_unit;
+		ptr_str_snapshot->u8_module = gv_str_fault_first.u8_module;
+		ptr_str_snapshot->u8_status = gv_str_fault_first.u8_status;
+	}
+	return enu_return_state;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file MISSION_interface.h
+ * @brief Mission Engine Interface Header File
+ *
+ * This header file defines the interface of the mission engine. A route is a const table of segments,
+ * every segment gives an action of the car, its duration, its speed and the LED shown while it runs.
+ * A protothread walks a cursor through the table: the system tick advances the mission clock in O(1)
+ * and every call from the main loop resumes the thread where it waits for the goal or the end of the segment.
+ *
+ * Changing the route only changes its table, the application logic stays the same.
+ * A segment with a goal that ends on its duration is logged as #LOG_EVENT_SEGMENT_TIMEOUT.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef MISSION_INTERFACE_H_
+#define MISSION_INTERFACE_H_
+
+#include "../../HAL/CAR_CONTROL/CAR_CONTROL_interface.h"
+#include "../../HAL/LED/LED_inteface.h"
+#include "../../HAL/LOG/LOG_interface.h"
+#include "../../STD_LIB/bit_math.h"
+#include "../../STD_LIB/std_types.h"
+
+
+/** @brief LED value of a segment that shows no LED */
+#define MISSION_NO_LED				0xFF
+
+
+/**
+ * @brief Enumeration of the actions a segment can give the car.
+ */
+typedef enum {
+    MISSION_ACTION_STOP = 0,	/**< Ramp the motors down and stand still for the segment duration. */
+    MISSION_ACTION_DRIVE,		/**< Drive straight at the segment speed until s16_goal mm are driven (0 = for the duration). */
+    MISSION_ACTION_ROTATE,		/**< Turn in place by s16_goal degrees (positive = left) until the turn is done. */
+    MISSION_ACTION_TWIST,		/**< Drive at the segment speed turning at s16_goal percent (positive = left) for the duration. */
+    MISSION_ACTION_MAX			/**< Number of actions. */
+} mission_enu_action_t;
+
+/**
+ * @brief One segment of a route.
+ *
+ * The duration ends every segment. Segments with a goal (distance or angle) end as soon as the goal is reached,
+ * their duration is then the timeout that keeps a stalled car from waiting forever.
+ */
+typedef struct {
+    mission_enu_action_t enu_action;	/**< Action of the car. */
+    uint16_t u16_duration_ms;			/**< Duration (or timeout) of the segment in ms, 0 ends it at once. */
+    sint8_t  s8_speed;					/**< Velocity of the car in percent (-100 .. 100), unused by stop and rotate. */
+    sint16_t s16_goal;					/**< Distance in mm, angle in degrees or turn rate in percent, see the action. */
+    uint8_t  u8_led;					/**< Index of the LED shown during the segment (others are off), #MISSION_NO_LED for none. */
+} mission_str_segment_t;
+
+/**
+ * @brief A route: a table of segments and the segment it loops back to.
+ */
+typedef struct {
+    const mission_str_segment_t *ptr_str_segments;	/**< Segments of the route, in order. */
+    uint8_t u8_segments_num;						/**< Number of segments in the table. */
+    uint8_t u8_loop_index;							/**< Segment that follows the last one, u8_segments_num to end the route. */
+} mission_str_route_t;
+
+/**
+ * @brief Enumeration defining return states for mission functions.
+ */
+typedef enum {
+    MISSION_OK,		/**< Operation was successful. */
+    MISSION_NOK		/**< Operation failed. */
+} mission_enu_return_state_t;
+
+
+/**
+ * @brief Initialize the mission engine with the LEDs its segments refer to.
+ *
+ * @param ptr_str_leds_config Pointer to the LED configuration array, indexed by the segments u8_led.
+ * @param copy_u8_leds_num Number of LEDs in the array.
+ * @return The return state of the initialization.
+ *     - #MISSION_OK: Initialization successful.
+ *     - #MISSION_NOK: NULL pointer.
+ */
+mission_enu_return_state_t MISSION_init(const led_str_config_t *ptr_str_leds_config, uint8_t copy_u8_leds_num);
+
+/**
+ * @brief Start a route from its first segment.
+ *
+ * @param ptr_str_route Pointer to the route.
+ * @return The return state of starting the route.
+ *     - #MISSION_OK: Route started.
+ *     - #MISSION_NOK: NULL pointer, empty route or loop index out of the table.
+ */
+mission_enu_return_state_t MISSION_start(const mission_str_route_t *ptr_str_route);
+
+/**
+ * @brief Stop the running route. The car is left as it is, the caller parks it.
+ */
+void MISSION_stop(void);
+
+/**
+ * @brief Advance the mission clock by 1 ms.
+ *
+ * Must be called every 1 ms (usually from the system tick interrupt). Its cost is constant.
+ */
+void MISSION_tick(void);
+
+/**
+ * @brief Run the current segment of the route.
+ *
+ * Must be called from the main loop. It starts the segment the cursor points at, ends it when its goal is
+ * reached or its duration is over and moves the cursor to the next one, the next segment starts on the next call.
+ * A call costs the same whatever the route, even a loop of 0 ms segments.
+ *
+ * @return TRUE while the route is running, FALSE once it has ended or was stopped.
+ */
+uint8_t MISSION_run(void);
+
+/**
+ * @brief Read the index of the current segment.
+ *
+ * @return Index of the segment in the route table, valid while the route runs.
+ */
+uint8_t MISSION_get_segment(void);
+
+#endif /* MISSION_INTERFACE_H_ */
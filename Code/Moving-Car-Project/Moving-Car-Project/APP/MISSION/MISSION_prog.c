@@ -0,0 +1,258 @@
+/**
+ * @file MISSION_prog.c
+ * @brief Mission Engine Implementation File
+ *
+ * This file implements the mission engine: a protothread walks the cursor through the segments of a route table,
+ * it starts every segment and waits for its goal or its duration on the mission clock advanced by the system tick.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "MISSION_interface.h"
+#include "../FAULT/FAULT_interface.h"
+#include "../../MCAL/AVR_ARCH/ISR_interface.h"
+#include "../../STD_LIB/protothread.h"
+
+/** @brief Source file of the faults checked here */
+#define FAULT_UNIT	FAULT_UNIT_MISSION
+
+/***************************************************************************/
+/*******				Static function prototypes					*******/
+/***************************************************************************/
+
+static uint16_t MISSION_now(void);
+static void MISSION_enter(const mission_str_segment_t *ptr_str_segment);
+static uint8_t MISSION_has_goal(const mission_str_segment_t *ptr_str_segment);
+static uint8_t MISSION_goal_reached(const mission_str_segment_t *ptr_str_segment);
+static void MISSION_show_led(uint8_t u8_led);
+static uint8_t MISSION_thread(pt_str_t *ptr_str_pt);
+
+
+/** @brief LEDs the segments refer to */
+static const led_str_config_t *gs_ptr_str_leds = NULL;
+
+/** @brief Number of LEDs the segments refer to */
+static uint8_t gs_u8_leds_num = U8_ZERO_VALUE;
+
+/** @brief Running route */
+static const mission_str_route_t *gs_ptr_str_route = NULL;
+
+/** @brief Index of the current segment */
+static uint8_t gs_u8_cursor = U8_ZERO_VALUE;
+
+/** @brief State of the protothread running the route */
+static pt_str_t gs_str_mission_pt;
+
+/** @brief Odometry path length in mm when the current segment started */
+static uint32_t gs_u32_start_mm = U8_ZERO_VALUE;
+
+/** @brief TRUE while a route is running, cleared by the emergency stop interrupt */
+static volatile uint8_t gv_u8_running = FALSE;
+
+/** @brief Mission clock in ms, advanced by the system tick */
+static volatile uint16_t gv_u16_mission_ms = U8_ZERO_VALUE;
+
+/** @brief Current segment of the running route */
+#define MISSION_SEGMENT()		(gs_ptr_str_route->ptr_str_segments + gs_u8_cursor)
+
+
+/**
+ * @brief Read the mission clock.
+ *
+ * @return Time in ms, wraps around every 65.5 s.
+ */
+static uint16_t MISSION_now(void)
+{
+	uint16_t u16_now;
+	uint8_t u8_sreg;
+
+	ISR_ENTER_CRITICAL(u8_sreg);
+	u16_now = gv_u16_mission_ms;
+	ISR_EXIT_CRITICAL(u8_sreg);
+	return u16_now;
+}
+
+/**
+ * @brief Start a segment: show its LED and give the car its action.
+ *
+ * @param ptr_str_segment Pointer to the segment.
+ */
+static void MISSION_enter(const mission_str_segment_t *ptr_str_segment)
+{
+	MISSION_show_led(ptr_str_segment->u8_led);
+	gs_u32_start_mm = ODOMETRY_get_distance_mm();
+
+	switch (ptr_str_segment->enu_action)
+	{
+		case MISSION_ACTION_DRIVE:
+			FAULT_CHECK(FAULT_MODULE_CAR, CAR_set_twist(ptr_str_segment->s8_speed, 0));
+			break;
+		case MISSION_ACTION_ROTATE:
+			FAULT_CHECK(FAULT_MODULE_CAR, CAR_rotate_deg(ptr_str_segment->s16_goal));
+			break;
+		case MISSION_ACTION_TWIST:
+			FAULT_CHECK(FAULT_MODULE_CAR, CAR_set_twist(ptr_str_segment->s8_speed, (sint8_t)ptr_str_segment->s16_goal));
+			break;
+		default:
+			// Stop: ramp the motors down, the car rolls to a smooth stop
+			FAULT_CHECK(FAULT_MODULE_CAR, CAR_set_twist(0, 0));
+			break;
+	}
+}
+
+/**
+ * @brief Check a segment has a goal that can end it before its duration.
+ *
+ * @param ptr_str_segment Pointer to the segment.
+ * @return TRUE for a distance or an angle goal, FALSE for a time only segment.
+ */
+static uint8_t MISSION_has_goal(const mission_str_segment_t *ptr_str_segment)
+{
+	return (((ptr_str_segment->enu_action == MISSION_ACTION_DRIVE) && (ptr_str_segment->s16_goal > 0))
+			|| (ptr_str_segment->enu_action == MISSION_ACTION_ROTATE)) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Check the goal of a started segment.
+ *
+ * @param ptr_str_segment Pointer to the segment.
+ * @return TRUE if the segment reached its goal before its duration, FALSE otherwise.
+ */
+static uint8_t MISSION_goal_reached(const mission_str_segment_t *ptr_str_segment)
+{
+	uint8_t u8_reached = FALSE;
+
+	if ((ptr_str_segment->enu_action == MISSION_ACTION_DRIVE) && (ptr_str_segment->s16_goal > 0))
+	{
+		u8_reached = ((ODOMETRY_get_distance_mm() - gs_u32_start_mm) >= (uint32_t)ptr_str_segment->s16_goal) ? TRUE : FALSE;
+	}
+	else if (ptr_str_segment->enu_action == MISSION_ACTION_ROTATE)
+	{
+		u8_reached = (CAR_is_turning() == FALSE) ? TRUE : FALSE;
+	}
+	else
+	{
+		// Time only segment
+	}
+	return u8_reached;
+}
+
+/**
+ * @brief Turn the LED of a segment on and all other LEDs off.
+ *
+ * @param u8_led Index of the LED, #MISSION_NO_LED turns all LEDs off.
+ */
+static void MISSION_show_led(uint8_t u8_led)
+{
+	for (uint8_t u8_index = U8_ZERO_VALUE ; u8_index < gs_u8_leds_num ; u8_index++)
+	{
+		if (u8_index == u8_led)
+		{
+			FAULT_CHECK(FAULT_MODULE_LED, LED_on(gs_ptr_str_leds + u8_index));
+		}
+		else
+		{
+			FAULT_CHECK(FAULT_MODULE_LED, LED_off(gs_ptr_str_leds + u8_index));
+		}
+	}
+}
+
+/**
+ * @brief Protothread running the route, one segment after the other.
+ *
+ * @param ptr_str_pt Pointer to the state of the thread.
+ * @return #PT_WAITING while the route runs, #PT_ENDED once it has ended.
+ */
+static uint8_t MISSION_thread(pt_str_t *ptr_str_pt)
+{
+	PT_BEGIN(ptr_str_pt);
+
+	while (gs_u8_cursor < gs_ptr_str_route->u8_segments_num)
+	{
+		MISSION_enter(MISSION_SEGMENT());
+
+		// The goal ends the segment early, its duration ends it in any case
+		PT_TIMER_START(ptr_str_pt, MISSION_now());
+		PT_WAIT_EVENT(ptr_str_pt, (PT_ELAPSED(ptr_str_pt, MISSION_now()) >= MISSION_SEGMENT()->u16_duration_ms)
+								|| (MISSION_goal_reached(MISSION_SEGMENT()) == TRUE));
+
+		if ((MISSION_has_goal(MISSION_SEGMENT()) == TRUE) && (MISSION_goal_reached(MISSION_SEGMENT()) == FALSE))
+		{
+			// The car did not make it in time: stalled wheels, low battery
+			LOG_event(LOG_EVENT_SEGMENT_TIMEOUT, gs_u8_cursor, MISSION_SEGMENT()->u16_duration_ms);
+		}
+
+		// Past the last segment the route loops back, or ends when its loop index is out of the table
+		gs_u8_cursor++;
+		if (gs_u8_cursor >= gs_ptr_str_route->u8_segments_num)
+		{
+			gs_u8_cursor = gs_ptr_str_route->u8_loop_index;
+		}
+
+		// One segment per call: a loop of 0 ms segments would never return to the main loop
+		PT_YIELD(ptr_str_pt);
+	}
+
+	PT_END(ptr_str_pt);
+}
+
+mission_enu_return_state_t MISSION_init(const led_str_config_t *ptr_str_leds_config, uint8_t copy_u8_leds_num)
+{
+	mission_enu_return_state_t enu_return_state = MISSION_OK;
+
+	if (ptr_str_leds_config == NULL)
+	{
+		enu_return_state = MISSION_NOK;
+	}
+	else
+	{
+		gs_ptr_str_leds = ptr_str_leds_config;
+		gs_u8_leds_num = copy_u8_leds_num;
+	}
+	return enu_return_state;
+}
+
+mission_enu_return_state_t MISSION_start(const mission_str_route_t *ptr_str_route)
+{
+	mission_enu_return_state_t enu_return_state = MISSION_OK;
+
+	if ((ptr_str_route == NULL) || (ptr_str_route->ptr_str_segments == NULL) ||
+		(ptr_str_route->u8_segments_num == U8_ZERO_VALUE) || (ptr_str_route->u8_loop_index > ptr_str_route->u8_segments_num))
+	{
+		enu_return_state = MISSION_NOK;
+	}
+	else
+	{
+		gv_u8_running = FALSE;
+		gs_ptr_str_route = ptr_str_route;
+		gs_u8_cursor = U8_ZERO_VALUE;
+		PT_INIT(&gs_str_mission_pt);
+		gv_u8_running = TRUE;
+	}
+	return enu_return_state;
+}
+
+void MISSION_stop(void)
+{
+	gv_u8_running = FALSE;
+}
+
+void MISSION_tick(void)
+{
+	gv_u16_mission_ms++;
+}
+
+uint8_t MISSION_run(void)
+{
+	if ((gv_u8_running == TRUE) && (MISSION_thread(&gs_str_mission_pt) == PT_ENDED))
+	{
+		gv_u8_running = FALSE;
+	}
+	return gv_u8_running;
+}
+
+uint8_t MISSION_get_segment(void)
+{
+	return gs_u8_cursor;
+}
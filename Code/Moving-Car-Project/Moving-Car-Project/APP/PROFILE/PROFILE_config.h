@@ -0,0 +1,24 @@
+/**
+ * @file PROFILE_config.h
+ * @brief Execution Time Profiler Configuration Header File
+ *
+ * This header file defines configuration parameters for the execution time profiler.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef PROFILE_CONFIG_H_
+#define PROFILE_CONFIG_H_
+
+/**
+ * @brief Weight of a new run in the average as a shift: the average follows about the last 2^4 = 16 runs.
+ */
+#define PROFILE_AVG_SHIFT		4
+
+/**
+ * @brief CPU cycles per scheduler tick (1 ms), Timer 1 must run at F_CPU = 8M.
+ */
+#define PROFILE_CYCLES_PER_MS	8000UL
+
+#endif /* PROFILE_CONFIG_H_ */
@@ -0,0 +1,104 @@
+/**
+ * @file PROFILE_interface.h
+ * @brief Execution Time Profiler Interface Header File
+ *
+ * This header file defines the interface of the execution time profiler. A probe times a stage of the main loop
+ * in CPU cycles on Timer 1, which runs freely at F_CPU, and keeps the shortest, the longest and the average run.
+ * The scheduler times every task, the control task times its program states and route actions.
+ *
+ * A probe costs two Timer 1 reads and a few compares per run, it stays on in every build. The interrupts taken
+ * during a run count in its time. The CPU load is the rest of the idle time, see SCHED_get_idle_percent().
+ *
+ * Timer 1 wraps around every 65536 cycles (8.19 ms at 8 MHz), the longest run it can time. The scheduler clock
+ * taken along tells a run that wrapped around: it is recorded as #PROFILE_SATURATED_CYCLES.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef PROFILE_INTERFACE_H_
+#define PROFILE_INTERFACE_H_
+
+#include "../SCHEDULER/SCHEDULER_config.h"
+#include "../MISSION/MISSION_interface.h"
+#include "../../STD_LIB/bit_math.h"
+#include "../../STD_LIB/std_types.h"
+#include "PROFILE_config.h"
+
+
+/** @brief Cycles recorded for a run of 8.19 ms or more (Timer 1 wrapped around) */
+#define PROFILE_SATURATED_CYCLES	0xFFFF
+
+/**
+ * @brief Enumeration of the probes.
+ */
+typedef enum {
+    PROFILE_PROBE_TASK_FIRST = 0,								/**< Scheduler task 0, one probe per task index up to #SCHED_MAX_TASKS. */
+    PROFILE_PROBE_STOP_STATE = SCHED_MAX_TASKS,					/**< Control task in the stop state. */
+    PROFILE_PROBE_TELEOP_STATE,									/**< Control task in the teleoperation state. */
+    PROFILE_PROBE_ROUTE_FIRST,									/**< Control task running a route segment, one probe per action in mission_enu_action_t order. */
+    PROFILE_PROBE_MAX = PROFILE_PROBE_ROUTE_FIRST + MISSION_ACTION_MAX	/**< Number of probes. */
+} profile_enu_probe_t;
+
+/**
+ * @brief Execution time of a probe.
+ */
+typedef struct {
+    uint16_t u16_min_cycles;	/**< Shortest run in CPU cycles. */
+    uint16_t u16_max_cycles;	/**< Longest run in CPU cycles. */
+    uint16_t u16_avg_cycles;	/**< Average of the last runs in CPU cycles, see #PROFILE_AVG_SHIFT. */
+    uint16_t u16_runs;			/**< Number of runs (saturates at 65535), 0 if the probe never ran. */
+} profile_str_stats_t;
+
+/**
+ * @brief Start of a run of a probe.
+ */
+typedef struct {
+    uint16_t u16_cycles;	/**< Timer 1 count at the start. */
+    uint16_t u16_time_ms;	/**< Scheduler clock at the start, tells a run longer than Timer 1 can time. */
+} profile_str_start_t;
+
+/**
+ * @brief Enumeration defining return states for profiler functions.
+ */
+typedef enum {
+    PROFILE_OK,		/**< Operation was successful. */
+    PROFILE_NOK		/**< NULL pointer or no such probe. */
+} profile_enu_return_state_t;
+
+
+/**
+ * @brief Start a run of a probe.
+ *
+ * @param ptr_str_start Pointer to store the start of the run, to be given to PROFILE_stop().
+ */
+void PROFILE_start(profile_str_start_t *ptr_str_start);
+
+/**
+ * @brief End a run of a probe and add it to its statistics.
+ *
+ * Must be called from the main loop. A run of 8.19 ms or more (65536 cycles at 8 MHz) is recorded
+ * as #PROFILE_SATURATED_CYCLES.
+ *
+ * @param copy_enu_probe The probe.
+ * @param ptr_str_start Pointer to the start of the run, from PROFILE_start().
+ */
+void PROFILE_stop(profile_enu_probe_t copy_enu_probe, const profile_str_start_t *ptr_str_start);
+
+/**
+ * @brief Read the statistics of a probe.
+ *
+ * @param copy_enu_probe The probe.
+ * @param ptr_str_stats Pointer to store the statistics.
+ * @return The return state of reading the statistics.
+ *     - #PROFILE_OK: Statistics read successfully.
+ *     - #PROFILE_NOK: NULL pointer or no such probe.
+ */
+profile_enu_return_state_t PROFILE_get(profile_enu_probe_t copy_enu_probe, profile_str_stats_t *ptr_str_stats);
+
+/**
+ * @brief Clear the statistics of all probes, to measure a new situation.
+ */
+void PROFILE_reset(void);
+
+#endif /* PROFILE_INTERFACE_H_ */
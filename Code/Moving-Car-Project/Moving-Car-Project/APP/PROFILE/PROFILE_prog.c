@@ -0,0 +1,97 @@
+/**
+ * @file PROFILE_prog.c
+ * @brief Execution Time Profiler Implementation File
+ *
+ * This file implements the execution time profiler: every probe keeps its shortest and longest run
+ * and an exponential moving average of its runs in CPU cycles.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "PROFILE_interface.h"
+#include "../SCHEDULER/SCHEDULER_interface.h"
+#include "../../HAL/TIMER_manager/TIMER_manger_interface.h"
+
+
+/** @brief Statistics of the probes, written by the main loop only (a debugger reads them as they are) */
+static profile_str_stats_t gs_astr_profile[PROFILE_PROBE_MAX];
+
+
+void PROFILE_start(profile_str_start_t *ptr_str_start)
+{
+	if (ptr_str_start != NULL)
+	{
+		ptr_str_start->u16_cycles = TIMER_MANGER_getCycles();
+		ptr_str_start->u16_time_ms = SCHED_get_time();
+	}
+}
+
+void PROFILE_stop(profile_enu_probe_t copy_enu_probe, const profile_str_start_t *ptr_str_start)
+{
+	uint16_t u16_cycles;
+	uint16_t u16_time_ms;
+	profile_str_stats_t *ptr_str_stats;
+
+	if ((ptr_str_start != NULL) && (copy_enu_probe < PROFILE_PROBE_MAX))
+	{
+		u16_cycles = (uint16_t)(TIMER_MANGER_getCycles() - ptr_str_start->u16_cycles);
+		u16_time_ms = (uint16_t)(SCHED_get_time() - ptr_str_start->u16_time_ms);
+
+		// N ticks took more than N - 1 ms, one more ms covers the reads: fewer cycles means Timer 1 wrapped around
+		if ((u16_time_ms > 2) && ((uint32_t)u16_cycles < ((uint32_t)(u16_time_ms - 2) * PROFILE_CYCLES_PER_MS)))
+		{
+			u16_cycles = PROFILE_SATURATED_CYCLES;
+		}
+
+		ptr_str_stats = &gs_astr_profile[copy_enu_probe];
+		if (ptr_str_stats->u16_runs == U8_ZERO_VALUE)
+		{
+			// First run: it is the whole history
+			ptr_str_stats->u16_min_cycles = u16_cycles;
+			ptr_str_stats->u16_max_cycles = u16_cycles;
+			ptr_str_stats->u16_avg_cycles = u16_cycles;
+		}
+		else
+		{
+			if (u16_cycles < ptr_str_stats->u16_min_cycles)
+			{
+				ptr_str_stats->u16_min_cycles = u16_cycles;
+			}
+			if (u16_cycles > ptr_str_stats->u16_max_cycles)
+			{
+				ptr_str_stats->u16_max_cycles = u16_cycles;
+			}
+			// Shifts only, no division: the average may read up to 2^PROFILE_AVG_SHIFT cycles short
+			ptr_str_stats->u16_avg_cycles = (uint16_t)(ptr_str_stats->u16_avg_cycles - (ptr_str_stats->u16_avg_cycles >> PROFILE_AVG_SHIFT)
+													   + (u16_cycles >> PROFILE_AVG_SHIFT));
+		}
+		if (ptr_str_stats->u16_runs < 0xFFFF)
+		{
+			ptr_str_stats->u16_runs++;
+		}
+	}
+}
+
+profile_enu_return_state_t PROFILE_get(profile_enu_probe_t copy_enu_probe, profile_str_stats_t *ptr_str_stats)
+{
+	profile_enu_return_state_t enu_return_state = PROFILE_OK;
+
+	if ((ptr_str_stats == NULL) || (copy_enu_probe >= PROFILE_PROBE_MAX))
+	{
+		enu_return_state = PROFILE_NOK;
+	}
+	else
+	{
+		*ptr_str_stats = gs_astr_profile[copy_enu_probe];
+	}
+	return enu_return_state;
+}
+
+void PROFILE_reset(void)
+{
+	for (uint8_t u8_index = U8_ZERO_VALUE ; u8_index < PROFILE_PROBE_MAX ; u8_index++)
+	{
+		gs_astr_profile[u8_index].u16_runs = U8_ZERO_VALUE;
+	}
+}
@@ -0,0 +1,29 @@
+/**
+ * @file SCHEDULER_config.h
+ * @brief Cooperative Scheduler Configuration Header File
+ *
+ * This header file defines configuration parameters for the cooperative scheduler.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef SCHEDULER_CONFIG_H_
+#define SCHEDULER_CONFIG_H_
+
+/**
+ * @brief Maximum number of tasks in the task table.
+ */
+#define SCHED_MAX_TASKS			8
+
+/**
+ * @brief Length of the window the idle time is measured over in ms.
+ */
+#define SCHED_IDLE_WINDOW_MS	1000
+
+/**
+ * @brief Timer 1 counts per ms, it runs free at F_CPU (8 MHz) and times the idle loop.
+ */
+#define SCHED_CYCLES_PER_MS		8000UL
+
+#endif /* SCHEDULER_CONFIG_H_ */
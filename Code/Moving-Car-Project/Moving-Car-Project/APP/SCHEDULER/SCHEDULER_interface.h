@@ -0,0 +1,95 @@
+/**
+ * @file SCHEDULER_interface.h
+ * @brief Cooperative Scheduler Interface Header File
+ *
+ * This header file defines the interface of the time-triggered cooperative scheduler. The tasks are a const table
+ * of functions with their period and offset in ms. One hardware tick releases the tasks that are due and the main
+ * loop runs them to completion in table order, so the first task has the highest priority.
+ *
+ * A task still waiting to run when it is released again has missed its deadline: the release is dropped and counted
+ * as an overrun. The time the main loop finds no task to run is measured as idle time.
+ *
+ * Every task that returns checks in with the watchdog supervisor, the task index is its client index.
+ * Every run of a task is timed by the profiler, the task index is its probe index.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef SCHEDULER_INTERFACE_H_
+#define SCHEDULER_INTERFACE_H_
+
+#include "../../STD_LIB/bit_math.h"
+#include "../../STD_LIB/std_types.h"
+#include "SCHEDULER_config.h"
+
+
+/**
+ * @brief One task of the task table.
+ */
+typedef struct {
+    void (*ptr_func_task)(void);	/**< Task function, runs to completion. */
+    uint16_t u16_period_ms;			/**< Period of the task in ms (1 or more). */
+    uint16_t u16_offset_ms;			/**< Delay of the first release in ms, spreads the tasks over the ticks. */
+} sched_str_task_t;
+
+/**
+ * @brief Enumeration defining return states for scheduler functions.
+ */
+typedef enum {
+    SCHED_OK,	/**< Operation was successful. */
+    SCHED_NOK	/**< Operation failed. */
+} sched_enu_return_state_t;
+
+
+/**
+ * @brief Initialize the scheduler with its task table.
+ *
+ * @param ptr_str_tasks Pointer to the task table, in priority order.
+ * @param copy_u8_tasks_num Number of tasks in the table.
+ * @return The return state of the initialization.
+ *     - #SCHED_OK: Initialization successful.
+ *     - #SCHED_NOK: NULL pointer, NULL task, zero period or more than #SCHED_MAX_TASKS tasks.
+ */
+sched_enu_return_state_t SCHED_init(const sched_str_task_t *ptr_str_tasks, uint8_t copy_u8_tasks_num);
+
+/**
+ * @brief Release the tasks that are due.
+ *
+ * Must be called every 1 ms (usually from the system tick interrupt). Its cost is one countdown per task.
+ */
+void SCHED_tick(void);
+
+/**
+ * @brief Run the released tasks, or idle until the next release if there are none.
+ *
+ * Must be called forever from the main loop.
+ */
+void SCHED_dispatch(void);
+
+/**
+ * @brief Read the deadline overruns of a task.
+ *
+ * @param copy_u8_task_index Index of the task in the task table.
+ * @param ptr_u16_overruns Pointer to store the number of dropped releases (saturates at 65535).
+ * @return The return state of reading the overruns.
+ *     - #SCHED_OK: Overruns read successfully.
+ *     - #SCHED_NOK: NULL pointer or index out of the task table.
+ */
+sched_enu_return_state_t SCHED_get_overruns(uint8_t copy_u8_task_index, uint16_t *ptr_u16_overruns);
+
+/**
+ * @brief Read the idle time of the last measurement window.
+ *
+ * @return Share of the last #SCHED_IDLE_WINDOW_MS the main loop had no task to run, in percent.
+ */
+uint8_t SCHED_get_idle_percent(void);
+
+/**
+ * @brief Read the scheduler clock.
+ *
+ * @return Ticks since SCHED_init() in ms, wraps around every 65.5 s.
+ */
+uint16_t SCHED_get_time(void);
+
+#endif /* SCHEDULER_INTERFACE_H_ */
@@ -0,0 +1,251 @@
+/**
+ * @file SCHEDULER_prog.c
+ * @brief Cooperative Scheduler Implementation File
+ *
+ * This file implements the time-triggered cooperative scheduler: the system tick counts the tasks down
+ * and marks the due ones pending, the main loop runs the pending task with the highest priority.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "SCHEDULER_interface.h"
+#include "../PROFILE/PROFILE_interface.h"
+#include "../../HAL/TIMER_manager/TIMER_manger_interface.h"
+#include "../../HAL/POWER/POWER_interface.h"
+#include "../../HAL/LOG/LOG_interface.h"
+#include "../../HAL/SUPERVISOR/SUPERVISOR_interface.h"
+#include "../../MCAL/AVR_ARCH/ISR_interface.h"
+
+/**
+ * @brief Release state of a task.
+ */
+typedef struct {
+	uint16_t u16_countdown;		/**< Ticks left until the next release. */
+	uint16_t u16_overruns;		/**< Releases dropped because the task had not run yet. */
+	uint8_t  u8_pending;		/**< TRUE from the release until the task runs. */
+} sched_str_task_state_t;
+
+/***************************************************************************/
+/*******				Static function prototypes					*******/
+/***************************************************************************/
+
+static uint8_t SCHED_take(uint8_t u8_task_index);
+static void SCHED_idle(void);
+
+
+/** @brief Task table */
+static const sched_str_task_t *gs_ptr_str_tasks = NULL;
+
+/** @brief Number of tasks in the task table, shared with the system tick */
+static volatile uint8_t gv_u8_tasks_num = U8_ZERO_VALUE;
+
+/** @brief Release state of the tasks, shared with the system tick */
+static volatile sched_str_task_state_t gv_str_task_state[SCHED_MAX_TASKS];
+
+/** @brief Set by the system tick when it released a task, ends the idle loop */
+static volatile uint8_t gv_u8_released = FALSE;
+
+/** @brief Scheduler clock in ms, advanced by the system tick */
+static volatile uint16_t gv_u16_sched_ms = U8_ZERO_VALUE;
+
+/** @brief Ticks counted in the idle measurement window */
+static volatile uint16_t gv_u16_window_ms = U8_ZERO_VALUE;
+
+/** @brief Set by the system tick when the idle measurement window is over */
+static volatile uint8_t gv_u8_window_done = FALSE;
+
+/** @brief Timer 1 cycles spent idle in the current window */
+static uint32_t gs_u32_idle_cycles = U8_ZERO_VALUE;
+
+/** @brief Idle time of the last window in percent */
+static uint8_t gs_u8_idle_percent = U8_ZERO_VALUE;
+
+
+/**
+ * @brief Take the release of a task if it is pending.
+ *
+ * @param u8_task_index Index of the task.
+ * @return TRUE if the task was pending (it is not any more), FALSE otherwise.
+ */
+static uint8_t SCHED_take(uint8_t u8_task_index)
+{
+	uint8_t u8_pending;
+	uint8_t u8_sreg;
+
+	ISR_ENTER_CRITICAL(u8_sreg);
+	u8_pending = gv_str_task_state[u8_task_index].u8_pending;
+	gv_str_task_state[u8_task_index].u8_pending = FALSE;
+	ISR_EXIT_CRITICAL(u8_sreg);
+	return u8_pending;
+}
+
+/**
+ * @brief Sleep until the next release and count the wait as idle time.
+ *
+ * The wait ends on the next tick at the latest, so its length fits Timer 1's 16 bits (8000 cycles per ms).
+ * Interrupts taken while waiting count as idle time.
+ */
+static void SCHED_idle(void)
+{
+	uint16_t u16_start = U8_ZERO_VALUE;
+	uint16_t u16_end = U8_ZERO_VALUE;
+	uint8_t u8_sreg;
+
+	TIMER_MANGER_getValue(TIMER_1,&u16_start);
+	ISR_ENTER_CRITICAL(u8_sreg);
+	while (gv_u8_released == FALSE)
+	{
+		// Nothing to run until the next release: the check and the sleep can't miss the tick between them
+		POWER_idle();
+		cli();
+	}
+	ISR_EXIT_CRITICAL(u8_sreg);
+	TIMER_MANGER_getValue(TIMER_1,&u16_end);
+	gs_u32_idle_cycles += (uint16_t)(u16_end - u16_start);
+}
+
+sched_enu_return_state_t SCHED_init(const sched_str_task_t *ptr_str_tasks, uint8_t copy_u8_tasks_num)
+{
+	sched_enu_return_state_t enu_return_state = SCHED_OK;
+	uint8_t u8_sreg;
+
+	if ((ptr_str_tasks == NULL) || (copy_u8_tasks_num > SCHED_MAX_TASKS))
+	{
+		enu_return_state = SCHED_NOK;
+	}
+	else
+	{
+		for (uint8_t u8_index = U8_ZERO_VALUE ; u8_index < copy_u8_tasks_num ; u8_index++)
+		{
+			if ((ptr_str_tasks[u8_index].ptr_func_task == NULL) || (ptr_str_tasks[u8_index].u16_period_ms == U8_ZERO_VALUE))
+			{
+				enu_return_state = SCHED_NOK;
+			}
+		}
+	}
+
+	if (enu_return_state == SCHED_OK)
+	{
+		ISR_ENTER_CRITICAL(u8_sreg);
+		for (uint8_t u8_index = U8_ZERO_VALUE ; u8_index < copy_u8_tasks_num ; u8_index++)
+		{
+			// The first release comes on the tick after the offset
+			gv_str_task_state[u8_index].u16_countdown = ptr_str_tasks[u8_index].u16_offset_ms + U8_ONE_VALUE;
+			gv_str_task_state[u8_index].u16_overruns = U8_ZERO_VALUE;
+			gv_str_task_state[u8_index].u8_pending = FALSE;
+		}
+		gs_ptr_str_tasks = ptr_str_tasks;
+		gv_u16_sched_ms = U8_ZERO_VALUE;
+		gv_u8_tasks_num = copy_u8_tasks_num;
+		ISR_EXIT_CRITICAL(u8_sreg);
+	}
+	return enu_return_state;
+}
+
+void SCHED_tick(void)
+{
+	for (uint8_t u8_index = U8_ZERO_VALUE ; u8_index < gv_u8_tasks_num ; u8_index++)
+	{
+		gv_str_task_state[u8_index].u16_countdown--;
+		if (gv_str_task_state[u8_index].u16_countdown == U8_ZERO_VALUE)
+		{
+			gv_str_task_state[u8_index].u16_countdown = gs_ptr_str_tasks[u8_index].u16_period_ms;
+			if (gv_str_task_state[u8_index].u8_pending == TRUE)
+			{
+				// Deadline missed: the last release has not run yet, drop this one
+				if (gv_str_task_state[u8_index].u16_overruns == U8_ZERO_VALUE)
+				{
+					LOG_event(LOG_EVENT_TASK_OVERRUN, u8_index, U8_ONE_VALUE);
+				}
+				if (gv_str_task_state[u8_index].u16_overruns < 0xFFFF)
+				{
+					gv_str_task_state[u8_index].u16_overruns++;
+				}
+			}
+			else
+			{
+				gv_str_task_state[u8_index].u8_pending = TRUE;
+			}
+			gv_u8_released = TRUE;
+		}
+	}
+
+	gv_u16_sched_ms++;
+	gv_u16_window_ms++;
+	if (gv_u16_window_ms >= SCHED_IDLE_WINDOW_MS)
+	{
+		gv_u16_window_ms = U8_ZERO_VALUE;
+		gv_u8_window_done = TRUE;
+	}
+}
+
+void SCHED_dispatch(void)
+{
+	uint8_t u8_index = U8_ZERO_VALUE;
+	profile_str_start_t str_start;
+
+	// Cleared before the scan: a release during the scan ends the idle wait at once
+	gv_u8_released = FALSE;
+
+	// Run the pending task with the highest priority, the next call starts from the top again
+	while ((u8_index < gv_u8_tasks_num) && (SCHED_take(u8_index) == FALSE))
+	{
+		u8_index++;
+	}
+
+	if (u8_index < gv_u8_tasks_num)
+	{
+		PROFILE_start(&str_start);
+		gs_ptr_str_tasks[u8_index].ptr_func_task();
+		PROFILE_stop((profile_enu_probe_t)(PROFILE_PROBE_TASK_FIRST + u8_index), &str_start);
+
+		// The task returned: it checks in with the watchdog supervisor as client of its index
+		SUPERVISOR_CHECK_IN(u8_index);
+	}
+	else
+	{
+		SCHED_idle();
+	}
+
+	if (gv_u8_window_done == TRUE)
+	{
+		gv_u8_window_done = FALSE;
+		gs_u8_idle_percent = (uint8_t)((gs_u32_idle_cycles * 100UL) / (SCHED_CYCLES_PER_MS * SCHED_IDLE_WINDOW_MS));
+		gs_u32_idle_cycles = U8_ZERO_VALUE;
+	}
+}
+
+sched_enu_return_state_t SCHED_get_overruns(uint8_t copy_u8_task_index, uint16_t *ptr_u16_overruns)
+{
+	sched_enu_return_state_t enu_return_state = SCHED_OK;
+	uint8_t u8_sreg;
+
+	if ((ptr_u16_overruns == NULL) || (copy_u8_task_index >= gv_u8_tasks_num))
+	{
+		enu_return_state = SCHED_NOK;
+	}
+	else
+	{
+		ISR_ENTER_CRITICAL(u8_sreg);
+		*ptr_u16_overruns = gv_str_task_state[copy_u8_task_index].u16_overruns;
+		ISR_EXIT_CRITICAL(u8_sreg);
+	}
+	return enu_return_state;
+}
+
+uint8_t SCHED_get_idle_percent(void)
+{
+	return gs_u8_idle_percent;
+}
+
+uint16_t SCHED_get_time(void)
+{
+	uint16_t u16_now;
+	uint8_t u8_sreg;
+
+	ISR_ENTER_CRITICAL(u8_sreg);
+	u16_now = gv_u16_sched_ms;
+	ISR_EXIT_CRITICAL(u8_sreg);
+	return u16_now;
+}
\ No newline at end of file
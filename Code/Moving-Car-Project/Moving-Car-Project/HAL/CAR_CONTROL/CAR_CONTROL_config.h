@@ -0,0 +1,99 @@
+/**
+ * @file CAR_CONTROL_config.h
+ * @brief Car Control Configuration Header File
+ *
+ * This header file defines configuration parameters for the closed loop wheel speed control.
+ * Gains are Q8 fixed point (256 = 1.0), velocities are in percent of #CAR_WHEEL_FULL_SPEED_EDGES_PER_S.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef CAR_CONTROL_CONFIG_H_
+#define CAR_CONTROL_CONFIG_H_
+
+/**
+ * @brief Period of the wheel speed control in ms (CAR_speed_control_tick() must be called at this rate).
+ */
+#define CAR_SPEED_CTRL_PERIOD_MS    10
+
+/**
+ * @brief Wheel speed of a 100% setpoint in encoder edges per second (4 rev/s with a 20 slots disk).
+ *
+ * Keep it below the speed a drained battery reaches at full duty, so every setpoint stays reachable.
+ */
+#define CAR_WHEEL_FULL_SPEED_EDGES_PER_S    160UL
+
+/**
+ * @brief Shortest time in ms between the edges a speed is measured over.
+ *
+ * The edge times are known to #ENCODER_POLL_MS, so a longer span gives a finer speed (5% at 20 ms)
+ * and a slower response.
+ */
+#define CAR_SPEED_MIN_SPAN_MS    20
+
+/**
+ * @brief Time in ms without an edge after which a wheel is taken as stopped.
+ */
+#define CAR_SPEED_TIMEOUT_MS    250
+
+/**
+ * @brief Feed-forward gain: output per percent of setpoint (Q8).
+ *
+ * With 256 the setpoint alone gives the matching duty on a fresh battery, the PID only trims the difference.
+ */
+#define CAR_PID_KFF    256L
+
+/**
+ * @brief Proportional gain: output per percent of speed error (Q8).
+ */
+#define CAR_PID_KP    256L
+
+/**
+ * @brief Integral gain: output added every period per percent of speed error (Q8).
+ */
+#define CAR_PID_KI    32L
+
+/**
+ * @brief Derivative gain on the measured speed (Q8), 0 since the edge timing noise dominates the derivative.
+ *
+ * All gains must stay below 4096 (16.0) to keep the controller sums in 32 bits.
+ */
+#define CAR_PID_KD    0L
+
+/**
+ * @brief Wheel speed in percent of a turn by CAR_rotate_deg() while far from the target.
+ */
+#define CAR_TURN_SPEED_MAX    50
+
+/**
+ * @brief Wheel speed in percent at the end of a turn, still enough to turn the car against the floor friction.
+ */
+#define CAR_TURN_SPEED_MIN    15
+
+/**
+ * @brief Remaining angle in degrees where a turn starts to slow down from #CAR_TURN_SPEED_MAX to #CAR_TURN_SPEED_MIN.
+ */
+#define CAR_TURN_SLOW_DOWN_DEG    30
+
+/**
+ * @brief Remaining angle in degrees where a turn is finished and the wheels are braked.
+ */
+#define CAR_TURN_TOLERANCE_DEG    2
+
+/**
+ * @brief Heading hold trim per edge of right/left difference (Q8 percent, 128 = 0.5% per edge).
+ */
+#define CAR_HEADING_HOLD_GAIN    128
+
+/**
+ * @brief Largest heading hold trim in percent of the wheel speed.
+ */
+#define CAR_HEADING_HOLD_MAX_TRIM    10
+
+/**
+ * @brief Edge difference giving the largest trim, the heading error is limited to it.
+ */
+#define CAR_HEADING_HOLD_MAX_EDGES    ((CAR_HEADING_HOLD_MAX_TRIM * 256) / CAR_HEADING_HOLD_GAIN)
+
+#endif /* CAR_CONTROL_CONFIG_H_ */
@@ -19,7 +19,10 @@
 #ifndef CAR_CONTRO_INTERFACE_H_
 #define CAR_CONTRO_INTERFACE_H_
 
-#include "../motor/MOTOR_interface.h"
+#include "../MOTOR/MOTOR_interface.h"
+#include "../ENCODER/ENCODER_interface.h"
+#include "../ODOMETRY/ODOMETRY_interface.h"
+#include "CAR_CONTROL_config.h"
 
 
 /**
@@ -36,10 +39,31 @@ typedef enum car_enu_return_state_t
 } car_enu_return_state_t;
 
 
+/**
+ * @brief Enumeration of the car motion primitives driven by CAR_apply().
+ *
+ * Primitives drive the motors at full voltage without PWM, ramp or dead time.
+ */
+typedef enum car_enu_primitive_t
+{
+    CAR_PRIMITIVE_FORWARD = 0,  /**< Both wheels forward. */
+    CAR_PRIMITIVE_BACKWARD,     /**< Both wheels backward. */
+    CAR_PRIMITIVE_PIVOT_LEFT,   /**< Left wheel backward, right wheel forward (turn on the spot). */
+    CAR_PRIMITIVE_PIVOT_RIGHT,  /**< Left wheel forward, right wheel backward (turn on the spot). */
+    CAR_PRIMITIVE_ARC_LEFT,     /**< Left wheel coasting, right wheel forward. */
+    CAR_PRIMITIVE_ARC_RIGHT,    /**< Left wheel forward, right wheel coasting. */
+    CAR_PRIMITIVE_BRAKE,        /**< Both wheels shorted (active brake). */
+    CAR_PRIMITIVE_COAST,        /**< Both wheels free. */
+    CAR_PRIMITIVE_MAX
+} car_enu_primitive_t;
+
+
 /**
  * @brief Initialize the car with two motors.
  *
  * This function initializes the car by initializing two motors with the provided motor configurations.
+ * The car keeps the motor pair (first motor = left wheel, second motor = right wheel) for CAR_set_twist()
+ * and precomputes the port value of every motion primitive for CAR_apply().
  *
  * @param ptr_str_motor_1 Pointer to the configuration structure of the first motor.
  * @param ptr_str_motor_2 Pointer to the configuration structure of the second motor.
@@ -67,6 +91,25 @@ car_enu_return_state_t CAR_INIT(const motor_str_config_t *ptr_str_motor_1,const
 car_enu_return_state_t CAR_FORWARD(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2);
 
 
+/**
+ * @brief Drive the two motors of the car with their own signed velocities.
+ *
+ * This function sets the velocity of each motor, so the car can move forward, backward or turn
+ * with proportional speed. The motors' calibration trims are applied by the motor module.
+ *
+ * @param ptr_str_motor_1 Pointer to the configuration structure of the first motor.
+ * @param ptr_str_motor_2 Pointer to the configuration structure of the second motor.
+ * @param copy_s8_velocity_1 Velocity of the first motor in percent (-100 .. 100).
+ * @param copy_s8_velocity_2 Velocity of the second motor in percent (-100 .. 100).
+ * @return The return state of the car velocity operation.
+ *     - #CAR_OK: Car velocity set successfully.
+ *     - #CAR_NOK: Car velocity operation failed due to motor errors.
+ *     - #CAR_NULL_PTR: One or both motor configuration pointers are NULL.
+ */
+car_enu_return_state_t CAR_SET_VELOCITY(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2,
+										sint8_t copy_s8_velocity_1,sint8_t copy_s8_velocity_2);
+
+
 /**
  * @brief Move the car in a reverse right direction using two motors.
  *
@@ -97,4 +140,131 @@ car_enu_return_state_t CAR_REVERSE_RIGHT(const motor_str_config_t *ptr_str_motor
  */
 car_enu_return_state_t CAR_STOP(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2);
 
+/**
+ * @brief Brake the car actively using two motors.
+ *
+ * This function shorts both motors through the H-bridge (both control pins high), which stops the car
+ * in a much shorter distance than letting the motors coast. The brake is held until the next command.
+ *
+ * @param ptr_str_motor_1 Pointer to the configuration structure of the first motor.
+ * @param ptr_str_motor_2 Pointer to the configuration structure of the second motor.
+ * @return The return state of the car brake operation.
+ *     - #CAR_OK: Car braking successfully.
+ *     - #CAR_NOK: Car brake operation failed due to motor errors.
+ *     - #CAR_NULL_PTR: One or both motor configuration pointers are NULL.
+ */
+car_enu_return_state_t CAR_BRAKE(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2);
+
+/**
+ * @brief Drive the car with a linear and an angular velocity.
+ *
+ * This function mixes the two velocities into the wheel velocities of the motor pair kept by CAR_INIT():
+ * left = linear - angular, right = linear + angular. If a wheel velocity goes past 100%, both wheels
+ * are scaled down by the same ratio so the car keeps the commanded curvature at the highest possible speed.
+ * Arcs (both non zero), pivots (linear = 0) and straight lines (angular = 0) all take one call.
+ * Once CAR_speed_control_init() attached the encoders, the wheel velocities are speed setpoints held by the PID.
+ *
+ * @param copy_s8_linear Forward velocity in percent of the full wheel speed (-100 .. 100, positive = forward).
+ * @param copy_s8_angular Turning velocity in percent of the full wheel speed difference (-100 .. 100, positive = left).
+ * @return The return state of the car twist operation.
+ *     - #CAR_OK: Car velocities set successfully.
+ *     - #CAR_NOK: The car is not initialized or a motor refused the command.
+ */
+car_enu_return_state_t CAR_set_twist(sint8_t copy_s8_linear, sint8_t copy_s8_angular);
+
+/**
+ * @brief Drive the car with a motion primitive.
+ *
+ * This function looks up the port value precomputed by CAR_INIT() and writes both motors with one atomic
+ * port write (two if the motors are on different ports). The first call after a velocity command releases
+ * the motors from the PWM and ramp. Primitives skip the ramp, but a wheel driven the other way (or by the
+ * ramp) coasts for MOTOR_DEAD_TIME_MS before it is driven: the call then waits the dead time. A braked wheel
+ * can be driven either way at once. Driving primitives are refused while a motor has an overcurrent fault,
+ * brake and coast are always applied.
+ *
+ * @param copy_enu_primitive The motion primitive.
+ * @return The return state of the car primitive operation.
+ *     - #CAR_OK: Primitive applied successfully.
+ *     - #CAR_NOK: The car is not initialized, the primitive is invalid or a motor has a fault.
+ */
+car_enu_return_state_t CAR_apply(car_enu_primitive_t copy_enu_primitive);
+
+/**
+ * @brief Attach the wheel encoders and enable the closed loop wheel speed control.
+ *
+ * This function initializes the encoders of the motor pair kept by CAR_INIT(). From then on CAR_set_twist()
+ * and CAR_set_wheel_speed() give wheel speeds that a PID per wheel holds whatever the battery level and
+ * the floor, while the other car commands drive the motors in open loop until the next speed command.
+ *
+ * @param ptr_str_encoder_left Pointer to the configuration structure of the left wheel encoder.
+ * @param ptr_str_encoder_right Pointer to the configuration structure of the right wheel encoder.
+ * @return The return state of the speed control initialization.
+ *     - #CAR_OK: Speed control initialization successful.
+ *     - #CAR_NOK: The car is not initialized or an encoder initialization failed.
+ *     - #CAR_NULL_PTR: One or both encoder configuration pointers are NULL.
+ */
+car_enu_return_state_t CAR_speed_control_init(const encoder_str_config_t *ptr_str_encoder_left,const encoder_str_config_t *ptr_str_encoder_right);
+
+/**
+ * @brief Set the speed of both wheels under closed loop control.
+ *
+ * The speeds are in percent of #CAR_WHEEL_FULL_SPEED_EDGES_PER_S and positive forward. A speed of 0
+ * lets the motor ramp stop the wheel.
+ *
+ * @param copy_s8_left Left wheel speed in percent (-100 .. 100).
+ * @param copy_s8_right Right wheel speed in percent (-100 .. 100).
+ * @return The return state of the wheel speed operation.
+ *     - #CAR_OK: Wheel speeds set successfully.
+ *     - #CAR_NOK: The speed control is not initialized.
+ */
+car_enu_return_state_t CAR_set_wheel_speed(sint8_t copy_s8_left,sint8_t copy_s8_right);
+
+/**
+ * @brief Turn the car on the spot by an angle measured on the wheels.
+ *
+ * The turn runs in the background from CAR_speed_control_tick(): the wheels pivot under speed control, slow
+ * down over the last #CAR_TURN_SLOW_DOWN_DEG and are braked when the odometry heading reaches the target.
+ * Poll CAR_is_turning() for the end of the turn. Any other car command cancels it.
+ *
+ * @param copy_s16_angle Angle in degrees, positive counterclockwise (left), negative clockwise (right).
+ * @return The return state of the turn operation.
+ *     - #CAR_OK: Turn started (or nothing to turn).
+ *     - #CAR_NOK: The speed control is not initialized.
+ */
+car_enu_return_state_t CAR_rotate_deg(sint16_t copy_s16_angle);
+
+/**
+ * @brief Enable or disable the heading hold of straight lines.
+ *
+ * While enabled, a speed command with the same non zero speed on both wheels (CAR_set_twist() with angular = 0)
+ * keeps the heading it starts with: the wheel setpoints are trimmed every period from the difference of the
+ * wheel encoder counts, so mismatched motors still drive a straight line.
+ *
+ * @param copy_u8_enable TRUE to hold the heading, FALSE to drive the wheel setpoints as given.
+ */
+void CAR_set_heading_hold(uint8_t copy_u8_enable);
+
+/**
+ * @brief Check whether a CAR_rotate_deg() turn is running.
+ *
+ * @return TRUE while the turn runs, FALSE once it is finished or cancelled.
+ */
+uint8_t CAR_is_turning(void);
+
+/**
+ * @brief Run one period of the wheel speed control.
+ *
+ * Must be called every #CAR_SPEED_CTRL_PERIOD_MS from the timer tick, with ENCODER_poll() called every
+ * #ENCODER_POLL_MS. It measures both wheel speeds, moves the odometry pose by the wheel edges of the period,
+ * runs the turn of CAR_rotate_deg() and the heading hold and, while a speed command is active, commands the motors.
+ */
+void CAR_speed_control_tick(void);
+
+/**
+ * @brief Read the longest run of CAR_speed_control_tick() so far.
+ *
+ * @return Longest run in CPU cycles (Timer 1 counts, Timer 1 must run at F_CPU).
+ */
+uint16_t CAR_get_speed_control_cycles(void);
+
 #endif /* CAR_CONTROL_INTERFACE_H_ */
\ No newline at end of file
@@ -12,6 +12,493 @@
 
 
 #include"CAR_CONTROL_interface.h"
+#include "../../MCAL/AVR_ARCH/ISR_interface.h"
+
+/** @brief Full scale of a wheel velocity in percent */
+#define CAR_WHEEL_MAX_PERCENT	100
+
+/** @brief Wheels of the car, in the order given to CAR_INIT() */
+#define CAR_WHEEL_LEFT			0
+#define CAR_WHEEL_RIGHT			1
+#define CAR_WHEEL_NUM			2
+
+/** @brief Speed control fixed point format (Q8: 1/256 percent) */
+#define CAR_Q8_ONE				256L
+#define CAR_SPEED_MAX_Q8		((sint32_t)CAR_WHEEL_MAX_PERCENT * CAR_Q8_ONE)
+
+/** @brief Measured speed (Q8 percent) of one edge per ms */
+#define CAR_SPEED_SCALE			(((uint32_t)CAR_WHEEL_MAX_PERCENT * CAR_Q8_ONE * 1000UL) / CAR_WHEEL_FULL_SPEED_EDGES_PER_S)
+
+/** @brief Turn states */
+#define CAR_TURN_IDLE			0	/**< No turn running. */
+#define CAR_TURN_RUNNING		1	/**< CAR_rotate_deg() turn running from the control tick. */
+
+/** @brief Signed binary angle of an angle in degrees (32 bits, so turns beyond half a turn fit) */
+#define CAR_DEG_TO_ANGLE(deg)	(((sint32_t)(deg) * 65536L) / 360L)
+
+/** @brief Speed control states */
+#define CAR_SPEED_CTRL_OFF		0	/**< No encoders, CAR_set_twist() drives the motors in open loop. */
+#define CAR_SPEED_CTRL_IDLE		1	/**< Encoders attached, an open loop command holds the motors. */
+#define CAR_SPEED_CTRL_ACTIVE	2	/**< The PID drives the motors towards the wheel setpoints. */
+
+/** @brief Maximum number of port writes per primitive (one per motor) */
+#define CAR_MAX_PORT_WRITES		2
+
+/** @brief Motor pin levels used to build the primitives */
+#define CAR_MOTOR_COAST			0	/**< Both control pins low. */
+#define CAR_MOTOR_FORWARD		1	/**< Pin 1 high. */
+#define CAR_MOTOR_BACKWARD		2	/**< Pin 2 high. */
+#define CAR_MOTOR_BRAKE			3	/**< Both control pins high. */
+#define CAR_MOTOR_UNKNOWN		4	/**< Driven by the ramp, in either direction. */
+
+/** @brief Timer 1 counts per ms (Timer 1 runs at F_CPU = 8M) */
+#define CAR_CYCLES_PER_MS		8000UL
+
+/** @brief Motor dead time in Timer 1 counts, waited by CAR_apply() before a wheel reverses */
+#define CAR_DEAD_TIME_CYCLES	((uint16_t)(MOTOR_DEAD_TIME_MS * CAR_CYCLES_PER_MS))
+
+#if ((MOTOR_DEAD_TIME_MS * CAR_CYCLES_PER_MS) > 65535UL)
+#error "MOTOR_DEAD_TIME_MS is too long for a Timer 1 wait"
+#endif
+
+/**
+ * @brief One masked port write of a primitive.
+ */
+typedef struct {
+	dio_enu_port_t enu_port;								/**< Port of the motor pins. */
+	uint8_t u8_mask;										/**< Motor pins on the port. */
+	uint8_t au8_value[CAR_PRIMITIVE_MAX];					/**< Pins value of every primitive. */
+} car_str_port_write_t;
+
+/**
+ * @brief Car object: the motor pair driven by the car level functions.
+ */
+typedef struct {
+	const motor_str_config_t *ptr_str_motor_left;			/**< First motor given to CAR_INIT(). */
+	const motor_str_config_t *ptr_str_motor_right;			/**< Second motor given to CAR_INIT(). */
+	car_str_port_write_t astr_port_write[CAR_MAX_PORT_WRITES];	/**< Precomputed primitive writes. */
+	uint8_t u8_port_writes;									/**< Port writes per primitive (1 if both motors share a port). */
+	uint8_t u8_fault_mask;									/**< Fault bits of the two motors (see MOTOR_get_fault_mask()). */
+	uint8_t u8_released;									/**< TRUE while the motors are released from the speed control. */
+	uint8_t au8_drive_level[CAR_WHEEL_NUM];					/**< Level each wheel was last driven with by CAR_apply(), COAST if free to reverse. */
+} car_str_t;
+
+/**
+ * @brief Speed control state of a wheel, shared between the API and the timer tick.
+ */
+typedef struct {
+	const encoder_str_config_t *ptr_str_encoder;	/**< Encoder of the wheel. */
+	uint16_t u16_ref_count;							/**< Edge count at the reference edge. */
+	uint16_t u16_ref_time;							/**< Encoder time of the reference edge. */
+	sint32_t s32_speed;								/**< Measured speed, magnitude (Q8 percent). */
+	sint32_t s32_last_speed;						/**< Measured speed of the previous period (Q8 percent). */
+	sint32_t s32_integral;							/**< PID integral term (Q8 percent). */
+	uint16_t u16_odo_count;							/**< Edge count already given to the odometry. */
+	sint8_t  s8_direction;							/**< Direction the wheel was last driven in (-1, 0, 1), signs its edges. */
+	sint8_t  s8_setpoint;							/**< Wheel setpoint in percent. */
+	sint16_t s16_trim;								/**< Heading hold trim added to the setpoint (Q8 percent). */
+	sint8_t  s8_output;								/**< Velocity commanded to the motor in percent. */
+} car_str_wheel_t;
+
+/** @brief Left and right motor levels of every primitive, indexed by car_enu_primitive_t */
+static const uint8_t gc_u8_primitive_levels[CAR_PRIMITIVE_MAX][2] = {
+	{CAR_MOTOR_FORWARD,  CAR_MOTOR_FORWARD},		// CAR_PRIMITIVE_FORWARD
+	{CAR_MOTOR_BACKWARD, CAR_MOTOR_BACKWARD},		// CAR_PRIMITIVE_BACKWARD
+	{CAR_MOTOR_BACKWARD, CAR_MOTOR_FORWARD},		// CAR_PRIMITIVE_PIVOT_LEFT
+	{CAR_MOTOR_FORWARD,  CAR_MOTOR_BACKWARD},		// CAR_PRIMITIVE_PIVOT_RIGHT
+	{CAR_MOTOR_COAST,    CAR_MOTOR_FORWARD},		// CAR_PRIMITIVE_ARC_LEFT
+	{CAR_MOTOR_FORWARD,  CAR_MOTOR_COAST},			// CAR_PRIMITIVE_ARC_RIGHT
+	{CAR_MOTOR_BRAKE,    CAR_MOTOR_BRAKE},			// CAR_PRIMITIVE_BRAKE
+	{CAR_MOTOR_COAST,    CAR_MOTOR_COAST}			// CAR_PRIMITIVE_COAST
+};
+
+/** @brief The car, filled by CAR_INIT() */
+static car_str_t gs_str_car;
+
+/** @brief Speed control of the wheels, indexed by CAR_WHEEL_LEFT and CAR_WHEEL_RIGHT */
+static volatile car_str_wheel_t gv_str_wheel[CAR_WHEEL_NUM];
+
+/** @brief Speed control state */
+static volatile uint8_t gv_u8_speed_ctrl_state = CAR_SPEED_CTRL_OFF;
+
+/** @brief Turn state */
+static volatile uint8_t gv_u8_turn_state = CAR_TURN_IDLE;
+
+/** @brief Direction of the running turn (1 left, -1 right) */
+static volatile sint8_t gv_s8_turn_dir = U8_ZERO_VALUE;
+
+/** @brief Angle left to turn (signed binary angle) */
+static volatile sint32_t gv_s32_turn_remaining = U8_ZERO_VALUE;
+
+/** @brief Odometry heading at the last turn step */
+static volatile uint16_t gv_u16_turn_heading = U8_ZERO_VALUE;
+
+/** @brief TRUE when straight speed commands hold the heading */
+static volatile uint8_t gv_u8_hold_enabled = FALSE;
+
+/** @brief Straight setpoint the heading is held for, 0 while not holding */
+static volatile sint8_t gv_s8_hold_setpoint = U8_ZERO_VALUE;
+
+/** @brief Right minus left wheel edges since the hold started (positive = the car turned left) */
+static volatile sint16_t gv_s16_hold_error = U8_ZERO_VALUE;
+
+/** @brief Longest CAR_speed_control_tick() run in Timer 1 counts (CPU cycles) */
+static volatile uint16_t gv_u16_speed_ctrl_cycles_max = U8_ZERO_VALUE;
+
+static void CAR_build_primitives(void);
+static void CAR_open_loop(void);
+static uint16_t CAR_measure_speed(volatile car_str_wheel_t *ptr_str_wheel, uint16_t u16_now);
+static sint8_t CAR_pid_step(volatile car_str_wheel_t *ptr_str_wheel, sint8_t s8_applied);
+static void CAR_command_wheels(sint8_t s8_left, sint8_t s8_right);
+static void CAR_reverse_dead_time(car_enu_primitive_t enu_primitive);
+static void CAR_turn_step(void);
+static void CAR_heading_hold_step(sint16_t s16_left_edges, sint16_t s16_right_edges);
+
+
+/**
+ * @brief Precompute the port writes of every primitive for the motor pair of the car.
+ *
+ * Both motors share one write when they are on the same port.
+ */
+static void CAR_build_primitives(void)
+{
+	const motor_str_config_t *apstr_motor[2] = {gs_str_car.ptr_str_motor_left, gs_str_car.ptr_str_motor_right};
+	car_str_port_write_t *ptr_str_write;
+	uint8_t u8_pin_1;
+	uint8_t u8_pin_2;
+	uint8_t u8_level;
+
+	gs_str_car.u8_port_writes = U8_ZERO_VALUE;
+	for (uint8_t u8_motor = U8_ZERO_VALUE ; u8_motor < 2 ; u8_motor++)
+	{
+		// Reuse the write of the first motor if the second one is on the same port
+		if ((gs_str_car.u8_port_writes != U8_ZERO_VALUE) && (gs_str_car.astr_port_write[0].enu_port == apstr_motor[u8_motor]->port))
+		{
+			ptr_str_write = &gs_str_car.astr_port_write[0];
+		}
+		else
+		{
+			ptr_str_write = &gs_str_car.astr_port_write[gs_str_car.u8_port_writes];
+			gs_str_car.u8_port_writes++;
+			ptr_str_write->enu_port = apstr_motor[u8_motor]->port;
+			ptr_str_write->u8_mask = U8_ZERO_VALUE;
+			for (uint8_t u8_primitive = U8_ZERO_VALUE ; u8_primitive < CAR_PRIMITIVE_MAX ; u8_primitive++)
+			{
+				ptr_str_write->au8_value[u8_primitive] = U8_ZERO_VALUE;
+			}
+		}
+
+		u8_pin_1 = (uint8_t)(U8_ONE_VALUE << apstr_motor[u8_motor]->pin_num1);
+		u8_pin_2 = (uint8_t)(U8_ONE_VALUE << apstr_motor[u8_motor]->pin_num2);
+		ptr_str_write->u8_mask |= (uint8_t)(u8_pin_1 | u8_pin_2);
+		for (uint8_t u8_primitive = U8_ZERO_VALUE ; u8_primitive < CAR_PRIMITIVE_MAX ; u8_primitive++)
+		{
+			u8_level = gc_u8_primitive_levels[u8_primitive][u8_motor];
+			if ((u8_level == CAR_MOTOR_FORWARD) || (u8_level == CAR_MOTOR_BRAKE))
+			{
+				ptr_str_write->au8_value[u8_primitive] |= u8_pin_1;
+			}
+			if ((u8_level == CAR_MOTOR_BACKWARD) || (u8_level == CAR_MOTOR_BRAKE))
+			{
+				ptr_str_write->au8_value[u8_primitive] |= u8_pin_2;
+			}
+		}
+	}
+
+	gs_str_car.u8_fault_mask = (uint8_t)((U8_ONE_VALUE << gs_str_car.ptr_str_motor_left->enu_pwm_unit)
+									   | (U8_ONE_VALUE << gs_str_car.ptr_str_motor_right->enu_pwm_unit));
+	gs_str_car.u8_released = FALSE;
+}
+
+
+/**
+ * @brief Hand the motors to an open loop command: the speed control stops driving them.
+ *
+ * Must be called before the command so the next control period can't overwrite it.
+ */
+static void CAR_open_loop(void)
+{
+	gs_str_car.u8_released = FALSE;
+	gv_u8_turn_state = CAR_TURN_IDLE;
+	if (gv_u8_speed_ctrl_state == CAR_SPEED_CTRL_ACTIVE)
+	{
+		gv_u8_speed_ctrl_state = CAR_SPEED_CTRL_IDLE;
+	}
+}
+
+
+/**
+ * @brief Measure the speed of a wheel from its encoder edges.
+ *
+ * The speed is the number of edges since the reference edge divided by their time, once that time is
+ * at least CAR_SPEED_MIN_SPAN_MS. While the next edge is late, the speed is limited to one more edge
+ * over the time elapsed, so a stopping wheel is seen slowing down instead of keeping its last speed.
+ *
+ * @param ptr_str_wheel The wheel.
+ * @param u16_now Current encoder time.
+ * @return The edge count of the wheel encoder.
+ */
+static uint16_t CAR_measure_speed(volatile car_str_wheel_t *ptr_str_wheel, uint16_t u16_now)
+{
+	uint16_t u16_count = ptr_str_wheel->u16_ref_count;
+	uint16_t u16_edge_time = ptr_str_wheel->u16_ref_time;
+	uint16_t u16_edges;
+	uint16_t u16_span;
+	uint32_t u32_bound;
+
+	ENCODER_get_edge(ptr_str_wheel->ptr_str_encoder,&u16_count,&u16_edge_time);
+	u16_edges = u16_count - ptr_str_wheel->u16_ref_count;
+	u16_span = u16_edge_time - ptr_str_wheel->u16_ref_time;
+
+	if ((u16_edges != U8_ZERO_VALUE) && (u16_span >= CAR_SPEED_MIN_SPAN_MS))
+	{
+		ptr_str_wheel->s32_speed = (sint32_t)(((uint32_t)u16_edges * CAR_SPEED_SCALE) / u16_span);
+		ptr_str_wheel->u16_ref_count = u16_count;
+		ptr_str_wheel->u16_ref_time = u16_edge_time;
+	}
+	else
+	{
+		u16_span = u16_now - ptr_str_wheel->u16_ref_time;
+		if (u16_span >= CAR_SPEED_TIMEOUT_MS)
+		{
+			// Wheel stopped, restart the measure from now
+			ptr_str_wheel->s32_speed = U8_ZERO_VALUE;
+			ptr_str_wheel->u16_ref_count = u16_count;
+			ptr_str_wheel->u16_ref_time = u16_now;
+		}
+		else if (u16_span != U8_ZERO_VALUE)
+		{
+			// Compare before dividing, the division is only paid when the bound is lower
+			u32_bound = ((uint32_t)u16_edges + U8_ONE_VALUE) * CAR_SPEED_SCALE;
+			if (u32_bound < ((uint32_t)ptr_str_wheel->s32_speed * u16_span))
+			{
+				ptr_str_wheel->s32_speed = (sint32_t)(u32_bound / u16_span);
+			}
+		}
+		else
+		{
+			// No time elapsed, keep the speed
+		}
+	}
+	return u16_count;
+}
+
+
+/**
+ * @brief Run one PID period of a wheel.
+ *
+ * The controller works on magnitudes: setpoint and speed are both positive and the output (0 .. 100%)
+ * takes the sign of the setpoint, so it never reverses a wheel to slow it down. The output is
+ * feed-forward + proportional + integral - derivative of the measured speed (no kick on setpoint steps).
+ * Anti-windup: the integral is frozen while the output is saturated in the direction of the error or
+ * while the motor ramp has not reached the last output yet.
+ *
+ * The heading hold trim moves the setpoint, it can slow a wheel down to zero but never reverse it.
+ *
+ * @param ptr_str_wheel The wheel, with a fresh speed.
+ * @param s8_applied Velocity the motor ramp drives on the wheel now.
+ * @return The velocity to command to the motor in percent.
+ */
+static sint8_t CAR_pid_step(volatile car_str_wheel_t *ptr_str_wheel, sint8_t s8_applied)
+{
+	sint32_t s32_setpoint = ((sint32_t)ptr_str_wheel->s8_setpoint * CAR_Q8_ONE) + ptr_str_wheel->s16_trim;
+	sint32_t s32_speed = ptr_str_wheel->s32_speed;
+	sint32_t s32_error;
+	sint32_t s32_output;
+	sint32_t s32_integral;
+	sint8_t s8_output;
+
+	if (ptr_str_wheel->s8_setpoint == U8_ZERO_VALUE)
+	{
+		// Stop request: let the motor ramp bring the wheel down
+		ptr_str_wheel->s32_integral = U8_ZERO_VALUE;
+		s8_output = U8_ZERO_VALUE;
+	}
+	else
+	{
+		if (ptr_str_wheel->s8_setpoint < 0)
+		{
+			s32_setpoint = -s32_setpoint;
+		}
+		if (s32_setpoint < 0)
+		{
+			s32_setpoint = U8_ZERO_VALUE;
+		}
+		s32_error = s32_setpoint - s32_speed;
+
+		s32_output = ((CAR_PID_KFF * s32_setpoint) + (CAR_PID_KP * s32_error)
+					  - (CAR_PID_KD * (s32_speed - ptr_str_wheel->s32_last_speed))) / CAR_Q8_ONE;
+
+		s32_integral = ptr_str_wheel->s32_integral + ((CAR_PID_KI * s32_error) / CAR_Q8_ONE);
+		if (s32_integral > CAR_SPEED_MAX_Q8)
+		{
+			s32_integral = CAR_SPEED_MAX_Q8;
+		}
+		else if (s32_integral < -CAR_SPEED_MAX_Q8)
+		{
+			s32_integral = -CAR_SPEED_MAX_Q8;
+		}
+		else
+		{
+			// Integral in range
+		}
+
+		if ((s8_applied != ptr_str_wheel->s8_output)
+			|| (((s32_output + s32_integral) > CAR_SPEED_MAX_Q8) && (s32_error > 0))
+			|| (((s32_output + s32_integral) < 0) && (s32_error < 0)))
+		{
+			// Anti-windup: the actuator can't follow, keep the integral
+			s32_integral = ptr_str_wheel->s32_integral;
+		}
+		ptr_str_wheel->s32_integral = s32_integral;
+		s32_output += s32_integral;
+
+		if (s32_output > CAR_SPEED_MAX_Q8)
+		{
+			s32_output = CAR_SPEED_MAX_Q8;
+		}
+		else if (s32_output < 0)
+		{
+			s32_output = U8_ZERO_VALUE;
+		}
+		else
+		{
+			// Output in range
+		}
+		s8_output = (sint8_t)(s32_output / CAR_Q8_ONE);
+		if (ptr_str_wheel->s8_setpoint < 0)
+		{
+			s8_output = -s8_output;
+		}
+	}
+	ptr_str_wheel->s32_last_speed = s32_speed;
+	return s8_output;
+}
+
+
+/**
+ * @brief Give new setpoints to the wheel speed control and engage it.
+ *
+ * @param s8_left Left wheel speed in percent.
+ * @param s8_right Right wheel speed in percent.
+ */
+static void CAR_command_wheels(sint8_t s8_left, sint8_t s8_right)
+{
+	sint8_t as8_setpoint[CAR_WHEEL_NUM] = {s8_left, s8_right};
+	uint8_t u8_sreg;
+
+	// Setpoints and state are read by the timer tick, change them together
+	ISR_ENTER_CRITICAL(u8_sreg);
+	gs_str_car.u8_released = FALSE;
+	for(uint8_t u8_wheel = U8_ZERO_VALUE ; u8_wheel < CAR_WHEEL_NUM ; u8_wheel++)
+	{
+		if((gv_u8_speed_ctrl_state != CAR_SPEED_CTRL_ACTIVE) || (gv_str_wheel[u8_wheel].s8_setpoint == U8_ZERO_VALUE)
+			|| ((gv_str_wheel[u8_wheel].s8_setpoint < 0) != (as8_setpoint[u8_wheel] < 0)))
+		{
+			// Engaging or reversing: the integral of the old motion doesn't apply
+			gv_str_wheel[u8_wheel].s32_integral = U8_ZERO_VALUE;
+		}
+		gv_str_wheel[u8_wheel].s8_setpoint = as8_setpoint[u8_wheel];
+	}
+	gv_u8_speed_ctrl_state = CAR_SPEED_CTRL_ACTIVE;
+	ISR_EXIT_CRITICAL(u8_sreg);
+}
+
+
+/**
+ * @brief Run one period of a CAR_rotate_deg() turn.
+ *
+ * The angle turned since the last period comes from the odometry heading. The wheels pivot at
+ * CAR_TURN_SPEED_MAX, slow down linearly to CAR_TURN_SPEED_MIN over the last CAR_TURN_SLOW_DOWN_DEG,
+ * and are braked once the remaining angle is within CAR_TURN_TOLERANCE_DEG (or overshot).
+ */
+static void CAR_turn_step(void)
+{
+	uint16_t u16_heading = ODOMETRY_get_heading();
+	sint32_t s32_left_angle;
+	sint8_t s8_speed = CAR_TURN_SPEED_MAX;
+
+	// Heading difference of one period is far below half a turn, the signed 16-bit difference is exact
+	gv_s32_turn_remaining -= (sint16_t)(u16_heading - gv_u16_turn_heading);
+	gv_u16_turn_heading = u16_heading;
+	s32_left_angle = (gv_s8_turn_dir < 0) ? -gv_s32_turn_remaining : gv_s32_turn_remaining;
+
+	if(s32_left_angle <= CAR_DEG_TO_ANGLE(CAR_TURN_TOLERANCE_DEG))
+	{
+		// On target: brake now, a coasting pivot would overshoot
+		gv_u8_turn_state = CAR_TURN_IDLE;
+		gv_u8_speed_ctrl_state = CAR_SPEED_CTRL_IDLE;
+		MOTOR_BRAKE(gs_str_car.ptr_str_motor_left);
+		MOTOR_BRAKE(gs_str_car.ptr_str_motor_right);
+	}
+	else
+	{
+		if(s32_left_angle < CAR_DEG_TO_ANGLE(CAR_TURN_SLOW_DOWN_DEG))
+		{
+			s8_speed = (sint8_t)(CAR_TURN_SPEED_MIN + (((sint32_t)(CAR_TURN_SPEED_MAX - CAR_TURN_SPEED_MIN) * s32_left_angle)
+													   / CAR_DEG_TO_ANGLE(CAR_TURN_SLOW_DOWN_DEG)));
+		}
+		// Positive turns are counterclockwise: left wheel backward, right wheel forward
+		CAR_command_wheels((sint8_t)(-s8_speed * gv_s8_turn_dir),(sint8_t)(s8_speed * gv_s8_turn_dir));
+	}
+}
+
+
+/**
+ * @brief Run one period of the heading hold.
+ *
+ * While both wheels have the same non zero setpoint, the right minus left edge count since the setpoint was
+ * given is the heading error: every edge of difference moves both setpoints by CAR_HEADING_HOLD_GAIN in
+ * opposite directions, limited to CAR_HEADING_HOLD_MAX_TRIM. Integer adds and one multiply per period.
+ *
+ * @param s16_left_edges Signed left wheel edges of the period.
+ * @param s16_right_edges Signed right wheel edges of the period.
+ */
+static void CAR_heading_hold_step(sint16_t s16_left_edges, sint16_t s16_right_edges)
+{
+	sint8_t s8_setpoint = gv_str_wheel[CAR_WHEEL_LEFT].s8_setpoint;
+	sint16_t s16_error;
+	sint16_t s16_trim = U8_ZERO_VALUE;
+
+	if ((gv_u8_hold_enabled == FALSE) || (gv_u8_speed_ctrl_state != CAR_SPEED_CTRL_ACTIVE) || (gv_u8_turn_state != CAR_TURN_IDLE)
+		|| (s8_setpoint == 0) || (s8_setpoint != gv_str_wheel[CAR_WHEEL_RIGHT].s8_setpoint))
+	{
+		// Not driving straight
+		gv_s8_hold_setpoint = U8_ZERO_VALUE;
+		gv_s16_hold_error = U8_ZERO_VALUE;
+	}
+	else
+	{
+		if (s8_setpoint != gv_s8_hold_setpoint)
+		{
+			// New straight line: hold the heading it starts with
+			gv_s8_hold_setpoint = s8_setpoint;
+			gv_s16_hold_error = U8_ZERO_VALUE;
+		}
+		else
+		{
+			// Limit the error to the trim range, a held wheel doesn't wind the error up
+			s16_error = gv_s16_hold_error + (s16_right_edges - s16_left_edges);
+			if (s16_error > CAR_HEADING_HOLD_MAX_EDGES)
+			{
+				s16_error = CAR_HEADING_HOLD_MAX_EDGES;
+			}
+			else if (s16_error < -CAR_HEADING_HOLD_MAX_EDGES)
+			{
+				s16_error = -CAR_HEADING_HOLD_MAX_EDGES;
+			}
+			else
+			{
+				// Error in range
+			}
+			gv_s16_hold_error = s16_error;
+		}
+		s16_trim = (sint16_t)(gv_s16_hold_error * CAR_HEADING_HOLD_GAIN);
+	}
+	// Right wheel ahead: speed the left wheel up and slow the right wheel down (backward alike with signed edges)
+	gv_str_wheel[CAR_WHEEL_LEFT].s16_trim = s16_trim;
+	gv_str_wheel[CAR_WHEEL_RIGHT].s16_trim = -s16_trim;
+}
 
 
 car_enu_return_state_t CAR_INIT(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2)
@@ -28,6 +515,9 @@ car_enu_return_state_t CAR_INIT(const motor_str_config_t *ptr_str_motor_1,const
 			enu_return_state=CAR_NOK;
 		}else{
 			// Car initialization successful with both motors initialized.
+			gs_str_car.ptr_str_motor_left = ptr_str_motor_1;
+			gs_str_car.ptr_str_motor_right = ptr_str_motor_2;
+			CAR_build_primitives();
 		}
 	}
 	else
@@ -46,6 +536,7 @@ car_enu_return_state_t CAR_FORWARD(const motor_str_config_t *ptr_str_motor_1,con
 	
 	if((ptr_str_motor_1 !=NULL) && (ptr_str_motor_2 != NULL))
 	{
+		CAR_open_loop();
 		enu_motor_error_1 = MOTOR_FORWARD(ptr_str_motor_1);
 		enu_motor_error_2 = MOTOR_FORWARD(ptr_str_motor_2);
 		if((enu_motor_error_1 != MOTOR_OK) || (enu_motor_error_2 != MOTOR_OK)){
@@ -62,6 +553,32 @@ car_enu_return_state_t CAR_FORWARD(const motor_str_config_t *ptr_str_motor_1,con
 }
 
 
+car_enu_return_state_t CAR_SET_VELOCITY(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2,
+										sint8_t copy_s8_velocity_1,sint8_t copy_s8_velocity_2)
+{
+	car_enu_return_state_t enu_return_state=CAR_OK;
+	motor_enu_return_state_t enu_motor_error_1;
+	motor_enu_return_state_t enu_motor_error_2;
+	
+	if((ptr_str_motor_1 !=NULL) && (ptr_str_motor_2 != NULL))
+	{
+		CAR_open_loop();
+		enu_motor_error_1 = MOTOR_set_velocity(ptr_str_motor_1,copy_s8_velocity_1);
+		enu_motor_error_2 = MOTOR_set_velocity(ptr_str_motor_2,copy_s8_velocity_2);
+		if((enu_motor_error_1 != MOTOR_OK) || (enu_motor_error_2 != MOTOR_OK)){
+			enu_return_state=CAR_NOK;
+		}else{
+			// Both motors run with their new velocities.
+		}
+	}
+	else
+	{
+		enu_return_state=CAR_NULL_PTR;
+	}
+	return enu_return_state;
+}
+
+
 car_enu_return_state_t CAR_REVERSE_RIGHT(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2)
 {
 	car_enu_return_state_t enu_return_state=CAR_OK;
@@ -69,6 +586,7 @@ car_enu_return_state_t CAR_REVERSE_RIGHT(const motor_str_config_t *ptr_str_motor
 	motor_enu_return_state_t enu_motor_error_2;
 	if((ptr_str_motor_1 !=NULL) && (ptr_str_motor_2 != NULL))
 	{
+		CAR_open_loop();
 		enu_motor_error_1 = MOTOR_FORWARD(ptr_str_motor_1);
 		enu_motor_error_2 = MOTOR_BACKWARD(ptr_str_motor_2);
 		if((enu_motor_error_1 != MOTOR_OK) || (enu_motor_error_2 != MOTOR_OK)){
@@ -93,6 +611,7 @@ car_enu_return_state_t CAR_STOP(const motor_str_config_t *ptr_str_motor_1,const
 	motor_enu_return_state_t enu_motor_error_2;
 	if((ptr_str_motor_1 !=NULL) && (ptr_str_motor_2 != NULL))
 	{
+		CAR_open_loop();
 		enu_motor_error_1 = MOTOR_STOP(ptr_str_motor_1);
 		enu_motor_error_2 = MOTOR_STOP(ptr_str_motor_2);
 		if((enu_motor_error_1 != MOTOR_OK) || (enu_motor_error_2 != MOTOR_OK)){
@@ -107,4 +626,352 @@ car_enu_return_state_t CAR_STOP(const motor_str_config_t *ptr_str_motor_1,const
 		enu_return_state=CAR_NULL_PTR;
 	}
 	return enu_return_state;
-}
\ No newline at end of file
+}
+
+
+car_enu_return_state_t CAR_BRAKE(const motor_str_config_t *ptr_str_motor_1,const motor_str_config_t *ptr_str_motor_2)
+{
+	car_enu_return_state_t enu_return_state=CAR_OK;
+	motor_enu_return_state_t enu_motor_error_1;
+	motor_enu_return_state_t enu_motor_error_2;
+	if((ptr_str_motor_1 !=NULL) && (ptr_str_motor_2 != NULL))
+	{
+		CAR_open_loop();
+		enu_motor_error_1 = MOTOR_BRAKE(ptr_str_motor_1);
+		enu_motor_error_2 = MOTOR_BRAKE(ptr_str_motor_2);
+		if((enu_motor_error_1 != MOTOR_OK) || (enu_motor_error_2 != MOTOR_OK)){
+			enu_return_state=CAR_NOK;
+			}else{
+			// Car braking with both motors shorted.
+
+		}
+	}
+	else
+	{
+		enu_return_state=CAR_NULL_PTR;
+	}
+	return enu_return_state;
+}
+
+
+car_enu_return_state_t CAR_set_twist(sint8_t copy_s8_linear, sint8_t copy_s8_angular)
+{
+	car_enu_return_state_t enu_return_state=CAR_OK;
+	sint16_t s16_left = (sint16_t)copy_s8_linear - copy_s8_angular;
+	sint16_t s16_right = (sint16_t)copy_s8_linear + copy_s8_angular;
+	sint16_t s16_abs_left = (s16_left < 0) ? -s16_left : s16_left;
+	sint16_t s16_abs_right = (s16_right < 0) ? -s16_right : s16_right;
+	sint16_t s16_peak = (s16_abs_left > s16_abs_right) ? s16_abs_left : s16_abs_right;
+	
+	if((gs_str_car.ptr_str_motor_left == NULL) || (gs_str_car.ptr_str_motor_right == NULL))
+	{
+		enu_return_state=CAR_NOK;
+	}
+	else
+	{
+		// Saturate by scaling both wheels with the same ratio, keeps the curvature (|wheel| <= 200 so no overflow)
+		if(s16_peak > CAR_WHEEL_MAX_PERCENT)
+		{
+			s16_left = (sint16_t)((s16_left * CAR_WHEEL_MAX_PERCENT) / s16_peak);
+			s16_right = (sint16_t)((s16_right * CAR_WHEEL_MAX_PERCENT) / s16_peak);
+		}
+		if (gv_u8_speed_ctrl_state == CAR_SPEED_CTRL_OFF)
+		{
+			enu_return_state = CAR_SET_VELOCITY(gs_str_car.ptr_str_motor_left,gs_str_car.ptr_str_motor_right,(sint8_t)s16_left,(sint8_t)s16_right);
+		}
+		else
+		{
+			// The speed control drives the wheels from the next period
+			CAR_set_wheel_speed((sint8_t)s16_left,(sint8_t)s16_right);
+		}
+	}
+	return enu_return_state;
+}
+
+
+/**
+ * @brief Coast the wheels a primitive reverses for the motor dead time.
+ *
+ * A wheel reverses when the primitive drives it against the level it was last driven with, or drives it
+ * while it may still be driven by the ramp. A braked wheel is stopped and may be driven either way at once.
+ * The wait runs on Timer 1, the interrupts go on.
+ *
+ * @param enu_primitive The primitive about to be written.
+ */
+static void CAR_reverse_dead_time(car_enu_primitive_t enu_primitive)
+{
+	const motor_str_config_t *apstr_motor[CAR_WHEEL_NUM] = {gs_str_car.ptr_str_motor_left, gs_str_car.ptr_str_motor_right};
+	uint8_t u8_reverse = FALSE;
+	uint8_t u8_level;
+	uint16_t u16_start;
+
+	for(uint8_t u8_wheel = U8_ZERO_VALUE ; u8_wheel < CAR_WHEEL_NUM ; u8_wheel++)
+	{
+		u8_level = gc_u8_primitive_levels[enu_primitive][u8_wheel];
+		if(((u8_level == CAR_MOTOR_FORWARD) || (u8_level == CAR_MOTOR_BACKWARD))
+			&& (gs_str_car.au8_drive_level[u8_wheel] != CAR_MOTOR_COAST) && (gs_str_car.au8_drive_level[u8_wheel] != u8_level))
+		{
+			DIO_write_port(apstr_motor[u8_wheel]->port,
+						   (uint8_t)((U8_ONE_VALUE << apstr_motor[u8_wheel]->pin_num1) | (U8_ONE_VALUE << apstr_motor[u8_wheel]->pin_num2)),
+						   U8_ZERO_VALUE);
+			u8_reverse = TRUE;
+		}
+
+		// A coasting wheel may still turn the way it was driven
+		if(u8_level == CAR_MOTOR_BRAKE)
+		{
+			gs_str_car.au8_drive_level[u8_wheel] = CAR_MOTOR_COAST;
+		}
+		else if(u8_level != CAR_MOTOR_COAST)
+		{
+			gs_str_car.au8_drive_level[u8_wheel] = u8_level;
+		}
+		else
+		{
+			// Keeps the level it was driven with
+		}
+	}
+
+	if(u8_reverse == TRUE)
+	{
+		u16_start = TIMER_MANGER_getCycles();
+		while((uint16_t)(TIMER_MANGER_getCycles() - u16_start) < CAR_DEAD_TIME_CYCLES)
+		{
+			// Let the motor current decay before the H-bridge reverses
+		}
+	}
+}
+
+
+car_enu_return_state_t CAR_apply(car_enu_primitive_t copy_enu_primitive)
+{
+	car_enu_return_state_t enu_return_state=CAR_OK;
+	
+	if((gs_str_car.u8_port_writes == U8_ZERO_VALUE) || (copy_enu_primitive >= CAR_PRIMITIVE_MAX))
+	{
+		enu_return_state=CAR_NOK;
+	}
+	else if(((MOTOR_get_fault_mask() & gs_str_car.u8_fault_mask) != U8_ZERO_VALUE)
+			&& (copy_enu_primitive != CAR_PRIMITIVE_BRAKE) && (copy_enu_primitive != CAR_PRIMITIVE_COAST))
+	{
+		// Never drive a motor cut by the overcurrent guard
+		enu_return_state=CAR_NOK;
+	}
+	else
+	{
+		// Take the motors from the PWM and ramp once, then every primitive is a single masked port write
+		if(gs_str_car.u8_released == FALSE)
+		{
+			CAR_open_loop();
+			MOTOR_release(gs_str_car.ptr_str_motor_left);
+			MOTOR_release(gs_str_car.ptr_str_motor_right);
+			gs_str_car.u8_released = TRUE;
+			gs_str_car.au8_drive_level[CAR_WHEEL_LEFT] = CAR_MOTOR_UNKNOWN;
+			gs_str_car.au8_drive_level[CAR_WHEEL_RIGHT] = CAR_MOTOR_UNKNOWN;
+		}
+		CAR_reverse_dead_time(copy_enu_primitive);
+		// Record the wheel directions for the odometry, brake and coast keep the direction of the rolling wheel
+		for(uint8_t u8_wheel = U8_ZERO_VALUE ; u8_wheel < CAR_WHEEL_NUM ; u8_wheel++)
+		{
+			if(gc_u8_primitive_levels[copy_enu_primitive][u8_wheel] == CAR_MOTOR_FORWARD)
+			{
+				gv_str_wheel[u8_wheel].s8_direction = 1;
+			}
+			else if(gc_u8_primitive_levels[copy_enu_primitive][u8_wheel] == CAR_MOTOR_BACKWARD)
+			{
+				gv_str_wheel[u8_wheel].s8_direction = -1;
+			}
+			else
+			{
+				// Wheel not driven
+			}
+		}
+		for(uint8_t u8_index = U8_ZERO_VALUE ; u8_index < gs_str_car.u8_port_writes ; u8_index++)
+		{
+			DIO_write_port(gs_str_car.astr_port_write[u8_index].enu_port,gs_str_car.astr_port_write[u8_index].u8_mask,
+						   gs_str_car.astr_port_write[u8_index].au8_value[copy_enu_primitive]);
+		}
+	}
+	return enu_return_state;
+}
+
+
+car_enu_return_state_t CAR_speed_control_init(const encoder_str_config_t *ptr_str_encoder_left,const encoder_str_config_t *ptr_str_encoder_right)
+{
+	car_enu_return_state_t enu_return_state=CAR_OK;
+	const encoder_str_config_t *apstr_encoder[CAR_WHEEL_NUM] = {ptr_str_encoder_left, ptr_str_encoder_right};
+	uint16_t u16_count;
+	uint16_t u16_time;
+	
+	if((ptr_str_encoder_left == NULL) || (ptr_str_encoder_right == NULL))
+	{
+		enu_return_state=CAR_NULL_PTR;
+	}
+	else if((gs_str_car.ptr_str_motor_left == NULL)
+			|| (ENCODER_init(ptr_str_encoder_left) != ENCODER_OK) || (ENCODER_init(ptr_str_encoder_right) != ENCODER_OK))
+	{
+		enu_return_state=CAR_NOK;
+	}
+	else
+	{
+		gv_u8_speed_ctrl_state = CAR_SPEED_CTRL_OFF;
+		for(uint8_t u8_wheel = U8_ZERO_VALUE ; u8_wheel < CAR_WHEEL_NUM ; u8_wheel++)
+		{
+			ENCODER_get_edge(apstr_encoder[u8_wheel],&u16_count,&u16_time);
+			gv_str_wheel[u8_wheel].ptr_str_encoder = apstr_encoder[u8_wheel];
+			gv_str_wheel[u8_wheel].u16_ref_count = u16_count;
+			gv_str_wheel[u8_wheel].u16_ref_time = u16_time;
+			gv_str_wheel[u8_wheel].u16_odo_count = u16_count;
+			gv_str_wheel[u8_wheel].s8_direction = U8_ZERO_VALUE;
+			gv_str_wheel[u8_wheel].s32_speed = U8_ZERO_VALUE;
+			gv_str_wheel[u8_wheel].s32_last_speed = U8_ZERO_VALUE;
+			gv_str_wheel[u8_wheel].s32_integral = U8_ZERO_VALUE;
+			gv_str_wheel[u8_wheel].s8_setpoint = U8_ZERO_VALUE;
+			gv_str_wheel[u8_wheel].s8_output = U8_ZERO_VALUE;
+			gv_str_wheel[u8_wheel].s16_trim = U8_ZERO_VALUE;
+		}
+		gv_u8_speed_ctrl_state = CAR_SPEED_CTRL_IDLE;
+	}
+	return enu_return_state;
+}
+
+
+car_enu_return_state_t CAR_set_wheel_speed(sint8_t copy_s8_left,sint8_t copy_s8_right)
+{
+	car_enu_return_state_t enu_return_state=CAR_OK;
+	
+	if(gv_u8_speed_ctrl_state == CAR_SPEED_CTRL_OFF)
+	{
+		enu_return_state=CAR_NOK;
+	}
+	else
+	{
+		// A new speed command takes over from a running turn
+		gv_u8_turn_state = CAR_TURN_IDLE;
+		CAR_command_wheels(copy_s8_left,copy_s8_right);
+	}
+	return enu_return_state;
+}
+
+
+car_enu_return_state_t CAR_rotate_deg(sint16_t copy_s16_angle)
+{
+	car_enu_return_state_t enu_return_state=CAR_OK;
+	uint8_t u8_sreg;
+	
+	if(gv_u8_speed_ctrl_state == CAR_SPEED_CTRL_OFF)
+	{
+		enu_return_state=CAR_NOK;
+	}
+	else if(copy_s16_angle == 0)
+	{
+		// Nothing to turn
+	}
+	else
+	{
+		// The control tick runs the turn from its next period
+		ISR_ENTER_CRITICAL(u8_sreg);
+		gv_s32_turn_remaining = CAR_DEG_TO_ANGLE(copy_s16_angle);
+		gv_s8_turn_dir = (copy_s16_angle < 0) ? -1 : 1;
+		gv_u16_turn_heading = ODOMETRY_get_heading();
+		gv_u8_turn_state = CAR_TURN_RUNNING;
+		ISR_EXIT_CRITICAL(u8_sreg);
+	}
+	return enu_return_state;
+}
+
+
+void CAR_set_heading_hold(uint8_t copy_u8_enable)
+{
+	gv_u8_hold_enabled = (copy_u8_enable == FALSE) ? FALSE : TRUE;
+}
+
+
+uint8_t CAR_is_turning(void)
+{
+	return (gv_u8_turn_state == CAR_TURN_RUNNING) ? TRUE : FALSE;
+}
+
+
+void CAR_speed_control_tick(void)
+{
+	const motor_str_config_t *apstr_motor[CAR_WHEEL_NUM] = {gs_str_car.ptr_str_motor_left, gs_str_car.ptr_str_motor_right};
+	uint16_t u16_start = U8_ZERO_VALUE;
+	uint16_t u16_end = U8_ZERO_VALUE;
+	uint16_t u16_now;
+	uint16_t u16_count;
+	sint16_t as16_edges[CAR_WHEEL_NUM];
+	sint8_t as8_applied[CAR_WHEEL_NUM];
+	
+	if(gv_u8_speed_ctrl_state != CAR_SPEED_CTRL_OFF)
+	{
+		// Timer 1 runs at F_CPU: its counter times the controller in CPU cycles
+		TIMER_MANGER_getValue(TIMER_1,&u16_start);
+		
+		// Keep measuring while idle so the speed is current when the loop engages and the pose follows every command
+		u16_now = ENCODER_get_time();
+		for(uint8_t u8_wheel = U8_ZERO_VALUE ; u8_wheel < CAR_WHEEL_NUM ; u8_wheel++)
+		{
+			u16_count = CAR_measure_speed(&gv_str_wheel[u8_wheel],u16_now);
+			
+			// Single channel encoders: the edges go the way the motor was last driven, also while it coasts down
+			as8_applied[u8_wheel] = U8_ZERO_VALUE;
+			MOTOR_get_velocity(apstr_motor[u8_wheel],&as8_applied[u8_wheel]);
+			if(as8_applied[u8_wheel] != 0)
+			{
+				gv_str_wheel[u8_wheel].s8_direction = (as8_applied[u8_wheel] < 0) ? -1 : 1;
+			}
+			as16_edges[u8_wheel] = (sint16_t)(u16_count - gv_str_wheel[u8_wheel].u16_odo_count);
+			if(gv_str_wheel[u8_wheel].s8_direction < 0)
+			{
+				as16_edges[u8_wheel] = -as16_edges[u8_wheel];
+			}
+			else if(gv_str_wheel[u8_wheel].s8_direction == 0)
+			{
+				// Never driven, the wheel was moved by hand
+				as16_edges[u8_wheel] = U8_ZERO_VALUE;
+			}
+			else
+			{
+				// Forward
+			}
+			gv_str_wheel[u8_wheel].u16_odo_count = u16_count;
+		}
+		ODOMETRY_update(as16_edges[CAR_WHEEL_LEFT],as16_edges[CAR_WHEEL_RIGHT]);
+		
+		// A running turn sets the wheel setpoints of this period
+		if(gv_u8_turn_state == CAR_TURN_RUNNING)
+		{
+			CAR_turn_step();
+		}
+		CAR_heading_hold_step(as16_edges[CAR_WHEEL_LEFT],as16_edges[CAR_WHEEL_RIGHT]);
+		
+		if(gv_u8_speed_ctrl_state == CAR_SPEED_CTRL_ACTIVE)
+		{
+			for(uint8_t u8_wheel = U8_ZERO_VALUE ; u8_wheel < CAR_WHEEL_NUM ; u8_wheel++)
+			{
+				gv_str_wheel[u8_wheel].s8_output = CAR_pid_step(&gv_str_wheel[u8_wheel],as8_applied[u8_wheel]);
+				MOTOR_set_velocity(apstr_motor[u8_wheel],gv_str_wheel[u8_wheel].s8_output);
+			}
+		}
+		
+		TIMER_MANGER_getValue(TIMER_1,&u16_end);
+		u16_end -= u16_start;
+		if(u16_end > gv_u16_speed_ctrl_cycles_max)
+		{
+			gv_u16_speed_ctrl_cycles_max = u16_end;
+		}
+	}
+}
+
+
+uint16_t CAR_get_speed_control_cycles(void)
+{
+	uint16_t u16_cycles;
+	uint8_t u8_sreg;
+	
+	ISR_ENTER_CRITICAL(u8_sreg);
+	u16_cycles = gv_u16_speed_ctrl_cycles_max;
+	ISR_EXIT_CRITICAL(u8_sreg);
+	return u16_cycles;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file COMMAND_interface.h
+ * @brief Command Interface Header File
+ *
+ * This header file defines the interface of the host command interface: the host reads and changes the registered
+ * runtime parameters over the telemetry link, without reflashing the car.
+ *
+ * The parameters are a const table given by the application, each entry is a value or an array of values
+ * (1 or 2 bytes, signed or not) with its valid range. The commands are telemetry frames (payloads little endian):
+ *  - #TELEMETRY_FRAME_GET:  | parameter | index |
+ *  - #TELEMETRY_FRAME_SET:  | parameter | index | value (4, signed) |
+ *  - #TELEMETRY_FRAME_SAVE: empty
+ *  - #TELEMETRY_FRAME_TELEOP: | linear velocity (signed) | angular velocity (signed) |, not replied
+ *
+ * Every other command is answered by a #TELEMETRY_FRAME_REPLY frame:
+ *  | command type | command sequence (2) | status | parameter | index | value (4, signed) |
+ *
+ * The frames are parsed in COMMAND_task(), never in the interrupt. A task runs to completion, so a value
+ * is changed between two runs of the control task and never seen half written.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef COMMAND_INTERFACE_H_
+#define COMMAND_INTERFACE_H_
+
+#include "../TELEMETRY/TELEMETRY_interface.h"
+#include "../../STD_LIB/bit_math.h"
+#include "../../STD_LIB/std_types.h"
+
+
+/** @brief Most command frames handled by one run of COMMAND_task(), the rest wait for the next run */
+#define COMMAND_MAX_FRAMES_PER_RUN	4
+
+/** @brief Size of the payload of a teleoperation setpoint */
+#define COMMAND_TELEOP_SIZE			2
+
+/**
+ * @brief A registered runtime parameter.
+ */
+typedef struct {
+    void *ptr_value;					/**< Pointer to the value, or to the first value of an array. */
+    uint8_t u8_size;					/**< Size of a value in bytes (1 or 2). */
+    uint8_t u8_signed;					/**< TRUE for a signed value. */
+    uint8_t u8_count;					/**< Number of values, 1 for a single value. */
+    uint8_t u8_stride;					/**< Bytes from a value of the array to the next one. */
+    sint32_t s32_min;					/**< Smallest valid value. */
+    sint32_t s32_max;					/**< Largest valid value. */
+    void (*ptr_func_apply)(void);		/**< Called after the parameter was changed, NULL for none. */
+} cmd_str_param_t;
+
+/**
+ * @brief Enumeration of the statuses of a reply.
+ */
+typedef enum {
+    COMMAND_STATUS_OK = 0,			/**< Command done. */
+    COMMAND_STATUS_UNKNOWN_PARAM,	/**< No such parameter or index. */
+    COMMAND_STATUS_OUT_OF_RANGE,	/**< Value out of the range of the parameter, it was not changed. */
+    COMMAND_STATUS_BAD_LENGTH,		/**< Payload length does not fit the command. */
+    COMMAND_STATUS_BUSY,			/**< The parameters could not be saved yet, try again later. */
+    COMMAND_STATUS_UNKNOWN_COMMAND	/**< Frame type is not a command. */
+} cmd_enu_status_t;
+
+/**
+ * @brief Enumeration defining return states for command functions.
+ */
+typedef enum {
+    COMMAND_OK,		/**< Operation was successful. */
+    COMMAND_NOK		/**< Operation failed. */
+} cmd_enu_return_state_t;
+
+
+/**
+ * @brief Initialize the command interface with its parameter table.
+ *
+ * @param ptr_str_params Pointer to the parameter table, indexed by the parameter number of the commands.
+ * @param copy_u8_params_num Number of parameters in the table.
+ * @param ptr_func_save Function saving the parameters, returns FALSE when it has to be tried again later
+ *                      (NULL if they can't be saved).
+ * @return The return state of the initialization.
+ *     - #COMMAND_OK: Initialization successful.
+ *     - #COMMAND_NOK: NULL pointer.
+ */
+cmd_enu_return_state_t COMMAND_init(const cmd_str_param_t *ptr_str_params, uint8_t copy_u8_params_num, uint8_t (*ptr_func_save)(void));
+
+/**
+ * @brief Set the function receiving the teleoperation setpoints.
+ *
+ * The setpoints are streamed by the host, they are passed on as they come without a reply.
+ *
+ * @param ptr_func_teleop Function called with the linear and angular velocity of each setpoint, NULL to ignore them.
+ */
+void COMMAND_set_teleop_handler(void (*ptr_func_teleop)(sint8_t copy_s8_linear, sint8_t copy_s8_angular));
+
+/**
+ * @brief Handle the received commands.
+ *
+ * Must be called periodically from the main loop. It handles up to #COMMAND_MAX_FRAMES_PER_RUN frames
+ * and replies to each of them, except the teleoperation setpoints.
+ */
+void COMMAND_task(void);
+
+/**
+ * @brief Read whether the host sent a frame since the last call.
+ *
+ * The telemetry link can't wake a powered down car up, the application stays awake while the host talks to it.
+ *
+ * @return TRUE if a frame (command or teleoperation setpoint) was received since the last call, FALSE otherwise.
+ */
+uint8_t COMMAND_get_activity(void);
+
+#endif /* COMMAND_INTERFACE_H_ */
@@ -0,0 +1,288 @@
+/**
+ * @file COMMAND_prog.c
+ * @brief Command Interface Implementation File
+ *
+ * This file implements the host command interface: it takes the command frames off the telemetry link,
+ * reads or changes the registered parameters and replies with their value.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "COMMAND_interface.h"
+#include "../../MCAL/AVR_ARCH/ISR_interface.h"
+
+/** @brief Size of the payload of a get command */
+#define COMMAND_GET_SIZE		2
+
+/** @brief Size of the payload of a set command */
+#define COMMAND_SET_SIZE		6
+
+/** @brief Size of the payload of a reply */
+#define COMMAND_REPLY_SIZE		10
+
+/***************************************************************************/
+/*******				Static function prototypes					*******/
+/***************************************************************************/
+
+static cmd_enu_status_t COMMAND_find(uint8_t u8_param, uint8_t u8_index, void **ptr_ptr_value);
+static sint32_t COMMAND_read(const cmd_str_param_t *ptr_str_param, const void *ptr_value);
+static void COMMAND_write(const cmd_str_param_t *ptr_str_param, void *ptr_value, sint32_t s32_value);
+static cmd_enu_status_t COMMAND_handle(uint8_t u8_type, const uint8_t *ptr_u8_payload, uint8_t u8_size, sint32_t *ptr_s32_value);
+static void COMMAND_reply(uint8_t u8_type, uint16_t u16_sequence, uint8_t *ptr_u8_payload, uint8_t u8_size);
+
+
+/** @brief Parameter table */
+static const cmd_str_param_t *gs_ptr_str_params = NULL;
+
+/** @brief Number of parameters in the table */
+static uint8_t gs_u8_params_num = U8_ZERO_VALUE;
+
+/** @brief Function saving the parameters */
+static uint8_t (*gs_ptr_func_save)(void) = NULL;
+
+/** @brief Function receiving the teleoperation setpoints */
+static void (*gs_ptr_func_teleop)(sint8_t copy_s8_linear, sint8_t copy_s8_angular) = NULL;
+
+/** @brief Set by every received frame, cleared when read */
+static uint8_t gs_u8_activity = FALSE;
+
+
+/**
+ * @brief Find a value of a parameter.
+ *
+ * @param u8_param Number of the parameter.
+ * @param u8_index Index of the value in the parameter array.
+ * @param ptr_ptr_value Pointer to store the address of the value.
+ * @return #COMMAND_STATUS_OK, or #COMMAND_STATUS_UNKNOWN_PARAM for no such parameter or index.
+ */
+static cmd_enu_status_t COMMAND_find(uint8_t u8_param, uint8_t u8_index, void **ptr_ptr_value)
+{
+	cmd_enu_status_t enu_status = COMMAND_STATUS_OK;
+
+	if ((u8_param >= gs_u8_params_num) || (u8_index >= gs_ptr_str_params[u8_param].u8_count))
+	{
+		enu_status = COMMAND_STATUS_UNKNOWN_PARAM;
+	}
+	else
+	{
+		*ptr_ptr_value = (uint8_t *)gs_ptr_str_params[u8_param].ptr_value + (uint16_t)u8_index * gs_ptr_str_params[u8_param].u8_stride;
+	}
+	return enu_status;
+}
+
+/**
+ * @brief Read a value of a parameter.
+ *
+ * @param ptr_str_param Pointer to the parameter.
+ * @param ptr_value Pointer to the value.
+ * @return The value, sign extended.
+ */
+static sint32_t COMMAND_read(const cmd_str_param_t *ptr_str_param, const void *ptr_value)
+{
+	sint32_t s32_value;
+	uint8_t u8_sreg;
+
+	ISR_ENTER_CRITICAL(u8_sreg);
+	if (ptr_str_param->u8_size == 1)
+	{
+		s32_value = (ptr_str_param->u8_signed == TRUE) ? *(const sint8_t *)ptr_value : *(const uint8_t *)ptr_value;
+	}
+	else
+	{
+		s32_value = (ptr_str_param->u8_signed == TRUE) ? *(const sint16_t *)ptr_value : *(const uint16_t *)ptr_value;
+	}
+	ISR_EXIT_CRITICAL(u8_sreg);
+	return s32_value;
+}
+
+/**
+ * @brief Write a value of a parameter.
+ *
+ * The 2 byte values are written with the interrupts off, the interrupts never see them half written either.
+ *
+ * @param ptr_str_param Pointer to the parameter.
+ * @param ptr_value Pointer to the value.
+ * @param s32_value The new value, within the range of the parameter.
+ */
+static void COMMAND_write(const cmd_str_param_t *ptr_str_param, void *ptr_value, sint32_t s32_value)
+{
+	uint8_t u8_sreg;
+
+	ISR_ENTER_CRITICAL(u8_sreg);
+	if (ptr_str_param->u8_size == 1)
+	{
+		*(uint8_t *)ptr_value = (uint8_t)s32_value;
+	}
+	else
+	{
+		*(uint16_t *)ptr_value = (uint16_t)s32_value;
+	}
+	ISR_EXIT_CRITICAL(u8_sreg);
+}
+
+/**
+ * @brief Handle a command frame.
+ *
+ * @param u8_type Frame type.
+ * @param ptr_u8_payload Pointer to the payload.
+ * @param u8_size Size of the payload.
+ * @param ptr_s32_value Pointer to store the value of the parameter to reply with.
+ * @return Status of the reply.
+ */
+static cmd_enu_status_t COMMAND_handle(uint8_t u8_type, const uint8_t *ptr_u8_payload, uint8_t u8_size, sint32_t *ptr_s32_value)
+{
+	cmd_enu_status_t enu_status = COMMAND_STATUS_OK;
+	const cmd_str_param_t *ptr_str_param;
+	void *ptr_value = NULL;
+	sint32_t s32_value;
+
+	if (u8_type == TELEMETRY_FRAME_SAVE)
+	{
+		if (u8_size != U8_ZERO_VALUE)
+		{
+			enu_status = COMMAND_STATUS_BAD_LENGTH;
+		}
+		else if ((gs_ptr_func_save == NULL) || (gs_ptr_func_save() == FALSE))
+		{
+			enu_status = COMMAND_STATUS_BUSY;
+		}
+		else
+		{
+			// Saving in the background
+		}
+	}
+	else if ((u8_type != TELEMETRY_FRAME_GET) && (u8_type != TELEMETRY_FRAME_SET))
+	{
+		enu_status = COMMAND_STATUS_UNKNOWN_COMMAND;
+	}
+	else if (u8_size != ((u8_type == TELEMETRY_FRAME_GET) ? COMMAND_GET_SIZE : COMMAND_SET_SIZE))
+	{
+		enu_status = COMMAND_STATUS_BAD_LENGTH;
+	}
+	else if (COMMAND_find(ptr_u8_payload[0], ptr_u8_payload[1], &ptr_value) != COMMAND_STATUS_OK)
+	{
+		enu_status = COMMAND_STATUS_UNKNOWN_PARAM;
+	}
+	else
+	{
+		// The host index is only used once COMMAND_find accepted it
+		ptr_str_param = gs_ptr_str_params + ptr_u8_payload[0];
+		if (u8_type == TELEMETRY_FRAME_SET)
+		{
+			s32_value = (sint32_t)((uint32_t)ptr_u8_payload[2] | ((uint32_t)ptr_u8_payload[3] << 8) |
+								   ((uint32_t)ptr_u8_payload[4] << 16) | ((uint32_t)ptr_u8_payload[5] << 24));
+			if ((s32_value < ptr_str_param->s32_min) || (s32_value > ptr_str_param->s32_max))
+			{
+				enu_status = COMMAND_STATUS_OUT_OF_RANGE;
+			}
+			else
+			{
+				COMMAND_write(ptr_str_param, ptr_value, s32_value);
+				if (ptr_str_param->ptr_func_apply != NULL)
+				{
+					ptr_str_param->ptr_func_apply();
+				}
+			}
+		}
+		else
+		{
+			// Get: reply with the current value
+		}
+		*ptr_s32_value = COMMAND_read(ptr_str_param, ptr_value);
+	}
+	return enu_status;
+}
+
+/**
+ * @brief Handle a command frame and reply to it.
+ *
+ * @param u8_type Frame type.
+ * @param u16_sequence Sequence number of the frame, echoed by the reply.
+ * @param ptr_u8_payload Pointer to the payload, #TELEMETRY_MAX_PAYLOAD bytes.
+ * @param u8_size Size of the payload.
+ */
+static void COMMAND_reply(uint8_t u8_type, uint16_t u16_sequence, uint8_t *ptr_u8_payload, uint8_t u8_size)
+{
+	uint8_t au8_reply[COMMAND_REPLY_SIZE];
+	sint32_t s32_value = 0;
+
+	if (u8_size < COMMAND_GET_SIZE)
+	{
+		// Save and short frames have no parameter: reply with zeros
+		ptr_u8_payload[0] = U8_ZERO_VALUE;
+		ptr_u8_payload[1] = U8_ZERO_VALUE;
+	}
+
+	au8_reply[0] = u8_type;
+	au8_reply[1] = (uint8_t)u16_sequence;
+	au8_reply[2] = (uint8_t)(u16_sequence >> 8);
+	au8_reply[3] = (uint8_t)COMMAND_handle(u8_type, ptr_u8_payload, u8_size, &s32_value);
+	au8_reply[4] = ptr_u8_payload[0];
+	au8_reply[5] = ptr_u8_payload[1];
+	au8_reply[6] = (uint8_t)s32_value;
+	au8_reply[7] = (uint8_t)((uint32_t)s32_value >> 8);
+	au8_reply[8] = (uint8_t)((uint32_t)s32_value >> 16);
+	au8_reply[9] = (uint8_t)((uint32_t)s32_value >> 24);
+
+	// A reply the link has no room for is lost, the host asks again
+	TELEMETRY_send(TELEMETRY_FRAME_REPLY, au8_reply, COMMAND_REPLY_SIZE);
+}
+
+cmd_enu_return_state_t COMMAND_init(const cmd_str_param_t *ptr_str_params, uint8_t copy_u8_params_num, uint8_t (*ptr_func_save)(void))
+{
+	cmd_enu_return_state_t enu_return_state = COMMAND_OK;
+
+	if (ptr_str_params == NULL)
+	{
+		enu_return_state = COMMAND_NOK;
+	}
+	else
+	{
+		gs_ptr_str_params = ptr_str_params;
+		gs_u8_params_num = copy_u8_params_num;
+		gs_ptr_func_save = ptr_func_save;
+	}
+	return enu_return_state;
+}
+
+void COMMAND_set_teleop_handler(void (*ptr_func_teleop)(sint8_t copy_s8_linear, sint8_t copy_s8_angular))
+{
+	gs_ptr_func_teleop = ptr_func_teleop;
+}
+
+void COMMAND_task(void)
+{
+	uint8_t au8_payload[TELEMETRY_MAX_PAYLOAD];
+	uint8_t u8_frames = U8_ZERO_VALUE;
+	uint8_t u8_type = U8_ZERO_VALUE;
+	uint8_t u8_size = U8_ZERO_VALUE;
+	uint16_t u16_sequence = U8_ZERO_VALUE;
+
+	while ((u8_frames < COMMAND_MAX_FRAMES_PER_RUN) &&
+		   (TELEMETRY_receive(&u8_type, &u16_sequence, au8_payload, &u8_size) == TELEMETRY_OK))
+	{
+		u8_frames++;
+		gs_u8_activity = TRUE;
+		if (u8_type == TELEMETRY_FRAME_TELEOP)
+		{
+			// Streamed at a high rate: no reply, the status frames show the car following
+			if ((u8_size == COMMAND_TELEOP_SIZE) && (gs_ptr_func_teleop != NULL))
+			{
+				gs_ptr_func_teleop((sint8_t)au8_payload[0], (sint8_t)au8_payload[1]);
+			}
+		}
+		else
+		{
+			COMMAND_reply(u8_type, u16_sequence, au8_payload, u8_size);
+		}
+	}
+}
+
+uint8_t COMMAND_get_activity(void)
+{
+	uint8_t u8_activity = gs_u8_activity;
+
+	gs_u8_activity = FALSE;
+	return u8_activity;
+}
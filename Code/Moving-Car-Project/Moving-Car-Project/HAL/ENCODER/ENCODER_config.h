@@ -0,0 +1,33 @@
+/**
+ * @file ENCODER_config.h
+ * @brief Wheel Encoder Configuration Header File
+ *
+ * This header file defines configuration parameters for the wheel encoders.
+ * Every wheel carries a slotted disk read by a single channel optical sensor, both edges are counted.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef ENCODER_CONFIG_H_
+#define ENCODER_CONFIG_H_
+
+/**
+ * @brief Maximum number of encoders.
+ */
+#define ENCODER_MAX_NUM    2
+
+/**
+ * @brief Counted edges per wheel revolution (20 slots disk, rising and falling edges).
+ */
+#define ENCODER_EDGES_PER_REV    40
+
+/**
+ * @brief Period of the encoder sampling in ms (ENCODER_poll() must be called at this rate).
+ *
+ * The sensor level must stay stable for more than one period, so a wheel is tracked up to
+ * 1000 / ENCODER_POLL_MS edges per second (25 rev/s with the values above).
+ */
+#define ENCODER_POLL_MS    1
+
+#endif /* ENCODER_CONFIG_H_ */
@@ -0,0 +1,98 @@
+/**
+ * @file ENCODER_interface.h
+ * @brief Wheel Encoder Interface Header File
+ *
+ * This header file defines the interface for reading the wheel encoders.
+ * It includes a configuration structure, an enumeration for return states and
+ * function declarations for initializing, sampling and reading the encoders. The encoders keep
+ * their own time base (the number of samples) to time the edges.
+ *
+ * The encoders have a single channel, so they count the distance travelled by the wheel
+ * but not its direction. The direction is known by the module driving the wheel.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef ENCODER_INTERFACE_H_
+#define ENCODER_INTERFACE_H_
+
+#include "../../MCAL/DIO/DIO_interface.h"
+#include "ENCODER_config.h"
+
+
+/**
+ * @brief Configuration structure for an encoder.
+ */
+typedef struct {
+    dio_enu_port_t enu_port;  /**< GPIO port of the sensor output. */
+    dio_enu_pin_t  enu_pin;   /**< GPIO pin of the sensor output. */
+} encoder_str_config_t;
+
+
+/**
+ * @brief Enumeration defining return states for encoder functions.
+ */
+typedef enum {
+    ENCODER_OK,   /**< Operation was successful. */
+    ENCODER_NOK   /**< Operation failed. */
+} encoder_enu_return_state_t;
+
+
+/**
+ * @brief Initialize an encoder based on its configuration.
+ *
+ * This function configures the sensor pin as an input and adds the encoder to the ones sampled by ENCODER_poll().
+ * Initializing the same encoder again resets its count.
+ *
+ * @param ptr_str_encoder_config Pointer to the encoder's configuration structure.
+ * @return The return state of the encoder initialization.
+ *     - #ENCODER_OK: Encoder initialization successful.
+ *     - #ENCODER_NOK: NULL pointer or #ENCODER_MAX_NUM encoders already initialized.
+ */
+encoder_enu_return_state_t ENCODER_init(const encoder_str_config_t *ptr_str_encoder_config);
+
+/**
+ * @brief Sample all encoders and count the sensor edges.
+ *
+ * Must be called every #ENCODER_POLL_MS from the timer tick.
+ */
+void ENCODER_poll(void);
+
+/**
+ * @brief Read the edge count of an encoder.
+ *
+ * The count is free running and wraps around, the distance between two reads is their
+ * difference in uint16_t arithmetic.
+ *
+ * @param ptr_str_encoder_config Pointer to the encoder's configuration structure.
+ * @param ptr_u16_count Pointer to store the edge count.
+ * @return The return state of reading the count.
+ *     - #ENCODER_OK: Count read successfully.
+ *     - #ENCODER_NOK: NULL pointer or encoder not initialized.
+ */
+encoder_enu_return_state_t ENCODER_get_count(const encoder_str_config_t *ptr_str_encoder_config, uint16_t *ptr_u16_count);
+
+/**
+ * @brief Read the edge count of an encoder with the time of its last edge.
+ *
+ * Edges counted between two reads divided by the time between their last edges gives the wheel speed
+ * with the resolution of #ENCODER_POLL_MS, however few edges there are.
+ *
+ * @param ptr_str_encoder_config Pointer to the encoder's configuration structure.
+ * @param ptr_u16_count Pointer to store the edge count (free running).
+ * @param ptr_u16_time Pointer to store the encoder time of the last edge in ms (see ENCODER_get_time()).
+ * @return The return state of reading the edge.
+ *     - #ENCODER_OK: Edge read successfully.
+ *     - #ENCODER_NOK: NULL pointer or encoder not initialized.
+ */
+encoder_enu_return_state_t ENCODER_get_edge(const encoder_str_config_t *ptr_str_encoder_config, uint16_t *ptr_u16_count, uint16_t *ptr_u16_time);
+
+/**
+ * @brief Read the encoder time.
+ *
+ * @return Time in ms advanced by ENCODER_poll(), wraps around every 65.5 s.
+ */
+uint16_t ENCODER_get_time(void);
+
+#endif /* ENCODER_INTERFACE_H_ */
@@ -0,0 +1,178 @@
+/**
+ * @file ENCODER_prog.c
+ * @brief Wheel Encoder Implementation File
+ *
+ * This file implements the wheel encoders: the sensor pins are sampled from the timer tick
+ * and every level change is counted.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "ENCODER_interface.h"
+#include "../../MCAL/AVR_ARCH/ISR_interface.h"
+
+/**
+ * @brief Sampling state of an encoder.
+ */
+typedef struct {
+	const encoder_str_config_t *ptr_str_config;	/**< Configuration of the encoder. */
+	dio_enu_level_t enu_level;						/**< Sensor level at the last sample. */
+	uint16_t u16_count;								/**< Free running edge count. */
+	uint16_t u16_edge_time;							/**< Encoder time of the last edge (ms). */
+} encoder_str_state_t;
+
+/** @brief State of the initialized encoders, shared with the timer tick */
+static volatile encoder_str_state_t gv_str_encoder[ENCODER_MAX_NUM];
+
+/** @brief Number of initialized encoders */
+static volatile uint8_t gv_u8_encoder_num = U8_ZERO_VALUE;
+
+/** @brief Encoder time in ms, advanced by every sample */
+static volatile uint16_t gv_u16_encoder_time = U8_ZERO_VALUE;
+
+/**
+ * @brief Find the slot of an initialized encoder.
+ *
+ * @param ptr_str_encoder_config Pointer to the encoder's configuration structure.
+ * @return The slot index, #ENCODER_MAX_NUM if the encoder is not initialized.
+ */
+static uint8_t ENCODER_find(const encoder_str_config_t *ptr_str_encoder_config)
+{
+	uint8_t u8_index = U8_ZERO_VALUE;
+
+	while ((u8_index < gv_u8_encoder_num) && (gv_str_encoder[u8_index].ptr_str_config != ptr_str_encoder_config))
+	{
+		u8_index++;
+	}
+	return (u8_index < gv_u8_encoder_num) ? u8_index : ENCODER_MAX_NUM;
+}
+
+encoder_enu_return_state_t ENCODER_init(const encoder_str_config_t *ptr_str_encoder_config)
+{
+	encoder_enu_return_state_t enu_return_state = ENCODER_OK;
+	dio_enu_level_t enu_level = DIO_PIN_LOW_LEVEL;
+	uint8_t u8_index;
+	uint8_t u8_sreg;
+
+	if (ptr_str_encoder_config == NULL)
+	{
+		enu_return_state = ENCODER_NOK;
+	}
+	else
+	{
+		u8_index = ENCODER_find(ptr_str_encoder_config);
+		if ((u8_index == ENCODER_MAX_NUM) && (gv_u8_encoder_num < ENCODER_MAX_NUM))
+		{
+			u8_index = gv_u8_encoder_num;
+		}
+
+		if (u8_index == ENCODER_MAX_NUM)
+		{
+			enu_return_state = ENCODER_NOK;
+		}
+		else
+		{
+			DIO_init(ptr_str_encoder_config->enu_port, ptr_str_encoder_config->enu_pin, DIO_PIN_INPUT);
+			DIO_read_pin(ptr_str_encoder_config->enu_port, ptr_str_encoder_config->enu_pin, &enu_level);
+
+			// The slot is published to ENCODER_poll() only once it is filled
+			ISR_ENTER_CRITICAL(u8_sreg);
+			gv_str_encoder[u8_index].ptr_str_config = ptr_str_encoder_config;
+			gv_str_encoder[u8_index].enu_level = enu_level;
+			gv_str_encoder[u8_index].u16_count = U8_ZERO_VALUE;
+			gv_str_encoder[u8_index].u16_edge_time = gv_u16_encoder_time;
+			if (u8_index == gv_u8_encoder_num)
+			{
+				gv_u8_encoder_num++;
+			}
+			ISR_EXIT_CRITICAL(u8_sreg);
+		}
+	}
+	return enu_return_state;
+}
+
+void ENCODER_poll(void)
+{
+	dio_enu_level_t enu_level;
+
+	gv_u16_encoder_time += ENCODER_POLL_MS;
+	for (uint8_t u8_index = U8_ZERO_VALUE ; u8_index < gv_u8_encoder_num ; u8_index++)
+	{
+		DIO_read_pin(gv_str_encoder[u8_index].ptr_str_config->enu_port, gv_str_encoder[u8_index].ptr_str_config->enu_pin, &enu_level);
+		if (enu_level != gv_str_encoder[u8_index].enu_level)
+		{
+			gv_str_encoder[u8_index].enu_level = enu_level;
+			gv_str_encoder[u8_index].u16_count++;
+			gv_str_encoder[u8_index].u16_edge_time = gv_u16_encoder_time;
+		}
+	}
+}
+
+encoder_enu_return_state_t ENCODER_get_count(const encoder_str_config_t *ptr_str_encoder_config, uint16_t *ptr_u16_count)
+{
+	encoder_enu_return_state_t enu_return_state = ENCODER_OK;
+	uint8_t u8_index;
+	uint8_t u8_sreg;
+
+	if ((ptr_str_encoder_config == NULL) || (ptr_u16_count == NULL))
+	{
+		enu_return_state = ENCODER_NOK;
+	}
+	else
+	{
+		u8_index = ENCODER_find(ptr_str_encoder_config);
+		if (u8_index == ENCODER_MAX_NUM)
+		{
+			enu_return_state = ENCODER_NOK;
+		}
+		else
+		{
+			// 16-bit count updated from the timer tick, read it atomically
+			ISR_ENTER_CRITICAL(u8_sreg);
+			*ptr_u16_count = gv_str_encoder[u8_index].u16_count;
+			ISR_EXIT_CRITICAL(u8_sreg);
+		}
+	}
+	return enu_return_state;
+}
+
+encoder_enu_return_state_t ENCODER_get_edge(const encoder_str_config_t *ptr_str_encoder_config, uint16_t *ptr_u16_count, uint16_t *ptr_u16_time)
+{
+	encoder_enu_return_state_t enu_return_state = ENCODER_OK;
+	uint8_t u8_index;
+	uint8_t u8_sreg;
+
+	if ((ptr_str_encoder_config == NULL) || (ptr_u16_count == NULL) || (ptr_u16_time == NULL))
+	{
+		enu_return_state = ENCODER_NOK;
+	}
+	else
+	{
+		u8_index = ENCODER_find(ptr_str_encoder_config);
+		if (u8_index == ENCODER_MAX_NUM)
+		{
+			enu_return_state = ENCODER_NOK;
+		}
+		else
+		{
+			// Count and time must come from the same sample
+			ISR_ENTER_CRITICAL(u8_sreg);
+			*ptr_u16_count = gv_str_encoder[u8_index].u16_count;
+			*ptr_u16_time = gv_str_encoder[u8_index].u16_edge_time;
+			ISR_EXIT_CRITICAL(u8_sreg);
+		}
+	}
+	return enu_return_state;
+}
+
+uint16_t ENCODER_get_time(void)
+{
+	uint16_t u16_time;
+	uint8_t u8_sreg;
+
+	ISR_ENTER_CRITICAL(u8_sreg);
+	u16_time = gv_u16_encoder_time;
+	ISR_EXIT_CRITICAL(u8_sreg);
+	return u16_time;
+}
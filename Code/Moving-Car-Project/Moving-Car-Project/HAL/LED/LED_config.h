@@ -0,0 +1,57 @@
+/**
+ * @file LED_config.h
+ * @brief LED Configuration Header File
+ *
+ * This header file defines configuration parameters for the LED group handled by the
+ * pattern engine and the bit-angle modulation (BAM) dimmer.
+ *
+ * @note Modify the values below to match the number of LEDs used by the application.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef LED_CONFIG_H_
+#define LED_CONFIG_H_
+
+/**
+ * @brief Maximum number of LEDs in the LED group.
+ *
+ * This defines the size of the LED group table used by the pattern engine.
+ * Every LED in the group has its own pattern state, so keep it equal to the number of LEDs used.
+ */
+#define LED_GROUP_MAX_NUM    4
+
+/**
+ * @brief Maximum number of steps in a blink pattern.
+ *
+ * Pattern steps are stored as bits of a 32-bit sequence.
+ */
+#define LED_PATTERN_MAX_STEPS    32
+
+/**
+ * @brief Number of bit-angle modulation bits (brightness resolution).
+ *
+ * Brightness levels are 0 .. (2^LED_BAM_BITS - 1). Each bit needs one timer interrupt per frame.
+ */
+#define LED_BAM_BITS    8
+
+/**
+ * @brief Timer counts of the shortest bit-angle modulation slot (bit 0).
+ *
+ * Slot n lasts (LED_BAM_UNIT_COUNTS << n) timer counts, so the longest slot must fit
+ * the 8-bit compare register: LED_BAM_UNIT_COUNTS << (LED_BAM_BITS - 1) <= 256.
+ */
+#define LED_BAM_UNIT_COUNTS    2
+
+/**
+ * @brief Maximum number of ports used by the LED group under bit-angle modulation.
+ */
+#define LED_BAM_MAX_PORTS    2
+
+/**
+ * @brief Brightness given to every LED of the group when bit-angle modulation starts.
+ */
+#define LED_BAM_DEFAULT_LEVEL    255
+
+#endif /* LED_CONFIG_H_ */
@@ -4,7 +4,8 @@
  *
  * This header file defines the interface for controlling LEDs.
  * It includes data structures, enumerations, and function declarations for initializing,
- * turning on, and turning off LEDs based on their configuration.
+ * turning on, and turning off LEDs based on their configuration, for playing blink
+ * patterns on a group of LEDs from a periodic tick, and for dimming them with bit-angle modulation.
  *
  * @note This file should be included by modules that need to interact with LEDs.
  *       Ensure that the necessary standard libraries, DIO_interface.h, and the required
@@ -18,8 +19,14 @@
 #ifndef LED_INTERFACE_H_
 #define LED_INTERFACE_H_
 #include "../../MCAL/DIO/DIO_interface.h"
+#include "LED_config.h"
 
 
+/**
+ * @brief Compare value of the first bit-angle modulation slot, to be loaded in the timer before it starts.
+ */
+#define LED_BAM_FIRST_SLOT_COMPARE    ((uint8_t)(LED_BAM_UNIT_COUNTS - 1))
+
 /**
  * @brief Enumeration defining LED states.
  *
@@ -39,7 +46,9 @@ typedef enum {
     LED_OK,                /**< Operation was successful. */
     LED_INVALID_PIN,       /**< LED operation failed due to an invalid pin. */
     LED_INVALID_PORT,      /**< LED operation failed due to an invalid port. */
-    LED_NULL_PTR           /**< LED operation failed due to a null configuration pointer. */
+    LED_NULL_PTR,          /**< LED operation failed due to a null configuration pointer. */
+    LED_INVALID_INDEX,     /**< LED operation failed due to an LED index outside the LED group. */
+    LED_INVALID_PATTERN    /**< LED operation failed due to an empty or too long blink pattern. */
 } led_enu_return_state_t;
 
 
@@ -55,6 +64,24 @@ typedef struct {
 } led_str_config_t;
 
 
+/**
+ * @brief Blink pattern structure.
+ *
+ * A blink pattern is a compact bit sequence played step by step by the pattern engine.
+ * Bit 0 of the sequence is the first step, a set bit turns the LED on for that step.
+ *
+ * Example: 3 fast flashes then a pause, with 100 ms steps and a 10 ms pattern tick:
+ * @code{.c}
+ * const led_str_pattern_t gc_st_pattern = { 0x00000015, 10, 10 };
+ * @endcode
+ */
+typedef struct {
+    uint32_t u32_sequence;   /**< LED state of each step, bit 0 is played first. */
+    uint8_t  u8_length;      /**< Number of steps in the sequence (1 .. #LED_PATTERN_MAX_STEPS). */
+    uint8_t  u8_step_ticks;  /**< Duration of one step in pattern ticks (must not be zero). */
+} led_str_pattern_t;
+
+
 /**
  * @brief Initialize an LED based on its configuration.
  *
@@ -97,6 +124,111 @@ led_enu_return_state_t LED_off(const led_str_config_t *ptr_str_led_config);
  */
 led_enu_return_state_t LED_on(const led_str_config_t *ptr_str_led_config);
 
+/**
+ * @brief Register the LED group handled by the pattern engine.
+ *
+ * The LED index used by the pattern functions is the position of the LED in this array.
+ * Calling #LED_on or #LED_off on an LED of the group cancels any pattern running on it.
+ *
+ * @param ptr_str_leds_config Pointer to the array of LED configuration structures.
+ * @param u8_leds_num Number of LEDs in the array (up to #LED_GROUP_MAX_NUM).
+ * @return The return state of the LED group registration.
+ *     - #LED_OK: LED group registered successfully.
+ *     - #LED_INVALID_INDEX: Too many LEDs for the LED group.
+ *     - #LED_NULL_PTR: Null configuration pointer.
+ */
+led_enu_return_state_t LED_group_init(const led_str_config_t *ptr_str_leds_config, uint8_t u8_leds_num);
+
+/**
+ * @brief Start playing a blink pattern on an LED of the group.
+ *
+ * The pattern is played from the next pattern tick. Starting the pattern that is already
+ * running on the LED does nothing, so it is safe to call it from a polling loop.
+ *
+ * @param u8_led_index Index of the LED in the LED group.
+ * @param ptr_str_pattern Pointer to the blink pattern (must stay valid while playing).
+ * @param u8_phase Step of the pattern to start from, used to shift LEDs against each other.
+ * @return The return state of starting the pattern.
+ *     - #LED_OK: Pattern started successfully.
+ *     - #LED_INVALID_INDEX: LED index outside the LED group.
+ *     - #LED_INVALID_PATTERN: Pattern length or step duration out of range.
+ *     - #LED_NULL_PTR: Null pattern pointer.
+ */
+led_enu_return_state_t LED_pattern_start(uint8_t u8_led_index, const led_str_pattern_t *ptr_str_pattern, uint8_t u8_phase);
+
+/**
+ * @brief Stop the blink pattern of an LED of the group and turn the LED off.
+ *
+ * @param u8_led_index Index of the LED in the LED group.
+ * @return The return state of stopping the pattern.
+ *     - #LED_OK: Pattern stopped successfully.
+ *     - #LED_INVALID_INDEX: LED index outside the LED group.
+ */
+led_enu_return_state_t LED_pattern_stop(uint8_t u8_led_index);
+
+/**
+ * @brief Advance the blink patterns by one pattern tick.
+ *
+ * This function is meant to be called from a periodic timer callback. It only decrements
+ * a counter per LED and touches the LED pin at step boundaries.
+ */
+void LED_pattern_tick(void);
+
+/**
+ * @brief Start driving the LED group with bit-angle modulation (BAM).
+ *
+ * Every LED of the group gets #LED_BAM_DEFAULT_LEVEL brightness and starts off. From now on
+ * #LED_on, #LED_off and the pattern engine only switch the LED state, the pins are written
+ * by #LED_bam_tick. Must be called after #LED_group_init.
+ *
+ * @return The return state of starting the modulation.
+ *     - #LED_OK: Modulation started successfully.
+ *     - #LED_INVALID_PORT: The LED group spans more than #LED_BAM_MAX_PORTS ports.
+ *     - #LED_NULL_PTR: No LED group registered.
+ */
+led_enu_return_state_t LED_bam_init(void);
+
+/**
+ * @brief Set the brightness of an LED of the group.
+ *
+ * The new level takes effect from the next modulation slot.
+ *
+ * @param u8_led_index Index of the LED in the LED group.
+ * @param u8_level Brightness level, 0 (dark) .. 255 (full).
+ * @return The return state of setting the brightness.
+ *     - #LED_OK: Brightness set successfully.
+ *     - #LED_INVALID_INDEX: LED index outside the LED group.
+ */
+led_enu_return_state_t LED_bam_set_brightness(uint8_t u8_led_index, uint8_t u8_level);
+
+/**
+ * @brief Output the current bit-angle modulation slot.
+ *
+ * This function is meant to be called from a timer compare match callback, the timer running in
+ * CTC mode. Slot n lasts (#LED_BAM_UNIT_COUNTS << n) timer counts, so a frame costs only
+ * #LED_BAM_BITS interrupts whatever the number of brightness levels.
+ *
+ * The returned value is the compare value of the slot that starts at the next call. The caller
+ * loads it into the timer first thing in the next callback, so the short slots are not missed.
+ * The compare value of the very first slot is #LED_BAM_FIRST_SLOT_COMPARE.
+ *
+ * @return Compare value of the next slot.
+ */
+uint8_t LED_bam_tick(void);
+
+/**
+ * @brief Drive every pin of the LED group low at once.
+ *
+ * Under bit-angle modulation #LED_off only switches the LED state and the pin follows on the next slot.
+ * Before the clocks stop, the caller stops the modulation timer and blanks the group with this function,
+ * the LED states are kept and shown again from the first slot after the timer restarts.
+ *
+ * @return The return state of blanking the group.
+ *     - #LED_OK: LED group blanked successfully.
+ *     - #LED_NULL_PTR: No LED group registered.
+ */
+led_enu_return_state_t LED_group_blank(void);
+
 
 
 
@@ -3,7 +3,9 @@
  * @brief LED Module Implementation File
  *
  * This file contains the implementation of functions for controlling LEDs.
- * It includes functions to initialize, turn on, and turn off LEDs based on their configuration.
+ * It includes functions to initialize, turn on, and turn off LEDs based on their configuration,
+ * a non-blocking pattern engine that plays blink codes from a periodic tick, and a bit-angle
+ * modulation dimmer for the LEDs of the group.
  *
  * @note This file assumes that the LED_interface.h and DIO_interface.h files are properly included.
  *
@@ -12,6 +14,55 @@
  */
 
 #include "LED_inteface.h"
+#include "../../MCAL/AVR_ARCH/ISR_interface.h"
+
+/**
+ * @brief Run-time state of the pattern played on one LED of the group.
+ */
+typedef struct {
+	const led_str_pattern_t *ptr_str_pattern;	/**< Pattern being played, NULL when idle. */
+	uint32_t u32_remaining;						/**< Sequence bits not played yet in this cycle. */
+	uint8_t  u8_step;							/**< Next step to be played. */
+	uint8_t  u8_ticks_left;						/**< Pattern ticks left before the next step. */
+} led_str_pattern_state_t;
+
+/** @brief LED group registered with the pattern engine */
+static const led_str_config_t *gs_ptr_str_group = NULL;
+
+/** @brief Number of LEDs in the LED group */
+static uint8_t gs_u8_group_num = U8_ZERO_VALUE;
+
+/** @brief Pattern state of each LED in the group */
+static led_str_pattern_state_t gs_str_pattern_state[LED_GROUP_MAX_NUM];
+
+/**
+ * @brief Bit-angle modulation state of one port used by the LED group.
+ */
+typedef struct {
+	dio_enu_port_t enu_port;					/**< Port driven by the modulation. */
+	uint8_t u8_group_mask;						/**< Pins of the LED group on this port. */
+	uint8_t u8_on_mask;							/**< Pins of the LEDs switched on. */
+	uint8_t au8_slot_mask[LED_BAM_BITS];		/**< Pins lit during each slot (bit n of the brightness). */
+} led_str_bam_port_t;
+
+/** @brief Ports driven by the bit-angle modulation */
+static led_str_bam_port_t gs_str_bam_port[LED_BAM_MAX_PORTS];
+
+/** @brief Number of ports driven by the bit-angle modulation */
+static uint8_t gs_u8_bam_ports_num = U8_ZERO_VALUE;
+
+/** @brief Index in #gs_str_bam_port of the port of each LED in the group */
+static uint8_t gs_au8_bam_port_index[LED_GROUP_MAX_NUM];
+
+/** @brief Slot output by the next call of LED_bam_tick */
+static uint8_t gs_u8_bam_slot = U8_ZERO_VALUE;
+
+/** @brief TRUE once the LED group is driven by the bit-angle modulation */
+static uint8_t gs_u8_bam_active = FALSE;
+
+static uint8_t LED_group_take(const led_str_config_t *ptr_str_led_config);
+static dio_enu_return_state_t LED_group_write(uint8_t u8_led_index, dio_enu_level_t copy_enu_level);
+static void LED_pattern_step(uint8_t u8_led_index);
 
 led_enu_return_state_t LED_init(const led_str_config_t *ptr_str_led_config)
 {
@@ -41,9 +92,16 @@ led_enu_return_state_t LED_off(const led_str_config_t *ptr_str_led_config)
 {
 	led_enu_return_state_t enu_return_state = LED_OK;
 	dio_enu_return_state_t enu_dio_api_return_state = DIO_OK;
+	uint8_t u8_led_index;
 	
 	if(ptr_str_led_config != NULL){
-		enu_dio_api_return_state = DIO_write_pin (ptr_str_led_config->enu_port, ptr_str_led_config->enu_pin, DIO_PIN_LOW_LEVEL);
+		// Direct commands take over from the pattern engine
+		u8_led_index = LED_group_take(ptr_str_led_config);
+		if(u8_led_index < gs_u8_group_num){
+			enu_dio_api_return_state = LED_group_write(u8_led_index, DIO_PIN_LOW_LEVEL);
+		}else{
+			enu_dio_api_return_state = DIO_write_pin (ptr_str_led_config->enu_port, ptr_str_led_config->enu_pin, DIO_PIN_LOW_LEVEL);
+		}
 		if(enu_dio_api_return_state == DIO_OK){
 			enu_return_state = LED_OK;
 			}else if (enu_dio_api_return_state == DIO_INVALID_PIN){
@@ -68,11 +126,16 @@ led_enu_return_state_t LED_on(const led_str_config_t *ptr_str_led_config)
 
 	led_enu_return_state_t enu_return_state = LED_OK;
 	dio_enu_return_state_t enu_dio_api_return_state = DIO_OK;
-	
+	uint8_t u8_led_index;
 	
 	if(ptr_str_led_config != NULL){
-		
-		enu_dio_api_return_state = DIO_write_pin (ptr_str_led_config->enu_port, ptr_str_led_config->enu_pin, DIO_PIN_HIGH_LEVEL);
+		// Direct commands take over from the pattern engine
+		u8_led_index = LED_group_take(ptr_str_led_config);
+		if(u8_led_index < gs_u8_group_num){
+			enu_dio_api_return_state = LED_group_write(u8_led_index, DIO_PIN_HIGH_LEVEL);
+		}else{
+			enu_dio_api_return_state = DIO_write_pin (ptr_str_led_config->enu_port, ptr_str_led_config->enu_pin, DIO_PIN_HIGH_LEVEL);
+		}
 		if(enu_dio_api_return_state == DIO_OK){
 			enu_return_state = LED_OK;
 		}else if (enu_dio_api_return_state == DIO_INVALID_PIN){
@@ -87,4 +150,291 @@ led_enu_return_state_t LED_on(const led_str_config_t *ptr_str_led_config)
 			enu_return_state = LED_NULL_PTR;
 		}
 	return enu_return_state;
-}
\ No newline at end of file
+}
+
+led_enu_return_state_t LED_group_init(const led_str_config_t *ptr_str_leds_config, uint8_t u8_leds_num)
+{
+	led_enu_return_state_t enu_return_state = LED_OK;
+	uint8_t u8_sreg;
+	
+	if(ptr_str_leds_config == NULL){
+		enu_return_state = LED_NULL_PTR;
+	}else if(u8_leds_num > LED_GROUP_MAX_NUM){
+		enu_return_state = LED_INVALID_INDEX;
+	}else{
+		ISR_ENTER_CRITICAL(u8_sreg);
+		for(uint8_t u8_index = U8_ZERO_VALUE ; u8_index < LED_GROUP_MAX_NUM ; u8_index++)
+		{
+			gs_str_pattern_state[u8_index].ptr_str_pattern = NULL;
+		}
+		gs_ptr_str_group = ptr_str_leds_config;
+		gs_u8_group_num = u8_leds_num;
+		gs_u8_bam_active = FALSE;
+		ISR_EXIT_CRITICAL(u8_sreg);
+	}
+	return enu_return_state;
+}
+
+led_enu_return_state_t LED_pattern_start(uint8_t u8_led_index, const led_str_pattern_t *ptr_str_pattern, uint8_t u8_phase)
+{
+	led_enu_return_state_t enu_return_state = LED_OK;
+	led_str_pattern_state_t *ptr_str_state;
+	uint8_t u8_sreg;
+	
+	if(ptr_str_pattern == NULL){
+		enu_return_state = LED_NULL_PTR;
+	}else if(u8_led_index >= gs_u8_group_num){
+		enu_return_state = LED_INVALID_INDEX;
+	}else if((ptr_str_pattern->u8_length == U8_ZERO_VALUE) || (ptr_str_pattern->u8_length > LED_PATTERN_MAX_STEPS) ||
+			 (ptr_str_pattern->u8_step_ticks == U8_ZERO_VALUE)){
+		enu_return_state = LED_INVALID_PATTERN;
+	}else{
+		ptr_str_state = &gs_str_pattern_state[u8_led_index];
+		ISR_ENTER_CRITICAL(u8_sreg);
+		if(ptr_str_state->ptr_str_pattern != ptr_str_pattern){
+			// Start from the requested phase, first step is played on the next tick
+			ptr_str_state->u8_step = u8_phase % ptr_str_pattern->u8_length;
+			ptr_str_state->u32_remaining = ptr_str_pattern->u32_sequence >> ptr_str_state->u8_step;
+			ptr_str_state->u8_ticks_left = U8_ONE_VALUE;
+			ptr_str_state->ptr_str_pattern = ptr_str_pattern;
+		}else{
+			// Pattern already running, keep its phase
+		}
+		ISR_EXIT_CRITICAL(u8_sreg);
+	}
+	return enu_return_state;
+}
+
+led_enu_return_state_t LED_pattern_stop(uint8_t u8_led_index)
+{
+	led_enu_return_state_t enu_return_state = LED_OK;
+	
+	if(u8_led_index < gs_u8_group_num){
+		enu_return_state = LED_off(gs_ptr_str_group + u8_led_index);
+	}else{
+		enu_return_state = LED_INVALID_INDEX;
+	}
+	return enu_return_state;
+}
+
+void LED_pattern_tick(void)
+{
+	for(uint8_t u8_index = U8_ZERO_VALUE ; u8_index < gs_u8_group_num ; u8_index++)
+	{
+		if(gs_str_pattern_state[u8_index].ptr_str_pattern != NULL)
+		{
+			gs_str_pattern_state[u8_index].u8_ticks_left--;
+			if(gs_str_pattern_state[u8_index].u8_ticks_left == U8_ZERO_VALUE)
+			{
+				LED_pattern_step(u8_index);
+			}
+		}
+	}
+}
+
+led_enu_return_state_t LED_bam_init(void)
+{
+	led_enu_return_state_t enu_return_state = LED_OK;
+	uint8_t u8_port_index;
+	uint8_t u8_sreg;
+	
+	if(gs_ptr_str_group == NULL){
+		enu_return_state = LED_NULL_PTR;
+	}else{
+		ISR_ENTER_CRITICAL(u8_sreg);
+		gs_u8_bam_active = FALSE;
+		gs_u8_bam_ports_num = U8_ZERO_VALUE;
+		gs_u8_bam_slot = U8_ZERO_VALUE;
+		for(uint8_t u8_index = U8_ZERO_VALUE ; (u8_index < gs_u8_group_num) && (enu_return_state == LED_OK) ; u8_index++)
+		{
+			// Find the port of the LED in the port table, or add it
+			u8_port_index = U8_ZERO_VALUE;
+			while((u8_port_index < gs_u8_bam_ports_num) && (gs_str_bam_port[u8_port_index].enu_port != gs_ptr_str_group[u8_index].enu_port))
+			{
+				u8_port_index++;
+			}
+			if(u8_port_index == gs_u8_bam_ports_num)
+			{
+				if(gs_u8_bam_ports_num < LED_BAM_MAX_PORTS)
+				{
+					gs_str_bam_port[u8_port_index].enu_port = gs_ptr_str_group[u8_index].enu_port;
+					gs_str_bam_port[u8_port_index].u8_group_mask = U8_ZERO_VALUE;
+					gs_str_bam_port[u8_port_index].u8_on_mask = U8_ZERO_VALUE;
+					gs_u8_bam_ports_num++;
+				}
+				else
+				{
+					enu_return_state = LED_INVALID_PORT;
+				}
+			}
+			if(enu_return_state == LED_OK)
+			{
+				gs_au8_bam_port_index[u8_index] = u8_port_index;
+				gs_str_bam_port[u8_port_index].u8_group_mask |= (U8_ONE_VALUE << gs_ptr_str_group[u8_index].enu_pin);
+				LED_bam_set_brightness(u8_index, LED_BAM_DEFAULT_LEVEL);
+			}
+		}
+		if(enu_return_state == LED_OK)
+		{
+			gs_u8_bam_active = TRUE;
+		}
+		ISR_EXIT_CRITICAL(u8_sreg);
+	}
+	return enu_return_state;
+}
+
+led_enu_return_state_t LED_bam_set_brightness(uint8_t u8_led_index, uint8_t u8_level)
+{
+	led_enu_return_state_t enu_return_state = LED_OK;
+	led_str_bam_port_t *ptr_str_port;
+	uint8_t u8_pin_mask;
+	
+	if(u8_led_index < gs_u8_group_num){
+		ptr_str_port = &gs_str_bam_port[gs_au8_bam_port_index[u8_led_index]];
+		u8_pin_mask = (U8_ONE_VALUE << gs_ptr_str_group[u8_led_index].enu_pin);
+		// Slot masks are only written here, the modulation only reads them
+		for(uint8_t u8_slot = U8_ZERO_VALUE ; u8_slot < LED_BAM_BITS ; u8_slot++)
+		{
+			if((u8_level & U8_ONE_VALUE) != U8_ZERO_VALUE){
+				ptr_str_port->au8_slot_mask[u8_slot] |= u8_pin_mask;
+			}else{
+				ptr_str_port->au8_slot_mask[u8_slot] &= ~u8_pin_mask;
+			}
+			u8_level >>= U8_ONE_VALUE;
+		}
+	}else{
+		enu_return_state = LED_INVALID_INDEX;
+	}
+	return enu_return_state;
+}
+
+uint8_t LED_bam_tick(void)
+{
+	uint8_t u8_slot = gs_u8_bam_slot;
+	
+	for(uint8_t u8_port_index = U8_ZERO_VALUE ; u8_port_index < gs_u8_bam_ports_num ; u8_port_index++)
+	{
+		DIO_write_port(gs_str_bam_port[u8_port_index].enu_port, gs_str_bam_port[u8_port_index].u8_group_mask,
+					   gs_str_bam_port[u8_port_index].au8_slot_mask[u8_slot] & gs_str_bam_port[u8_port_index].u8_on_mask);
+	}
+	
+	u8_slot++;
+	if(u8_slot >= LED_BAM_BITS)
+	{
+		u8_slot = U8_ZERO_VALUE;
+	}
+	gs_u8_bam_slot = u8_slot;
+	
+	// Slot n lasts (unit << n) counts, the compare value is one less in CTC mode
+	return (uint8_t)((LED_BAM_UNIT_COUNTS << u8_slot) - U8_ONE_VALUE);
+}
+
+/**
+ * @brief Cancel the pattern running on an LED of the group, if any.
+ *
+ * @param ptr_str_led_config Pointer to the LED's configuration structure.
+ * @return Index of the LED in the LED group, or #LED_GROUP_MAX_NUM when the LED is not part of it.
+ */
+static uint8_t LED_group_take(const led_str_config_t *ptr_str_led_config)
+{
+	uint8_t u8_led_index = LED_GROUP_MAX_NUM;
+	uint8_t u8_sreg;
+	
+	for(uint8_t u8_index = U8_ZERO_VALUE ; u8_index < gs_u8_group_num ; u8_index++)
+	{
+		if((gs_ptr_str_group + u8_index) == ptr_str_led_config)
+		{
+			ISR_ENTER_CRITICAL(u8_sreg);
+			gs_str_pattern_state[u8_index].ptr_str_pattern = NULL;
+			ISR_EXIT_CRITICAL(u8_sreg);
+			u8_led_index = u8_index;
+		}
+	}
+	return u8_led_index;
+}
+
+/**
+ * @brief Switch an LED of the group on or off.
+ *
+ * Under bit-angle modulation only the LED state is updated, the pin follows on the next slot.
+ *
+ * @param u8_led_index Index of the LED in the LED group.
+ * @param copy_enu_level DIO_PIN_HIGH_LEVEL to switch the LED on, DIO_PIN_LOW_LEVEL to switch it off.
+ * @return The return state of the pin write.
+ */
+static dio_enu_return_state_t LED_group_write(uint8_t u8_led_index, dio_enu_level_t copy_enu_level)
+{
+	dio_enu_return_state_t enu_return_state = DIO_OK;
+	led_str_bam_port_t *ptr_str_port;
+	uint8_t u8_pin_mask;
+	uint8_t u8_sreg;
+	
+	if(gs_u8_bam_active == TRUE)
+	{
+		ptr_str_port = &gs_str_bam_port[gs_au8_bam_port_index[u8_led_index]];
+		u8_pin_mask = (U8_ONE_VALUE << gs_ptr_str_group[u8_led_index].enu_pin);
+		ISR_ENTER_CRITICAL(u8_sreg);
+		if(copy_enu_level == DIO_PIN_HIGH_LEVEL){
+			ptr_str_port->u8_on_mask |= u8_pin_mask;
+		}else{
+			ptr_str_port->u8_on_mask &= ~u8_pin_mask;
+		}
+		ISR_EXIT_CRITICAL(u8_sreg);
+	}
+	else
+	{
+		enu_return_state = DIO_write_pin(gs_ptr_str_group[u8_led_index].enu_port, gs_ptr_str_group[u8_led_index].enu_pin, copy_enu_level);
+	}
+	return enu_return_state;
+}
+
+/**
+ * @brief Play the next step of the pattern running on an LED and reload its step duration.
+ *
+ * @param u8_led_index Index of the LED in the LED group.
+ */
+static void LED_pattern_step(uint8_t u8_led_index)
+{
+	led_str_pattern_state_t *ptr_str_state = &gs_str_pattern_state[u8_led_index];
+	const led_str_pattern_t *ptr_str_pattern = ptr_str_state->ptr_str_pattern;
+	dio_enu_level_t enu_level = DIO_PIN_LOW_LEVEL;
+	
+	if(ptr_str_state->u8_step == U8_ZERO_VALUE)
+	{
+		// New cycle of the pattern
+		ptr_str_state->u32_remaining = ptr_str_pattern->u32_sequence;
+	}
+	if((ptr_str_state->u32_remaining & U8_ONE_VALUE) != U8_ZERO_VALUE)
+	{
+		enu_level = DIO_PIN_HIGH_LEVEL;
+	}
+	LED_group_write(u8_led_index, enu_level);
+	
+	ptr_str_state->u32_remaining >>= U8_ONE_VALUE;
+	ptr_str_state->u8_step++;
+	if(ptr_str_state->u8_step >= ptr_str_pattern->u8_length)
+	{
+		ptr_str_state->u8_step = U8_ZERO_VALUE;
+	}
+	ptr_str_state->u8_ticks_left = ptr_str_pattern->u8_step_ticks;
+}
+
+led_enu_return_state_t LED_group_blank(void)
+{
+	led_enu_return_state_t enu_return_state = LED_OK;
+	
+	if(gs_ptr_str_group == NULL){
+		enu_return_state = LED_NULL_PTR;
+	}else if(gs_u8_bam_active == TRUE){
+		for(uint8_t u8_port_index = U8_ZERO_VALUE ; u8_port_index < gs_u8_bam_ports_num ; u8_port_index++)
+		{
+			DIO_write_port(gs_str_bam_port[u8_port_index].enu_port, gs_str_bam_port[u8_port_index].u8_group_mask, U8_ZERO_VALUE);
+		}
+	}else{
+		for(uint8_t u8_index = U8_ZERO_VALUE ; u8_index < gs_u8_group_num ; u8_index++)
+		{
+			DIO_write_pin(gs_ptr_str_group[u8_index].enu_port, gs_ptr_str_group[u8_index].enu_pin, DIO_PIN_LOW_LEVEL);
+		}
+	}
+	return enu_return_state;
+}
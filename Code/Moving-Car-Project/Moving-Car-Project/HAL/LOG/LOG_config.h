@@ -0,0 +1,29 @@
+/**
+ * @file LOG_config.h
+ * @brief Event Log Configuration Header File
+ *
+ * This header file defines where the event log lives in the EEPROM and how many events wait in RAM.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef LOG_CONFIG_H_
+#define LOG_CONFIG_H_
+
+/**
+ * @brief EEPROM address of the first record, after the parameter store (143 bytes at address 0).
+ */
+#define LOG_EEPROM_ADDRESS		256
+
+/**
+ * @brief Number of records in the EEPROM ring (8 bytes each), every slot is written once per turn of the ring.
+ */
+#define LOG_RECORDS_NUM			96
+
+/**
+ * @brief Number of events waiting in RAM for the EEPROM, more are dropped and counted.
+ */
+#define LOG_QUEUE_SIZE			4
+
+#endif /* LOG_CONFIG_H_ */
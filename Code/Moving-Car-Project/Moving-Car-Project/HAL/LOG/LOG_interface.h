@@ -0,0 +1,113 @@
+/**
+ * @file LOG_interface.h
+ * @brief Event Log Interface Header File
+ *
+ * This header file defines the interface of the event log: a ring of fixed size records in the EEPROM that
+ * keeps the last events (e-stops, motor faults, overruns) across power downs.
+ *
+ * Logging an event only copies it to a small RAM queue, so it can be done from an interrupt with a constant,
+ * short cost. LOG_task() moves the queued events to the EEPROM in the background, one record at a time.
+ * The records are written around the ring to spread the wear, each has a sequence number and a CRC: at boot
+ * the newest valid record tells where the ring carries on.
+ *
+ * Events that repeat, a task overrun or the fault of a module, are only logged the first time: the first one
+ * is enough to look into, logging every one would wear the EEPROM. Their counters keep the rest.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef LOG_INTERFACE_H_
+#define LOG_INTERFACE_H_
+
+#include "../../MCAL/EEPROM/EEPROM_interface.h"
+#include "../../STD_LIB/bit_math.h"
+#include "../../STD_LIB/std_types.h"
+#include "LOG_config.h"
+
+
+/**
+ * @brief Enumeration of the logged events.
+ */
+typedef enum {
+    LOG_EVENT_BOOT = 1,				/**< The car was powered up or reset (arg: reset flags, value: tasks that missed the watchdog window). */
+    LOG_EVENT_START,				/**< The start button started the route. */
+    LOG_EVENT_ESTOP,				/**< The stop button braked the car (arg: route segment). */
+    LOG_EVENT_MOTOR_FAULT,			/**< The overcurrent guard cut a motor (arg: fault mask, one bit per motor). */
+    LOG_EVENT_SEGMENT_TIMEOUT,		/**< A route segment ended on its duration before its goal (arg: segment, value: duration in ms). */
+    LOG_EVENT_TASK_OVERRUN,			/**< A scheduler task missed its deadline for the first time (arg: task index). */
+    LOG_EVENT_TELEOP_TIMEOUT,		/**< The host setpoints stopped during teleoperation, the car braked (value: timeout in ms). */
+    LOG_EVENT_FAULT					/**< A module reported its first fault (arg: module, see fault_enu_module_t, value: source line). */
+} log_enu_event_t;
+
+/**
+ * @brief A log record, as stored in the EEPROM.
+ */
+typedef struct {
+    uint16_t u16_sequence;	/**< Sequence number, one more than the record before. */
+    uint8_t  u8_event;		/**< Event, see log_enu_event_t. */
+    uint8_t  u8_arg;		/**< Argument of the event. */
+    uint16_t u16_value;		/**< Value of the event. */
+    uint16_t u16_crc;		/**< CRC-16 of the fields above. */
+} log_str_record_t;
+
+/**
+ * @brief Enumeration defining return states for log functions.
+ */
+typedef enum {
+    LOG_OK,		/**< Operation was successful. */
+    LOG_NOK,	/**< NULL pointer or no such record. */
+    LOG_BUSY	/**< The EEPROM is still writing, try again later. */
+} log_enu_return_state_t;
+
+
+/**
+ * @brief Find where the ring carries on.
+ *
+ * Must be called at boot, before anything else writes the EEPROM. It reads every record once.
+ *
+ * @return The return state of the initialization.
+ *     - #LOG_OK: Initialization successful (a blank ring starts at its first slot).
+ *     - #LOG_BUSY: The EEPROM is still writing, the ring starts at its first slot.
+ */
+log_enu_return_state_t LOG_init(void);
+
+/**
+ * @brief Log an event.
+ *
+ * Can be called from any context, interrupts included. The event is dropped and counted if the RAM queue is full.
+ *
+ * @param copy_enu_event The event.
+ * @param copy_u8_arg Argument of the event.
+ * @param copy_u16_value Value of the event.
+ */
+void LOG_event(log_enu_event_t copy_enu_event, uint8_t copy_u8_arg, uint16_t copy_u16_value);
+
+/**
+ * @brief Move the queued events to the EEPROM.
+ *
+ * Must be called periodically from the main loop. It never waits for the EEPROM: a record is queued when
+ * the EEPROM is idle and its RAM slot is freed once it is programmed (8 bytes take up to 68 ms).
+ */
+void LOG_task(void);
+
+/**
+ * @brief Read a record back from the EEPROM.
+ *
+ * @param copy_u8_age Age of the record, 0 for the newest one.
+ * @param ptr_str_record Pointer to store the record.
+ * @return The return state of reading the record.
+ *     - #LOG_OK: Record read successfully.
+ *     - #LOG_NOK: NULL pointer, or no valid record of that age.
+ *     - #LOG_BUSY: The EEPROM is still writing.
+ */
+log_enu_return_state_t LOG_read(uint8_t copy_u8_age, log_str_record_t *ptr_str_record);
+
+/**
+ * @brief Read the number of events dropped because the RAM queue was full.
+ *
+ * @return The number of dropped events (saturates at 65535).
+ */
+uint16_t LOG_get_dropped(void);
+
+#endif /* LOG_INTERFACE_H_ */
@@ -0,0 +1,210 @@
+/**
+ * @file LOG_prog.c
+ * @brief Event Log Implementation File
+ *
+ * This file implements the event log: a RAM queue filled from any context and drained to a ring
+ * of records in the EEPROM from the main loop.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "LOG_interface.h"
+#include "../../MCAL/AVR_ARCH/ISR_interface.h"
+#include "../../STD_LIB/crc16.h"
+
+/***************************************************************************/
+/*******				Static function prototypes					*******/
+/***************************************************************************/
+
+static uint16_t LOG_crc(const log_str_record_t *ptr_str_record);
+static uint16_t LOG_address(uint8_t u8_slot);
+
+
+/** @brief Size of a record without its CRC */
+#define LOG_CRC_SPAN		(sizeof(log_str_record_t) - sizeof(uint16_t))
+
+/** @brief Events waiting for the EEPROM, the oldest one is written first */
+static volatile log_str_record_t gv_str_log_queue[LOG_QUEUE_SIZE];
+
+/** @brief Index of the oldest queued event */
+static volatile uint8_t gv_u8_log_head = U8_ZERO_VALUE;
+
+/** @brief Number of queued events, the one being written included */
+static volatile uint8_t gv_u8_log_count = U8_ZERO_VALUE;
+
+/** @brief Events dropped because the queue was full */
+static volatile uint16_t gv_u16_log_dropped = U8_ZERO_VALUE;
+
+/** @brief TRUE while the oldest queued event is being written to the EEPROM */
+static uint8_t gs_u8_log_in_flight = FALSE;
+
+/** @brief Slot of the next record in the ring */
+static uint8_t gs_u8_log_slot = U8_ZERO_VALUE;
+
+/** @brief Sequence number of the next record */
+static uint16_t gs_u16_log_sequence = U8_ZERO_VALUE;
+
+
+/**
+ * @brief Compute the CRC of a record.
+ *
+ * @param ptr_str_record Pointer to the record.
+ * @return The CRC of every field but the CRC.
+ */
+static uint16_t LOG_crc(const log_str_record_t *ptr_str_record)
+{
+	return CRC16_block(CRC16_INIT, ptr_str_record, LOG_CRC_SPAN);
+}
+
+/**
+ * @brief EEPROM address of a slot of the ring.
+ *
+ * @param u8_slot The slot.
+ * @return The address of the slot.
+ */
+static uint16_t LOG_address(uint8_t u8_slot)
+{
+	return (uint16_t)(LOG_EEPROM_ADDRESS + ((uint16_t)u8_slot * sizeof(log_str_record_t)));
+}
+
+log_enu_return_state_t LOG_init(void)
+{
+	log_enu_return_state_t enu_return_state = LOG_OK;
+	log_str_record_t str_record;
+	uint8_t u8_found = FALSE;
+	uint16_t u16_newest = U8_ZERO_VALUE;
+
+	gs_u8_log_slot = U8_ZERO_VALUE;
+	gs_u16_log_sequence = U8_ZERO_VALUE;
+
+	for (uint8_t u8_slot = U8_ZERO_VALUE ; (u8_slot < LOG_RECORDS_NUM) && (enu_return_state == LOG_OK) ; u8_slot++)
+	{
+		if (EEPROM_read(LOG_address(u8_slot), &str_record, sizeof(str_record)) != EEPROM_OK)
+		{
+			enu_return_state = LOG_BUSY;
+		}
+		else if (LOG_crc(&str_record) == str_record.u16_crc)
+		{
+			// The ring holds far fewer records than half the sequence numbers, so the newest is ahead of all others
+			if ((u8_found == FALSE) || ((sint16_t)(str_record.u16_sequence - u16_newest) > 0))
+			{
+				u16_newest = str_record.u16_sequence;
+				gs_u8_log_slot = (uint8_t)((u8_slot + U8_ONE_VALUE) % LOG_RECORDS_NUM);
+				gs_u16_log_sequence = (uint16_t)(u16_newest + U8_ONE_VALUE);
+				u8_found = TRUE;
+			}
+		}
+		else
+		{
+			// Blank or torn record
+		}
+	}
+
+	if (enu_return_state != LOG_OK)
+	{
+		gs_u8_log_slot = U8_ZERO_VALUE;
+		gs_u16_log_sequence = U8_ZERO_VALUE;
+	}
+	return enu_return_state;
+}
+
+void LOG_event(log_enu_event_t copy_enu_event, uint8_t copy_u8_arg, uint16_t copy_u16_value)
+{
+	uint8_t u8_sreg;
+	uint8_t u8_tail;
+
+	ISR_ENTER_CRITICAL(u8_sreg);
+	if (gv_u8_log_count < LOG_QUEUE_SIZE)
+	{
+		u8_tail = (uint8_t)((gv_u8_log_head + gv_u8_log_count) % LOG_QUEUE_SIZE);
+		gv_str_log_queue[u8_tail].u8_event = (uint8_t)copy_enu_event;
+		gv_str_log_queue[u8_tail].u8_arg = copy_u8_arg;
+		gv_str_log_queue[u8_tail].u16_value = copy_u16_value;
+		gv_u8_log_count++;
+	}
+	else if (gv_u16_log_dropped < 0xFFFF)
+	{
+		gv_u16_log_dropped++;
+	}
+	else
+	{
+		// Dropped count saturated
+	}
+	ISR_EXIT_CRITICAL(u8_sreg);
+}
+
+void LOG_task(void)
+{
+	log_str_record_t *ptr_str_record;
+	uint8_t u8_sreg;
+
+	if (EEPROM_is_idle() == TRUE)
+	{
+		if (gs_u8_log_in_flight == TRUE)
+		{
+			// The record is programmed, its queue slot is free
+			ISR_ENTER_CRITICAL(u8_sreg);
+			gv_u8_log_head = (uint8_t)((gv_u8_log_head + U8_ONE_VALUE) % LOG_QUEUE_SIZE);
+			gv_u8_log_count--;
+			ISR_EXIT_CRITICAL(u8_sreg);
+			gs_u8_log_in_flight = FALSE;
+		}
+
+		if (gv_u8_log_count > U8_ZERO_VALUE)
+		{
+			// Only the tail is written by LOG_event(), the head is stable while it is queued
+			ptr_str_record = (log_str_record_t *)&gv_str_log_queue[gv_u8_log_head];
+			ptr_str_record->u16_sequence = gs_u16_log_sequence;
+			ptr_str_record->u16_crc = LOG_crc(ptr_str_record);
+
+			if (EEPROM_write(LOG_address(gs_u8_log_slot), ptr_str_record, sizeof(log_str_record_t)) == EEPROM_OK)
+			{
+				gs_u8_log_in_flight = TRUE;
+				gs_u16_log_sequence++;
+				gs_u8_log_slot = (uint8_t)((gs_u8_log_slot + U8_ONE_VALUE) % LOG_RECORDS_NUM);
+			}
+		}
+	}
+}
+
+log_enu_return_state_t LOG_read(uint8_t copy_u8_age, log_str_record_t *ptr_str_record)
+{
+	log_enu_return_state_t enu_return_state = LOG_OK;
+	uint8_t u8_slot;
+
+	if ((ptr_str_record == NULL) || (copy_u8_age >= LOG_RECORDS_NUM))
+	{
+		enu_return_state = LOG_NOK;
+	}
+	else
+	{
+		u8_slot = (uint8_t)((gs_u8_log_slot + (2 * LOG_RECORDS_NUM) - U8_ONE_VALUE - copy_u8_age) % LOG_RECORDS_NUM);
+		if (EEPROM_read(LOG_address(u8_slot), ptr_str_record, sizeof(log_str_record_t)) != EEPROM_OK)
+		{
+			enu_return_state = LOG_BUSY;
+		}
+		else if ((LOG_crc(ptr_str_record) != ptr_str_record->u16_crc)
+				|| (ptr_str_record->u16_sequence != (uint16_t)(gs_u16_log_sequence - U8_ONE_VALUE - copy_u8_age)))
+		{
+			// Blank slot, or a record of an older turn of the ring
+			enu_return_state = LOG_NOK;
+		}
+		else
+		{
+			// Record valid
+		}
+	}
+	return enu_return_state;
+}
+
+uint16_t LOG_get_dropped(void)
+{
+	uint16_t u16_dropped;
+	uint8_t u8_sreg;
+
+	ISR_ENTER_CRITICAL(u8_sreg);
+	u16_dropped = gv_u16_log_dropped;
+	ISR_EXIT_CRITICAL(u8_sreg);
+	return u16_dropped;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file MOTOR_config.h
+ * @brief MOTOR Configuration Header File
+ *
+ * This header file defines configuration parameters for the motor speed control.
+ * The motor pins are not timer output compare pins, so the duty cycle is generated by
+ * toggling the pins from the Timer 1 compare unit interrupts while Timer 1 is free running.
+ *
+ * @note Timer 1 must run in normal mode with no prescaler (F_CPU = 8M) for the values below.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef MOTOR_CONFIG_H_
+#define MOTOR_CONFIG_H_
+
+/**
+ * @brief Maximum number of motors driven with speed control.
+ *
+ * Every motor uses its own Timer 1 compare unit, so it can't exceed the number of compare units.
+ */
+#define MOTOR_MAX_NUM    2
+
+/**
+ * @brief Length of one PWM period in Timer 1 counts (16384 counts = 2.048 ms, 488 Hz).
+ *
+ * Must be less than 65536 since the compare value is moved forward on a 16-bit counter.
+ */
+#define MOTOR_PWM_PERIOD_CYCLES    16384UL
+
+/**
+ * @brief Shortest on or off phase in Timer 1 counts (64 us).
+ *
+ * A phase shorter than this is dropped (0% or 100% duty) so every compare interrupt
+ * has enough time to finish before the next one is due.
+ */
+#define MOTOR_PWM_MIN_PULSE_CYCLES    512U
+
+/**
+ * @brief Full scale of the motor velocity in percent.
+ */
+#define MOTOR_VELOCITY_MAX_PERCENT    100
+
+/**
+ * @brief Gain trim that leaves the motor speed unchanged (percent).
+ */
+#define MOTOR_GAIN_NO_TRIM    100
+
+/**
+ * @brief Period of the velocity ramp update in ms (MOTOR_ramp_tick() must be called at this rate).
+ */
+#define MOTOR_RAMP_TICK_MS    2
+
+/**
+ * @brief Acceleration limit of the velocity ramp in percent per second (0 to 100% in 200 ms).
+ */
+#define MOTOR_RAMP_ACCEL_PERCENT_PER_S    500UL
+
+/**
+ * @brief Time in ms to build up (or remove) the full acceleration, this limits the jerk.
+ *
+ * A value above MOTOR_RAMP_TICK_MS gives an S-curve profile, a value of 0 gives a trapezoidal profile.
+ */
+#define MOTOR_RAMP_JERK_TIME_MS    40UL
+
+/**
+ * @brief Time in ms a motor coasts (both control pins low) before it is driven in the other direction.
+ *
+ * Rounded up to a whole number of ramp ticks. It lets the motor current decay before the H-bridge reverses.
+ */
+#define MOTOR_DEAD_TIME_MS    4
+
+/**
+ * @brief Reference of the overcurrent guard on the analog comparator positive input.
+ *
+ * Every motor current shunt drives the negative input, a shunt voltage above the reference trips the guard
+ * (ANA_COMP_POS_BANDGAP is 1.23 V, ANA_COMP_POS_AIN0 takes an external threshold on PB2).
+ */
+#define MOTOR_GUARD_REFERENCE    ANA_COMP_POS_BANDGAP
+
+#endif /* MOTOR_CONFIG_H_ */
@@ -19,17 +19,28 @@
 
 
 #include "../../MCAL/DIO/DIO_interface.h"
+#include "../TIMER_manager/TIMER_manger_interface.h"
+#include "../../MCAL/ANA_COMP/ANA_COMP_interface.h"
+#include "MOTOR_config.h"
 
 
 /**
  * @brief Configuration structure for a motor.
  *
- * This structure holds the configuration settings for a motor, including its associated GPIO pins.
+ * This structure holds the configuration settings for a motor, including its associated GPIO pins,
+ * the Timer 1 compare unit timing its duty cycle and its calibration trims.
+ *
+ * The trims map a commanded velocity v (percent) to the duty cycle:
+ * duty = u8_offset + |v| * (u8_gain / 100) * (100 - u8_offset) / 100, limited to 100%.
  */
 typedef struct motor_str_config_t {
     dio_enu_port_t port;      /**< GPIO port associated with the motor. */
     dio_enu_pin_t  pin_num1;  /**< GPIO pin number for the first control signal. */
     dio_enu_pin_t  pin_num2;  /**< GPIO pin number for the second control signal. */
+    timer_enu_compare_unit_t enu_pwm_unit; /**< Timer 1 compare unit generating the duty cycle (one per motor). */
+    uint8_t        u8_gain;   /**< Gain trim in percent, #MOTOR_GAIN_NO_TRIM leaves the speed unchanged. */
+    uint8_t        u8_offset; /**< Offset trim in percent, minimum duty that makes the motor turn. */
+    ana_comp_enu_negative_input_t enu_sense_input; /**< Comparator input of the current shunt, ANA_COMP_NEG_INVALID if not watched. */
 } motor_str_config_t;
 
 
@@ -41,7 +52,8 @@ typedef struct motor_str_config_t {
  */
 typedef enum motor_enu_return_state_t {
     MOTOR_OK,   /**< Operation was successful. */
-    MOTOR_NOK   /**< Operation failed. */
+    MOTOR_NOK,  /**< Operation failed. */
+    MOTOR_FAULT /**< The motor was cut by the overcurrent guard and can't be driven until the fault is cleared. */
 } motor_enu_return_state_t;
 	
 
@@ -49,7 +61,8 @@ typedef enum motor_enu_return_state_t {
 /**
  * @brief Initialize a motor based on its configuration.
  *
- * This function initializes a motor by configuring its associated GPIO pins as outputs.
+ * This function initializes a motor by configuring its associated GPIO pins as outputs and
+ * attaching it to its Timer 1 compare unit. Timer 1 must be free running to generate the duty cycle.
  *
  * @param ptr_str_motor_config Pointer to the motor's configuration structure.
  * @return The return state of the motor initialization.
@@ -58,10 +71,35 @@ typedef enum motor_enu_return_state_t {
  */
 motor_enu_return_state_t MOTOR_INIT(const motor_str_config_t *ptr_str_motor_config);
 
+/**
+ * @brief Set the signed velocity of a motor.
+ *
+ * The velocity becomes the motor's target: MOTOR_ramp_tick() moves the driven velocity towards it
+ * with limited acceleration and jerk, scales it by the motor's gain and offset trims and generates it
+ * as a duty cycle from the motor's Timer 1 compare unit. Positive values turn the motor forward,
+ * negative values turn it backward and zero stops it (a reversal ramps through zero).
+ *
+ * @param ptr_str_motor_config Pointer to the motor's configuration structure.
+ * @param copy_s8_velocity Velocity in percent (-100 .. 100), values out of range are limited.
+ * @return The return state of setting the motor velocity.
+ *     - #MOTOR_OK: Motor velocity set successfully.
+ *     - #MOTOR_NOK: The motor is not initialized or its configuration is invalid.
+ *     - #MOTOR_FAULT: The motor was cut by the overcurrent guard, the velocity is ignored.
+ */
+motor_enu_return_state_t MOTOR_set_velocity(const motor_str_config_t *ptr_str_motor_config, sint8_t copy_s8_velocity);
+
+/**
+ * @brief Move every motor's velocity one step towards its target.
+ *
+ * This function must be called every MOTOR_RAMP_TICK_MS ms (usually from the system tick interrupt).
+ * Its cost is bounded: one constant-time ramp step per motor.
+ */
+void MOTOR_ramp_tick(void);
+
 /**
  * @brief Move the motor forward based on its configuration.
  *
- * This function moves the motor forward by setting its associated GPIO pins accordingly.
+ * This function moves the motor forward at full (trimmed) velocity.
  *
  * @param ptr_str_motor_config Pointer to the motor's configuration structure.
  * @return The return state of moving the motor forward.
@@ -73,7 +111,7 @@ motor_enu_return_state_t MOTOR_FORWARD(const motor_str_config_t* ptr_str_motor_c
 /**
  * @brief Move the motor backward based on its configuration.
  *
- * This function moves the motor backward by setting its associated GPIO pins accordingly.
+ * This function moves the motor backward at full (trimmed) velocity.
  *
  * @param ptr_str_motor_config Pointer to the motor's configuration structure.
  * @return The return state of moving the motor backward.
@@ -85,7 +123,7 @@ motor_enu_return_state_t MOTOR_BACKWARD(const motor_str_config_t* ptr_str_motor_
 /**
  * @brief Stop the motor based on its configuration.
  *
- * This function stops the motor by setting its associated GPIO pins accordingly.
+ * This function stops the motor at once by driving both control pins low, without a ramp (same as MOTOR_COAST()).
  *
  * @param ptr_str_motor_config Pointer to the motor's configuration structure.
  * @return The return state of stopping the motor.
@@ -94,6 +132,111 @@ motor_enu_return_state_t MOTOR_BACKWARD(const motor_str_config_t* ptr_str_motor_
  */
 motor_enu_return_state_t MOTOR_STOP(const motor_str_config_t* ptr_str_motor_config);
 
+/**
+ * @brief Let the motor coast to a stop.
+ *
+ * This function drives both control pins low at once, without a ramp. The motor spins down freely.
+ * If the motor was driven, the dead time runs before it can be driven again.
+ *
+ * @param ptr_str_motor_config Pointer to the motor's configuration structure.
+ * @return The return state of coasting the motor.
+ *     - #MOTOR_OK: Motor is coasting.
+ *     - #MOTOR_NOK: The motor is not initialized or its configuration is invalid.
+ */
+motor_enu_return_state_t MOTOR_COAST(const motor_str_config_t* ptr_str_motor_config);
+
+/**
+ * @brief Brake the motor actively.
+ *
+ * This function drives both control pins high at once, without a ramp. The H-bridge shorts the motor
+ * so its back EMF brakes it, which stops it much faster than coasting. The brake is held until the next command.
+ *
+ * @param ptr_str_motor_config Pointer to the motor's configuration structure.
+ * @return The return state of braking the motor.
+ *     - #MOTOR_OK: Motor is braking.
+ *     - #MOTOR_NOK: The motor is not initialized or its configuration is invalid.
+ */
+motor_enu_return_state_t MOTOR_BRAKE(const motor_str_config_t* ptr_str_motor_config);
+
+/**
+ * @brief Start the overcurrent guard on the analog comparator.
+ *
+ * The comparator watches the current shunt of one motor at a time against MOTOR_GUARD_REFERENCE.
+ * When the shunt voltage rises above it, the comparator interrupt drives both control pins of the watched
+ * motor low within microseconds and latches a fault on it. A shunt already above the reference when the guard
+ * switches to it is cut as well. Call it after the motors are initialized.
+ *
+ * @return The return state of starting the guard.
+ *     - #MOTOR_OK: Guard started successfully.
+ *     - #MOTOR_NOK: No initialized motor has a current shunt or the comparator setup failed.
+ */
+motor_enu_return_state_t MOTOR_guard_init(void);
+
+/**
+ * @brief Move the overcurrent guard to the next motor with a current shunt.
+ *
+ * This function must be called periodically (usually every 1 ms from the system tick interrupt),
+ * every watched motor then gets the comparator in turn. Each switch waits for the comparator to settle (about 2 us).
+ */
+void MOTOR_guard_tick(void);
+
+/**
+ * @brief Read the overcurrent fault latch of a motor.
+ *
+ * @param ptr_str_motor_config Pointer to the motor's configuration structure.
+ * @param ptr_u8_fault Pointer to store the fault latch (TRUE if the motor was cut).
+ * @return The return state of reading the fault.
+ *     - #MOTOR_OK: Fault read successfully.
+ *     - #MOTOR_NOK: The motor is not initialized or a pointer is NULL.
+ */
+motor_enu_return_state_t MOTOR_get_fault(const motor_str_config_t *ptr_str_motor_config, uint8_t *ptr_u8_fault);
+
+/**
+ * @brief Clear the overcurrent fault latch of a motor so it can be driven again.
+ *
+ * The motor restarts from zero velocity after the dead time.
+ *
+ * @param ptr_str_motor_config Pointer to the motor's configuration structure.
+ * @return The return state of clearing the fault.
+ *     - #MOTOR_OK: Fault cleared successfully.
+ *     - #MOTOR_NOK: The motor is not initialized or its configuration is invalid.
+ */
+motor_enu_return_state_t MOTOR_clear_fault(const motor_str_config_t *ptr_str_motor_config);
+
+/**
+ * @brief Read the velocity the ramp currently drives on a motor.
+ *
+ * The ramped velocity trails the target set by MOTOR_set_velocity() while the motor accelerates,
+ * a closed loop uses it to tell a rate-limited motor from a settled one.
+ *
+ * @param ptr_str_motor_config Pointer to the motor's configuration structure.
+ * @param ptr_s8_velocity Pointer to store the driven velocity in percent (-100 .. 100, rounded towards zero).
+ * @return The return state of reading the velocity.
+ *     - #MOTOR_OK: Velocity read successfully.
+ *     - #MOTOR_NOK: The motor is not initialized or a pointer is NULL.
+ */
+motor_enu_return_state_t MOTOR_get_velocity(const motor_str_config_t *ptr_str_motor_config, sint8_t *ptr_s8_velocity);
+
+/**
+ * @brief Read the overcurrent fault latches of all motors at once.
+ *
+ * @return One bit per Timer 1 compare unit (bit 0 = unit A), set while the motor on that unit is cut.
+ */
+uint8_t MOTOR_get_fault_mask(void);
+
+/**
+ * @brief Release a motor from the speed control so its pins can be written directly.
+ *
+ * This function stops the motor's PWM and parks its ramp at zero velocity without touching the pins.
+ * The next velocity or stop command takes the motor back and writes its pins again: a velocity command
+ * coasts the motor for the dead time first (its direction is unknown), then starts the ramp from zero.
+ *
+ * @param ptr_str_motor_config Pointer to the motor's configuration structure.
+ * @return The return state of releasing the motor.
+ *     - #MOTOR_OK: Motor released successfully.
+ *     - #MOTOR_NOK: The motor is not initialized or its configuration is invalid.
+ */
+motor_enu_return_state_t MOTOR_release(const motor_str_config_t *ptr_str_motor_config);
 
 
 
@@ -3,9 +3,20 @@
  * @brief MOTOR Module Implementation File
  *
  * This file contains the implementation of functions for controlling motors.
- * It includes functions to initialize, move forward, move backward, and stop motors
+ * It includes functions to initialize, set the velocity of, move forward, move backward, and stop motors
  * based on their configuration.
  *
+ * The duty cycle of every motor is generated by its own Timer 1 compare unit: the compare interrupt toggles
+ * the motor pins between the on and off phases and moves the compare value forward by the phase length,
+ * so the PWM period stays exact while Timer 1 is free running.
+ *
+ * Velocity commands are not applied at once: MOTOR_ramp_tick() moves every motor towards its target velocity
+ * in Q8 fixed point (1/256 percent) with limited acceleration and jerk (S-curve, or trapezoidal without jerk limit).
+ * A motor changing direction coasts for the dead time before it is driven the other way.
+ *
+ * The analog comparator watches the motors current shunts in turn: an overcurrent (or stall) cuts the motor
+ * straight from the comparator interrupt and latches a fault until the application clears it.
+ *
  * @note This file assumes that the MOTOR_interface.h and DIO_interface.h files are properly included.
  *
  * @date 2023-08-21
@@ -14,63 +25,749 @@
 
 
 #include "MOTOR_interface.h"
+#include "../../MCAL/AVR_ARCH/ISR_interface.h"
 
+/** @brief PWM states of a motor */
+#define MOTOR_PWM_STATE_IDLE	0	/**< Constant output (0% or 100% duty), compare interrupt disabled. */
+#define MOTOR_PWM_STATE_ON		1	/**< On phase, the next compare match starts the off phase. */
+#define MOTOR_PWM_STATE_OFF		2	/**< Off phase, the next compare match starts the on phase. */
 
-motor_enu_return_state_t MOTOR_INIT(const motor_str_config_t *ptr_str_motor_config)
+/** @brief Timer 1 counts left to a compare match scheduled after a delayed interrupt */
+#define MOTOR_PWM_LATE_CYCLES	64U
+
+/** @brief Velocity fixed point format (Q8: 1/256 percent) */
+#define MOTOR_Q8_SHIFT			8
+#define MOTOR_VELOCITY_MAX_Q8	((sint16_t)(MOTOR_VELOCITY_MAX_PERCENT << MOTOR_Q8_SHIFT))
+
+/** @brief Maximum velocity change per ramp tick (Q8) */
+#define MOTOR_RAMP_ACCEL_STEP	(((MOTOR_RAMP_ACCEL_PERCENT_PER_S << MOTOR_Q8_SHIFT) * MOTOR_RAMP_TICK_MS) / 1000UL)
+
+/** @brief Maximum acceleration change per ramp tick (Q8), a full step gives a trapezoidal profile */
+#if (MOTOR_RAMP_JERK_TIME_MS > MOTOR_RAMP_TICK_MS)
+#define MOTOR_RAMP_JERK_STEP	((MOTOR_RAMP_ACCEL_STEP * MOTOR_RAMP_TICK_MS) / MOTOR_RAMP_JERK_TIME_MS)
+#else
+#define MOTOR_RAMP_JERK_STEP	MOTOR_RAMP_ACCEL_STEP
+#endif
+
+/** @brief Dead time on direction change in ramp ticks (rounded up) */
+#define MOTOR_DEAD_TIME_TICKS	((MOTOR_DEAD_TIME_MS + MOTOR_RAMP_TICK_MS - 1) / MOTOR_RAMP_TICK_MS)
+
+#if (MOTOR_RAMP_JERK_STEP == 0)
+#error "MOTOR_RAMP_JERK_TIME_MS is too long for MOTOR_RAMP_ACCEL_PERCENT_PER_S"
+#endif
+
+/**
+ * @brief PWM state of a motor, shared between the API and the compare unit interrupt.
+ */
+typedef struct {
+	const motor_str_config_t *ptr_str_config;	/**< Motor attached to the compare unit (NULL if none). */
+	uint8_t  u8_pins_mask;						/**< Port mask of both control pins. */
+	uint8_t  u8_on_value;						/**< Pins value of the on phase (selects the direction). */
+	uint16_t u16_on_cycles;						/**< On phase length in Timer 1 counts. */
+	uint16_t u16_off_cycles;					/**< Off phase length in Timer 1 counts. */
+	uint16_t u16_next_compare;					/**< Timer 1 counter value of the next phase change. */
+	uint8_t  u8_state;							/**< Current PWM state. */
+	sint16_t s16_target;						/**< Target velocity (Q8 percent). */
+	sint16_t s16_velocity;						/**< Ramped velocity driven on the motor (Q8 percent). */
+	uint16_t u16_accel;							/**< Current ramp acceleration (Q8 percent per tick). */
+	sint8_t  s8_ramp_dir;						/**< Direction of the running ramp (-1, 0, 1). */
+	sint8_t  s8_drive_dir;						/**< Direction the motor was last driven in (-1, 0, 1). */
+	uint8_t  u8_dead_ticks;						/**< Ramp ticks left in the dead time (motor coasting). */
+	uint8_t  u8_fault;							/**< Overcurrent fault latch (TRUE while the motor is cut). */
+	uint8_t  u8_released;						/**< TRUE while the caller drives the pins, the next command takes them back. */
+} motor_str_pwm_t;
+
+static void MOTOR_pwm_phase(uint8_t u8_index);
+static void MOTOR_pwm_unit_a_handler(void);
+static void MOTOR_pwm_unit_b_handler(void);
+static uint16_t MOTOR_trim(const motor_str_config_t *ptr_str_motor_config, uint16_t u16_speed);
+static void MOTOR_apply_duty(uint8_t u8_index, uint8_t u8_on_value, uint16_t u16_on_cycles);
+static void MOTOR_apply_velocity(uint8_t u8_index);
+static void MOTOR_ramp_step(uint8_t u8_index);
+static motor_enu_return_state_t MOTOR_hold(const motor_str_config_t *ptr_str_motor_config, uint8_t u8_brake);
+static void MOTOR_guard_cut(uint8_t copy_u8_index);
+static void MOTOR_guard_check_level(void);
+static uint8_t MOTOR_is_attached(const motor_str_config_t *ptr_str_motor_config);
+
+/** @brief PWM state of every compare unit, indexed by timer_enu_compare_unit_t */
+static volatile motor_str_pwm_t gv_str_motor_pwm[MOTOR_MAX_NUM];
+
+/** @brief One bit per compare unit with a latched overcurrent fault */
+static volatile uint8_t gv_u8_fault_mask = U8_ZERO_VALUE;
+
+/** @brief Motor watched by the overcurrent guard, indexed by timer_enu_compare_unit_t */
+static volatile uint8_t gv_u8_guard_index = MOTOR_MAX_NUM;
+
+/** @brief Compare match handler of every compare unit, indexed by timer_enu_compare_unit_t */
+static const ptr_to_v_fun_in_void_t gc_ptr_motor_pwm_handler[MOTOR_MAX_NUM] = {
+	MOTOR_pwm_unit_a_handler,
+	MOTOR_pwm_unit_b_handler
+};
+
+
+/**
+ * @brief Switch a motor to its next PWM phase (called from the compare match interrupt).
+ *
+ * @param u8_index Compare unit of the motor.
+ */
+static void MOTOR_pwm_phase(uint8_t u8_index)
 {
+	volatile motor_str_pwm_t *ptr_str_pwm = &gv_str_motor_pwm[u8_index];
+	uint16_t u16_phase_cycles = U8_ZERO_VALUE;
+	uint16_t u16_timer_value = U8_ZERO_VALUE;
+
+	if (ptr_str_pwm->u8_state == MOTOR_PWM_STATE_ON)
+	{
+		DIO_write_port(ptr_str_pwm->ptr_str_config->port,ptr_str_pwm->u8_pins_mask,U8_ZERO_VALUE);
+		u16_phase_cycles = ptr_str_pwm->u16_off_cycles;
+		ptr_str_pwm->u8_state = MOTOR_PWM_STATE_OFF;
+	}
+	else if (ptr_str_pwm->u8_state == MOTOR_PWM_STATE_OFF)
+	{
+		DIO_write_port(ptr_str_pwm->ptr_str_config->port,ptr_str_pwm->u8_pins_mask,ptr_str_pwm->u8_on_value);
+		u16_phase_cycles = ptr_str_pwm->u16_on_cycles;
+		ptr_str_pwm->u8_state = MOTOR_PWM_STATE_ON;
+	}
+	else
+	{
+		// Idle motor, nothing to toggle
+	}
+
+	// Moving the compare value forward keeps the period exact whatever the interrupt latency is
+	ptr_str_pwm->u16_next_compare += u16_phase_cycles;
 	
-	dio_enu_return_state_t enu_return_state_pin_1 = DIO_init(ptr_str_motor_config->port,ptr_str_motor_config->pin_num1,DIO_PIN_OUTPUT);
-	dio_enu_return_state_t enu_return_state_pin_2 = DIO_init(ptr_str_motor_config->port,ptr_str_motor_config->pin_num2,DIO_PIN_OUTPUT);
-	if((enu_return_state_pin_1 == DIO_OK) && (enu_return_state_pin_2 == DIO_OK ))
+	// If another interrupt delayed this one past the end of the new phase, the match is already behind
+	// the counter and would only come back after a full Timer 1 wrap: schedule it right away instead
+	TIMER_MANGER_getValue(TIMER_1,&u16_timer_value);
+	if ((uint16_t)(ptr_str_pwm->u16_next_compare - u16_timer_value) > u16_phase_cycles)
+	{
+		ptr_str_pwm->u16_next_compare = u16_timer_value + MOTOR_PWM_LATE_CYCLES;
+	}
+	TIMER_MANGER_setCompareUnit((timer_enu_compare_unit_t)u8_index,ptr_str_pwm->u16_next_compare);
+}
+
+/**
+ * @brief Timer 1 compare unit A match handler.
+ */
+static void MOTOR_pwm_unit_a_handler(void)
+{
+	MOTOR_pwm_phase(TIMER_COMPARE_UNIT_A);
+}
+
+/**
+ * @brief Timer 1 compare unit B match handler.
+ */
+static void MOTOR_pwm_unit_b_handler(void)
+{
+	MOTOR_pwm_phase(TIMER_COMPARE_UNIT_B);
+}
+
+/**
+ * @brief Map a speed to the motor duty cycle using the motor's gain and offset trims.
+ *
+ * @param ptr_str_motor_config Pointer to the motor's configuration structure.
+ * @param u16_speed Speed in Q8 percent (0 .. 100 << 8).
+ * @return Duty cycle in Q8 percent (0 .. 100 << 8).
+ */
+static uint16_t MOTOR_trim(const motor_str_config_t *ptr_str_motor_config, uint16_t u16_speed)
+{
+	uint32_t u32_duty = U8_ZERO_VALUE;
+	uint8_t u8_offset = ptr_str_motor_config->u8_offset;
+
+	if (u8_offset > MOTOR_VELOCITY_MAX_PERCENT)
+	{
+		u8_offset = MOTOR_VELOCITY_MAX_PERCENT;
+	}
+
+	// A stopped motor stays stopped whatever the offset is
+	if (u16_speed != U8_ZERO_VALUE)
+	{
+		u32_duty = ((uint32_t)u16_speed * ptr_str_motor_config->u8_gain) / MOTOR_GAIN_NO_TRIM;
+		if (u32_duty > (uint32_t)MOTOR_VELOCITY_MAX_Q8)
+		{
+			u32_duty = MOTOR_VELOCITY_MAX_Q8;
+		}
+		u32_duty = ((uint32_t)u8_offset << MOTOR_Q8_SHIFT)
+				 + ((u32_duty * (MOTOR_VELOCITY_MAX_PERCENT - u8_offset)) / MOTOR_VELOCITY_MAX_PERCENT);
+	}
+
+	return (uint16_t)u32_duty;
+}
+
+/**
+ * @brief Load a new duty cycle and direction for a motor.
+ *
+ * A running PWM picks the new phase lengths at its next phase change. Duty cycles with a phase shorter than
+ * MOTOR_PWM_MIN_PULSE_CYCLES are driven as constant levels with the compare interrupt disabled.
+ *
+ * @param u8_index Compare unit of the motor.
+ * @param u8_on_value Pins value of the on phase.
+ * @param u16_on_cycles On phase length in Timer 1 counts (0 .. MOTOR_PWM_PERIOD_CYCLES).
+ */
+static void MOTOR_apply_duty(uint8_t u8_index, uint8_t u8_on_value, uint16_t u16_on_cycles)
+{
+	volatile motor_str_pwm_t *ptr_str_pwm = &gv_str_motor_pwm[u8_index];
+	uint16_t u16_timer_value = U8_ZERO_VALUE;
+	uint8_t u8_sreg;
+
+	if (u16_on_cycles < MOTOR_PWM_MIN_PULSE_CYCLES)
+	{
+		u16_on_cycles = U8_ZERO_VALUE;
+	}
+	else if (u16_on_cycles > (MOTOR_PWM_PERIOD_CYCLES - MOTOR_PWM_MIN_PULSE_CYCLES))
+	{
+		u16_on_cycles = MOTOR_PWM_PERIOD_CYCLES;
+	}
+	else
+	{
+		// Duty cycle can be generated
+	}
+
+	ISR_ENTER_CRITICAL(u8_sreg);
+	ptr_str_pwm->u8_on_value = u8_on_value;
+	ptr_str_pwm->u16_on_cycles = u16_on_cycles;
+	ptr_str_pwm->u16_off_cycles = MOTOR_PWM_PERIOD_CYCLES - u16_on_cycles;
+
+	if ((u16_on_cycles == U8_ZERO_VALUE) || (u16_on_cycles == MOTOR_PWM_PERIOD_CYCLES))
+	{
+		if (ptr_str_pwm->u8_state != MOTOR_PWM_STATE_IDLE)
+		{
+			TIMER_MANGER_compareUnitStop((timer_enu_compare_unit_t)u8_index);
+			ptr_str_pwm->u8_state = MOTOR_PWM_STATE_IDLE;
+		}
+		DIO_write_port(ptr_str_pwm->ptr_str_config->port,ptr_str_pwm->u8_pins_mask,
+					   (u16_on_cycles == U8_ZERO_VALUE) ? U8_ZERO_VALUE : u8_on_value);
+	}
+	else if (ptr_str_pwm->u8_state == MOTOR_PWM_STATE_IDLE)
+	{
+		// Start with an on phase right now, the first off phase starts after the on cycles
+		DIO_write_port(ptr_str_pwm->ptr_str_config->port,ptr_str_pwm->u8_pins_mask,u8_on_value);
+		TIMER_MANGER_getValue(TIMER_1,&u16_timer_value);
+		ptr_str_pwm->u16_next_compare = u16_timer_value + u16_on_cycles;
+		ptr_str_pwm->u8_state = MOTOR_PWM_STATE_ON;
+		TIMER_MANGER_compareUnitStart((timer_enu_compare_unit_t)u8_index,ptr_str_pwm->u16_next_compare);
+	}
+	else if (ptr_str_pwm->u8_state == MOTOR_PWM_STATE_ON)
 	{
-		return MOTOR_OK;
+		// Direction may change in the middle of the on phase
+		DIO_write_port(ptr_str_pwm->ptr_str_config->port,ptr_str_pwm->u8_pins_mask,u8_on_value);
 	}
 	else
 	{
-		return MOTOR_NOK;
+		// Off phase, the new direction is used from the next on phase
 	}
+	ISR_EXIT_CRITICAL(u8_sreg);
 }
 
-motor_enu_return_state_t MOTOR_FORWARD(const motor_str_config_t *ptr_str_motor_config)
+/**
+ * @brief Drive a motor with its ramped velocity.
+ *
+ * @param u8_index Compare unit of the motor.
+ */
+static void MOTOR_apply_velocity(uint8_t u8_index)
 {
-	dio_enu_return_state_t enu_return_state_pin_1 = DIO_write_pin(ptr_str_motor_config->port,ptr_str_motor_config->pin_num1,DIO_PIN_HIGH_LEVEL);
-	dio_enu_return_state_t enu_return_state_pin_2 = DIO_write_pin(ptr_str_motor_config->port,ptr_str_motor_config->pin_num2,DIO_PIN_LOW_LEVEL);
-	if((enu_return_state_pin_1 == DIO_OK) && (enu_return_state_pin_2 == DIO_OK))
-	{   
-		return MOTOR_OK;
+	volatile motor_str_pwm_t *ptr_str_pwm = &gv_str_motor_pwm[u8_index];
+	const motor_str_config_t *ptr_str_motor_config = ptr_str_pwm->ptr_str_config;
+	sint16_t s16_velocity = ptr_str_pwm->s16_velocity;
+	uint8_t u8_on_value;
+	uint16_t u16_speed;
+	uint16_t u16_on_cycles;
+
+	// Pin 1 high drives the motor forward, pin 2 high drives it backward
+	if (s16_velocity < 0)
+	{
+		u16_speed = (uint16_t)(-s16_velocity);
+		u8_on_value = (uint8_t)(U8_ONE_VALUE << ptr_str_motor_config->pin_num2);
 	}
 	else
 	{
-		return MOTOR_NOK;
+		u16_speed = (uint16_t)s16_velocity;
+		u8_on_value = (uint8_t)(U8_ONE_VALUE << ptr_str_motor_config->pin_num1);
 	}
+
+	u16_on_cycles = (uint16_t)(((uint32_t)MOTOR_trim(ptr_str_motor_config,u16_speed) * MOTOR_PWM_PERIOD_CYCLES) / (uint32_t)MOTOR_VELOCITY_MAX_Q8);
+	MOTOR_apply_duty(u8_index,u8_on_value,u16_on_cycles);
 }
 
-motor_enu_return_state_t MOTOR_BACKWARD(const motor_str_config_t *ptr_str_motor_config)
+/**
+ * @brief Move the velocity of a motor one tick towards its target.
+ *
+ * The acceleration grows by the jerk step up to the acceleration limit and shrinks again when the remaining
+ * velocity error is within the distance needed to bring the acceleration back down, so the target is reached
+ * without overshoot. A step that changes the motor direction (through or across zero) stops at zero and
+ * coasts the motor for the dead time first. The cost is constant per tick.
+ *
+ * @param u8_index Compare unit of the motor.
+ */
+static void MOTOR_ramp_step(uint8_t u8_index)
 {
-	dio_enu_return_state_t enu_return_state_pin_1 = DIO_write_pin(ptr_str_motor_config->port,ptr_str_motor_config->pin_num1,DIO_PIN_LOW_LEVEL);
-	dio_enu_return_state_t enu_return_state_pin_2 = DIO_write_pin(ptr_str_motor_config->port,ptr_str_motor_config->pin_num2,DIO_PIN_HIGH_LEVEL);
-	
-	if((enu_return_state_pin_1==DIO_OK) && (enu_return_state_pin_2 == DIO_OK))
-	{    
-		return MOTOR_OK;
+	volatile motor_str_pwm_t *ptr_str_pwm = &gv_str_motor_pwm[u8_index];
+	sint16_t s16_error = ptr_str_pwm->s16_target - ptr_str_pwm->s16_velocity;
+	sint8_t s8_dir = (s16_error < 0) ? -1 : 1;
+	uint16_t u16_error = (s16_error < 0) ? (uint16_t)(-s16_error) : (uint16_t)s16_error;
+	uint16_t u16_accel = ptr_str_pwm->u16_accel;
+	uint16_t u16_step;
+	sint16_t s16_velocity;
+
+	if (ptr_str_pwm->u8_fault == TRUE)
+	{
+		// Cut motor stays at zero until the fault is cleared
+	}
+	else if (ptr_str_pwm->u8_dead_ticks != U8_ZERO_VALUE)
+	{
+		// Keep coasting until the dead time is over
+		ptr_str_pwm->u8_dead_ticks--;
+	}
+	else if (u16_error == U8_ZERO_VALUE)
+	{
+		ptr_str_pwm->u16_accel = U8_ZERO_VALUE;
+		ptr_str_pwm->s8_ramp_dir = U8_ZERO_VALUE;
 	}
 	else
 	{
-		return MOTOR_NOK;
+		// Target moved to the other side, build the acceleration up again from zero
+		if (s8_dir != ptr_str_pwm->s8_ramp_dir)
+		{
+			u16_accel = U8_ZERO_VALUE;
+			ptr_str_pwm->s8_ramp_dir = s8_dir;
+		}
+
+		// Remaining error needed to bring the acceleration back down is a(a + j) / 2j
+		if ((uint32_t)u16_error <= (((uint32_t)u16_accel * (u16_accel + MOTOR_RAMP_JERK_STEP)) / (2U * MOTOR_RAMP_JERK_STEP)))
+		{
+			u16_accel = (u16_accel > (2U * MOTOR_RAMP_JERK_STEP)) ? (u16_accel - MOTOR_RAMP_JERK_STEP) : MOTOR_RAMP_JERK_STEP;
+		}
+		else if (u16_accel < MOTOR_RAMP_ACCEL_STEP)
+		{
+			u16_accel += MOTOR_RAMP_JERK_STEP;
+			if (u16_accel > MOTOR_RAMP_ACCEL_STEP)
+			{
+				u16_accel = MOTOR_RAMP_ACCEL_STEP;
+			}
+		}
+		else
+		{
+			// Cruise at the acceleration limit
+		}
+
+		u16_step = (u16_accel < u16_error) ? u16_accel : u16_error;
+		s16_velocity = ptr_str_pwm->s16_velocity + ((s8_dir < 0) ? -(sint16_t)u16_step : (sint16_t)u16_step);
+
+		if (s16_velocity == 0)
+		{
+			// Passing through zero, the dead time starts with the next direction change
+		}
+		else if ((ptr_str_pwm->s8_drive_dir != 0) && (ptr_str_pwm->s8_drive_dir != ((s16_velocity < 0) ? -1 : 1)))
+		{
+			// Direction change: coast for the dead time, then build up the acceleration again from zero
+			s16_velocity = U8_ZERO_VALUE;
+			u16_accel = U8_ZERO_VALUE;
+			ptr_str_pwm->s8_drive_dir = U8_ZERO_VALUE;
+			ptr_str_pwm->u8_dead_ticks = MOTOR_DEAD_TIME_TICKS;
+		}
+		else
+		{
+			ptr_str_pwm->s8_drive_dir = (s16_velocity < 0) ? -1 : 1;
+		}
+
+		ptr_str_pwm->u16_accel = u16_accel;
+		ptr_str_pwm->s16_velocity = s16_velocity;
+		MOTOR_apply_velocity(u8_index);
 	}
 }
 
-motor_enu_return_state_t MOTOR_STOP(const motor_str_config_t *ptr_str_motor_config)
+/**
+ * @brief Check that a motor configuration is attached to its compare unit.
+ *
+ * @param ptr_str_motor_config Pointer to the motor's configuration structure.
+ * @return TRUE if the motor is initialized, FALSE otherwise.
+ */
+static uint8_t MOTOR_is_attached(const motor_str_config_t *ptr_str_motor_config)
 {
-	dio_enu_return_state_t enu_return_state_pin_1 = DIO_write_pin(ptr_str_motor_config->port,ptr_str_motor_config->pin_num1,DIO_PIN_LOW_LEVEL);
-	dio_enu_return_state_t enu_return_state_pin_2 = DIO_write_pin(ptr_str_motor_config->port,ptr_str_motor_config->pin_num2,DIO_PIN_LOW_LEVEL);
-	
-	if( (enu_return_state_pin_1 == DIO_OK) && (enu_return_state_pin_2 == DIO_OK))
-	{   
-		return MOTOR_OK;
+	uint8_t u8_attached = FALSE;
+
+	if ((ptr_str_motor_config != NULL) && (ptr_str_motor_config->enu_pwm_unit < MOTOR_MAX_NUM)
+		&& (gv_str_motor_pwm[ptr_str_motor_config->enu_pwm_unit].ptr_str_config == ptr_str_motor_config))
+	{
+		u8_attached = TRUE;
+	}
+	return u8_attached;
+}
+
+/**
+ * @brief Cut a motor on overcurrent and latch its fault.
+ *
+ * @param copy_u8_index Compare unit of the motor.
+ */
+static void MOTOR_guard_cut(uint8_t copy_u8_index)
+{
+	volatile motor_str_pwm_t *ptr_str_pwm = &gv_str_motor_pwm[copy_u8_index];
+
+	if (ptr_str_pwm->ptr_str_config != NULL)
+	{
+		// Pins first, bookkeeping after
+		DIO_write_port(ptr_str_pwm->ptr_str_config->port,ptr_str_pwm->u8_pins_mask,U8_ZERO_VALUE);
+		TIMER_MANGER_compareUnitStop((timer_enu_compare_unit_t)copy_u8_index);
+		ptr_str_pwm->u8_state = MOTOR_PWM_STATE_IDLE;
+		ptr_str_pwm->u16_on_cycles = U8_ZERO_VALUE;
+		ptr_str_pwm->u16_off_cycles = MOTOR_PWM_PERIOD_CYCLES;
+		ptr_str_pwm->s16_target = U8_ZERO_VALUE;
+		ptr_str_pwm->s16_velocity = U8_ZERO_VALUE;
+		ptr_str_pwm->u16_accel = U8_ZERO_VALUE;
+		ptr_str_pwm->s8_ramp_dir = U8_ZERO_VALUE;
+		ptr_str_pwm->s8_drive_dir = U8_ZERO_VALUE;
+		ptr_str_pwm->u8_dead_ticks = MOTOR_DEAD_TIME_TICKS;
+		ptr_str_pwm->u8_fault = TRUE;
+		ptr_str_pwm->u8_released = FALSE;
+		gv_u8_fault_mask |= (uint8_t)(U8_ONE_VALUE << copy_u8_index);
+	}
+}
+
+/**
+ * @brief Cut the watched motor if its shunt is above the reference right now.
+ *
+ * Also the analog comparator handler: the output is read again so a glitch from switching the comparator
+ * input doesn't trip the guard. The interrupt only sees a crossing, a current already above the reference
+ * when its shunt is switched in raises no edge, so the level is checked after every switch as well.
+ */
+static void MOTOR_guard_check_level(void)
+{
+	uint8_t u8_output = U8_ONE_VALUE;
+	uint8_t u8_index = gv_u8_guard_index;
+
+	ANA_COMP_get_output(&u8_output);
+
+	// Output low: the shunt voltage is above the reference
+	if ((u8_output == U8_ZERO_VALUE) && (u8_index < MOTOR_MAX_NUM))
+	{
+		MOTOR_guard_cut(u8_index);
+	}
+}
+
+/**
+ * @brief Stop a motor at once, bypassing the ramp.
+ *
+ * @param ptr_str_motor_config Pointer to the motor's configuration structure.
+ * @param u8_brake TRUE to short the motor (both control pins high), FALSE to let it coast (both pins low).
+ * @return MOTOR_OK, or MOTOR_NOK if the motor is not initialized.
+ */
+static motor_enu_return_state_t MOTOR_hold(const motor_str_config_t *ptr_str_motor_config, uint8_t u8_brake)
+{
+	motor_enu_return_state_t enu_return_state = MOTOR_OK;
+	volatile motor_str_pwm_t *ptr_str_pwm;
+	uint8_t u8_sreg;
+
+	if (MOTOR_is_attached(ptr_str_motor_config) == FALSE)
+	{
+		enu_return_state = MOTOR_NOK;
+	}
+	else
+	{
+		ptr_str_pwm = &gv_str_motor_pwm[ptr_str_motor_config->enu_pwm_unit];
+		ISR_ENTER_CRITICAL(u8_sreg);
+		ptr_str_pwm->s16_target = U8_ZERO_VALUE;
+		ptr_str_pwm->s16_velocity = U8_ZERO_VALUE;
+		ptr_str_pwm->u16_accel = U8_ZERO_VALUE;
+		ptr_str_pwm->s8_ramp_dir = U8_ZERO_VALUE;
+		if (u8_brake == TRUE)
+		{
+			// Shorted motor stops fast, it can be driven either way right after
+			MOTOR_apply_duty(ptr_str_motor_config->enu_pwm_unit,ptr_str_pwm->u8_pins_mask,MOTOR_PWM_PERIOD_CYCLES);
+			ptr_str_pwm->u8_dead_ticks = U8_ZERO_VALUE;
+		}
+		else
+		{
+			// Coasting motor gets the dead time if it was driven, whatever direction comes next
+			MOTOR_apply_duty(ptr_str_motor_config->enu_pwm_unit,U8_ZERO_VALUE,U8_ZERO_VALUE);
+			ptr_str_pwm->u8_dead_ticks = ((ptr_str_pwm->s8_drive_dir != 0) || (ptr_str_pwm->u8_released == TRUE))
+										 ? MOTOR_DEAD_TIME_TICKS : U8_ZERO_VALUE;
+		}
+		ptr_str_pwm->s8_drive_dir = U8_ZERO_VALUE;
+		ptr_str_pwm->u8_released = FALSE;
+		ISR_EXIT_CRITICAL(u8_sreg);
+	}
+	return enu_return_state;
+}
+
+motor_enu_return_state_t MOTOR_INIT(const motor_str_config_t *ptr_str_motor_config)
+{
+	motor_enu_return_state_t enu_return_state = MOTOR_OK;
+	dio_enu_return_state_t enu_return_state_pin_1;
+	dio_enu_return_state_t enu_return_state_pin_2;
+	volatile motor_str_pwm_t *ptr_str_pwm;
+
+	if ((ptr_str_motor_config == NULL) || (ptr_str_motor_config->enu_pwm_unit >= MOTOR_MAX_NUM))
+	{
+		enu_return_state = MOTOR_NOK;
+	}
+	else
+	{
+		enu_return_state_pin_1 = DIO_init(ptr_str_motor_config->port,ptr_str_motor_config->pin_num1,DIO_PIN_OUTPUT);
+		enu_return_state_pin_2 = DIO_init(ptr_str_motor_config->port,ptr_str_motor_config->pin_num2,DIO_PIN_OUTPUT);
+		if((enu_return_state_pin_1 == DIO_OK) && (enu_return_state_pin_2 == DIO_OK ))
+		{
+			// Attach the motor to its compare unit, the PWM starts with the first non constant duty cycle
+			ptr_str_pwm = &gv_str_motor_pwm[ptr_str_motor_config->enu_pwm_unit];
+			TIMER_MANGER_compareUnitStop(ptr_str_motor_config->enu_pwm_unit);
+			ptr_str_pwm->ptr_str_config = ptr_str_motor_config;
+			ptr_str_pwm->u8_pins_mask = (uint8_t)((U8_ONE_VALUE << ptr_str_motor_config->pin_num1) | (U8_ONE_VALUE << ptr_str_motor_config->pin_num2));
+			ptr_str_pwm->u8_state = MOTOR_PWM_STATE_IDLE;
+			ptr_str_pwm->s16_target = U8_ZERO_VALUE;
+			ptr_str_pwm->s16_velocity = U8_ZERO_VALUE;
+			ptr_str_pwm->u16_accel = U8_ZERO_VALUE;
+			ptr_str_pwm->s8_ramp_dir = U8_ZERO_VALUE;
+			ptr_str_pwm->s8_drive_dir = U8_ZERO_VALUE;
+			ptr_str_pwm->u8_dead_ticks = U8_ZERO_VALUE;
+			ptr_str_pwm->u8_fault = FALSE;
+			ptr_str_pwm->u8_released = FALSE;
+			if (TIMER_MANGER_compareUnitInit(ptr_str_motor_config->enu_pwm_unit,gc_ptr_motor_pwm_handler[ptr_str_motor_config->enu_pwm_unit]) != TIMERM_E_OK)
+			{
+				enu_return_state = MOTOR_NOK;
+			}
+			MOTOR_apply_duty(ptr_str_motor_config->enu_pwm_unit,U8_ZERO_VALUE,U8_ZERO_VALUE);
+		}
+		else
+		{
+			enu_return_state = MOTOR_NOK;
+		}
+	}
+	return enu_return_state;
+}
+
+motor_enu_return_state_t MOTOR_set_velocity(const motor_str_config_t *ptr_str_motor_config, sint8_t copy_s8_velocity)
+{
+	motor_enu_return_state_t enu_return_state = MOTOR_OK;
+	volatile motor_str_pwm_t *ptr_str_pwm;
+	sint16_t s16_target;
+	uint8_t u8_sreg;
+
+	if (MOTOR_is_attached(ptr_str_motor_config) == FALSE)
+	{
+		enu_return_state = MOTOR_NOK;
+	}
+	else if (gv_str_motor_pwm[ptr_str_motor_config->enu_pwm_unit].u8_fault == TRUE)
+	{
+		enu_return_state = MOTOR_FAULT;
+	}
+	else
+	{
+		if (copy_s8_velocity > MOTOR_VELOCITY_MAX_PERCENT)
+		{
+			copy_s8_velocity = MOTOR_VELOCITY_MAX_PERCENT;
+		}
+		else if (copy_s8_velocity < -MOTOR_VELOCITY_MAX_PERCENT)
+		{
+			copy_s8_velocity = -MOTOR_VELOCITY_MAX_PERCENT;
+		}
+		else
+		{
+			// Velocity in range
+		}
+		s16_target = (sint16_t)((sint16_t)copy_s8_velocity * (1 << MOTOR_Q8_SHIFT));
+
+		// The ramp tick reads the target from the interrupt, write it atomically
+		ISR_ENTER_CRITICAL(u8_sreg);
+		ptr_str_pwm = &gv_str_motor_pwm[ptr_str_motor_config->enu_pwm_unit];
+		if (ptr_str_pwm->u8_released == TRUE)
+		{
+			// Taken back from the caller: its pins may drive either way, coast for the dead time first
+			MOTOR_apply_duty(ptr_str_motor_config->enu_pwm_unit,U8_ZERO_VALUE,U8_ZERO_VALUE);
+			ptr_str_pwm->u8_dead_ticks = MOTOR_DEAD_TIME_TICKS;
+			ptr_str_pwm->u8_released = FALSE;
+		}
+		ptr_str_pwm->s16_target = s16_target;
+		ISR_EXIT_CRITICAL(u8_sreg);
+	}
+	return enu_return_state;
+}
+
+void MOTOR_ramp_tick(void)
+{
+	for (uint8_t u8_index = U8_ZERO_VALUE ; u8_index < MOTOR_MAX_NUM ; u8_index++)
+	{
+		if (gv_str_motor_pwm[u8_index].ptr_str_config != NULL)
+		{
+			MOTOR_ramp_step(u8_index);
+		}
+	}
+}
+
+motor_enu_return_state_t MOTOR_guard_init(void)
+{
+	motor_enu_return_state_t enu_return_state = MOTOR_NOK;
+	ana_comp_str_config_t str_ana_comp_config;
+
+	// Start with the first motor that has a current shunt
+	gv_u8_guard_index = MOTOR_MAX_NUM;
+	for (uint8_t u8_index = U8_ZERO_VALUE ; u8_index < MOTOR_MAX_NUM ; u8_index++)
+	{
+		if ((gv_str_motor_pwm[u8_index].ptr_str_config != NULL)
+			&& (gv_str_motor_pwm[u8_index].ptr_str_config->enu_sense_input < ANA_COMP_NEG_INVALID))
+		{
+			gv_u8_guard_index = u8_index;
+			break;
+		}
+	}
+
+	if (gv_u8_guard_index < MOTOR_MAX_NUM)
+	{
+		str_ana_comp_config.enu_positive_input = MOTOR_GUARD_REFERENCE;
+		str_ana_comp_config.enu_negative_input = gv_str_motor_pwm[gv_u8_guard_index].ptr_str_config->enu_sense_input;
+		str_ana_comp_config.enu_edge = ANA_COMP_FALLING_EDGE;
+		if ((ANA_COMP_init(&str_ana_comp_config) == ANA_COMP_OK) && (ANA_COMP_set_callback(MOTOR_guard_check_level) == ANA_COMP_OK))
+		{
+			MOTOR_guard_check_level();
+			ANA_COMP_enable_interrupt();
+			enu_return_state = MOTOR_OK;
+		}
+	}
+	return enu_return_state;
+}
+
+void MOTOR_guard_tick(void)
+{
+	uint8_t u8_index = gv_u8_guard_index;
+	const motor_str_config_t *ptr_str_motor_config;
+
+	if (u8_index < MOTOR_MAX_NUM)
+	{
+		// Next motor with a current shunt, the current one again if it is the only one
+		for (uint8_t u8_count = U8_ZERO_VALUE ; u8_count < MOTOR_MAX_NUM ; u8_count++)
+		{
+			u8_index = (uint8_t)((u8_index + U8_ONE_VALUE) % MOTOR_MAX_NUM);
+			ptr_str_motor_config = gv_str_motor_pwm[u8_index].ptr_str_config;
+			if ((ptr_str_motor_config != NULL) && (ptr_str_motor_config->enu_sense_input < ANA_COMP_NEG_INVALID))
+			{
+				break;
+			}
+		}
+
+		if (u8_index != gv_u8_guard_index)
+		{
+			// The handler must never see the new input with the old motor index
+			ANA_COMP_disable_interrupt();
+			gv_u8_guard_index = u8_index;
+			ANA_COMP_select_negative_input(gv_str_motor_pwm[u8_index].ptr_str_config->enu_sense_input);
+			MOTOR_guard_check_level();
+			ANA_COMP_enable_interrupt();
+		}
+	}
+}
+
+motor_enu_return_state_t MOTOR_get_fault(const motor_str_config_t *ptr_str_motor_config, uint8_t *ptr_u8_fault)
+{
+	motor_enu_return_state_t enu_return_state = MOTOR_OK;
+
+	if ((MOTOR_is_attached(ptr_str_motor_config) == FALSE) || (ptr_u8_fault == NULL))
+	{
+		enu_return_state = MOTOR_NOK;
+	}
+	else
+	{
+		*ptr_u8_fault = gv_str_motor_pwm[ptr_str_motor_config->enu_pwm_unit].u8_fault;
+	}
+	return enu_return_state;
+}
+
+motor_enu_return_state_t MOTOR_clear_fault(const motor_str_config_t *ptr_str_motor_config)
+{
+	motor_enu_return_state_t enu_return_state = MOTOR_OK;
+	uint8_t u8_sreg;
+
+	if (MOTOR_is_attached(ptr_str_motor_config) == FALSE)
+	{
+		enu_return_state = MOTOR_NOK;
 	}
 	else
 	{
-		return MOTOR_NOK;
+		// Ramp state was reset when the motor was cut, it restarts from zero after the dead time
+		ISR_ENTER_CRITICAL(u8_sreg);
+		gv_str_motor_pwm[ptr_str_motor_config->enu_pwm_unit].u8_fault = FALSE;
+		gv_u8_fault_mask &= (uint8_t)~(U8_ONE_VALUE << ptr_str_motor_config->enu_pwm_unit);
+		ISR_EXIT_CRITICAL(u8_sreg);
 	}
-}
\ No newline at end of file
+	return enu_return_state;
+}
+
+motor_enu_return_state_t MOTOR_get_velocity(const motor_str_config_t *ptr_str_motor_config, sint8_t *ptr_s8_velocity)
+{
+	motor_enu_return_state_t enu_return_state = MOTOR_OK;
+	sint16_t s16_velocity;
+	uint8_t u8_sreg;
+
+	if ((MOTOR_is_attached(ptr_str_motor_config) == FALSE) || (ptr_s8_velocity == NULL))
+	{
+		enu_return_state = MOTOR_NOK;
+	}
+	else
+	{
+		// 16-bit velocity updated by the ramp tick, read it atomically
+		ISR_ENTER_CRITICAL(u8_sreg);
+		s16_velocity = gv_str_motor_pwm[ptr_str_motor_config->enu_pwm_unit].s16_velocity;
+		ISR_EXIT_CRITICAL(u8_sreg);
+		*ptr_s8_velocity = (sint8_t)(s16_velocity / (1 << MOTOR_Q8_SHIFT));
+	}
+	return enu_return_state;
+}
+
+uint8_t MOTOR_get_fault_mask(void)
+{
+	return gv_u8_fault_mask;
+}
+
+motor_enu_return_state_t MOTOR_release(const motor_str_config_t *ptr_str_motor_config)
+{
+	motor_enu_return_state_t enu_return_state = MOTOR_OK;
+	volatile motor_str_pwm_t *ptr_str_pwm;
+	uint8_t u8_sreg;
+
+	if (MOTOR_is_attached(ptr_str_motor_config) == FALSE)
+	{
+		enu_return_state = MOTOR_NOK;
+	}
+	else
+	{
+		// Stop the PWM and park the ramp at zero, the pins keep their level for the caller
+		ptr_str_pwm = &gv_str_motor_pwm[ptr_str_motor_config->enu_pwm_unit];
+		ISR_ENTER_CRITICAL(u8_sreg);
+		if (ptr_str_pwm->u8_state != MOTOR_PWM_STATE_IDLE)
+		{
+			TIMER_MANGER_compareUnitStop(ptr_str_motor_config->enu_pwm_unit);
+			ptr_str_pwm->u8_state = MOTOR_PWM_STATE_IDLE;
+		}
+		ptr_str_pwm->s16_target = U8_ZERO_VALUE;
+		ptr_str_pwm->s16_velocity = U8_ZERO_VALUE;
+		ptr_str_pwm->u16_accel = U8_ZERO_VALUE;
+		ptr_str_pwm->s8_ramp_dir = U8_ZERO_VALUE;
+		ptr_str_pwm->s8_drive_dir = U8_ZERO_VALUE;
+		ptr_str_pwm->u8_dead_ticks = U8_ZERO_VALUE;
+		ptr_str_pwm->u8_released = TRUE;
+		ISR_EXIT_CRITICAL(u8_sreg);
+	}
+	return enu_return_state;
+}
+
+motor_enu_return_state_t MOTOR_FORWARD(const motor_str_config_t *ptr_str_motor_config)
+{
+	return MOTOR_set_velocity(ptr_str_motor_config,MOTOR_VELOCITY_MAX_PERCENT);
+}
+
+motor_enu_return_state_t MOTOR_BACKWARD(const motor_str_config_t *ptr_str_motor_config)
+{
+	return MOTOR_set_velocity(ptr_str_motor_config,-MOTOR_VELOCITY_MAX_PERCENT);
+}
+
+motor_enu_return_state_t MOTOR_STOP(const motor_str_config_t *ptr_str_motor_config)
+{
+	return MOTOR_hold(ptr_str_motor_config,FALSE);
+}
+
+motor_enu_return_state_t MOTOR_COAST(const motor_str_config_t *ptr_str_motor_config)
+{
+	return MOTOR_hold(ptr_str_motor_config,FALSE);
+}
+
+motor_enu_return_state_t MOTOR_BRAKE(const motor_str_config_t *ptr_str_motor_config)
+{
+	return MOTOR_hold(ptr_str_motor_config,TRUE);
+}
@@ -0,0 +1,29 @@
+/**
+ * @file ODOMETRY_config.h
+ * @brief Odometry Configuration Header File
+ *
+ * This header file defines the car geometry used by the dead-reckoning odometry.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef ODOMETRY_CONFIG_H_
+#define ODOMETRY_CONFIG_H_
+
+/**
+ * @brief Wheel diameter in mm.
+ */
+#define ODOMETRY_WHEEL_DIAMETER_MM    65UL
+
+/**
+ * @brief Distance between the left and right wheel contact points in mm.
+ */
+#define ODOMETRY_WHEEL_BASE_MM    130UL
+
+/**
+ * @brief Counted encoder edges per wheel revolution.
+ */
+#define ODOMETRY_EDGES_PER_REV    ENCODER_EDGES_PER_REV
+
+#endif /* ODOMETRY_CONFIG_H_ */
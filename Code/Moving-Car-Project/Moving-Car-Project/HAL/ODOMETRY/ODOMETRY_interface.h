@@ -0,0 +1,98 @@
+/**
+ * @file ODOMETRY_interface.h
+ * @brief Odometry Interface Header File
+ *
+ * This header file defines the interface of the dead-reckoning odometry: the wheel encoder edges
+ * are integrated into the pose of the car (position and heading) with fixed point math.
+ *
+ * The pose starts at x = 0, y = 0, heading = 0, x along the initial heading and y to its left.
+ * Headings are binary angles: the full turn is 65536, so they wrap around for free in uint16_t.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef ODOMETRY_INTERFACE_H_
+#define ODOMETRY_INTERFACE_H_
+
+#include "../../STD_LIB/std_types.h"
+#include "../ENCODER/ENCODER_config.h"
+#include "ODOMETRY_config.h"
+
+/** @brief Binary angle of a quarter turn (90 degrees) */
+#define ODOMETRY_QUARTER_TURN    0x4000U
+
+/** @brief Convert degrees to a binary angle (65536 / 360 = 182.04) */
+#define ODOMETRY_DEG_TO_ANGLE(deg)    ((uint16_t)(((sint32_t)(deg) * 65536L) / 360L))
+
+/** @brief Convert mm to the Q8 distance unit of the pose */
+#define ODOMETRY_MM_TO_Q8(mm)    ((uint32_t)(mm) * 256UL)
+
+
+/**
+ * @brief Pose of the car.
+ */
+typedef struct {
+    sint32_t s32_x;          /**< X position in 1/256 mm (Q8). */
+    sint32_t s32_y;          /**< Y position in 1/256 mm (Q8). */
+    uint16_t u16_heading;    /**< Heading, binary angle counterclockwise from the initial heading. */
+    uint32_t u32_distance;   /**< Path length travelled by the car center in 1/256 mm (Q8), always growing. */
+} odometry_str_pose_t;
+
+
+/**
+ * @brief Reset the pose to the origin.
+ */
+void ODOMETRY_reset(void);
+
+/**
+ * @brief Integrate one update period of wheel motion into the pose.
+ *
+ * The car center moves by the mean of the wheel distances along the heading at mid period, the heading
+ * turns by the wheel distance difference over the wheel base. The cost is constant: two table lookups
+ * with interpolation and a few 32-bit multiplies, whatever the motion. Keep the updates frequent enough for
+ * at most 32 edges per wheel, so the heading change stays within 32 bits.
+ *
+ * @param copy_s16_left_edges Encoder edges of the left wheel since the last update (negative backward).
+ * @param copy_s16_right_edges Encoder edges of the right wheel since the last update (negative backward).
+ */
+void ODOMETRY_update(sint16_t copy_s16_left_edges, sint16_t copy_s16_right_edges);
+
+/**
+ * @brief Read the pose of the car.
+ *
+ * @param ptr_str_pose Pointer to store the pose.
+ */
+void ODOMETRY_get_pose(odometry_str_pose_t *ptr_str_pose);
+
+/**
+ * @brief Read the heading of the car.
+ *
+ * @return Heading, binary angle counterclockwise from the initial heading.
+ */
+uint16_t ODOMETRY_get_heading(void);
+
+/**
+ * @brief Read the path length travelled by the car.
+ *
+ * @return Path length in mm.
+ */
+uint32_t ODOMETRY_get_distance_mm(void);
+
+/**
+ * @brief Sine of a binary angle from a quarter wave lookup table with linear interpolation.
+ *
+ * @param copy_u16_angle The angle (65536 = full turn).
+ * @return The sine in Q14 (16384 = 1.0).
+ */
+sint16_t ODOMETRY_sin(uint16_t copy_u16_angle);
+
+/**
+ * @brief Cosine of a binary angle, see ODOMETRY_sin().
+ *
+ * @param copy_u16_angle The angle (65536 = full turn).
+ * @return The cosine in Q14 (16384 = 1.0).
+ */
+sint16_t ODOMETRY_cos(uint16_t copy_u16_angle);
+
+#endif /* ODOMETRY_INTERFACE_H_ */
@@ -0,0 +1,164 @@
+/**
+ * @file ODOMETRY_prog.c
+ * @brief Odometry Implementation File
+ *
+ * This file implements the dead-reckoning odometry with integer math only: distances in Q8 mm,
+ * sine and cosine in Q14 from a quarter wave table and the heading in a 32-bit binary angle
+ * whose upper 16 bits are the reported heading, so small turns are never rounded away.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "ODOMETRY_interface.h"
+#include "../../STD_LIB/bit_math.h"
+#include "../../MCAL/AVR_ARCH/ISR_interface.h"
+
+/** @brief Q14 fixed point one (sine and cosine) */
+#define ODOMETRY_Q14_ONE			16384L
+
+/** @brief Quarter wave table: 64 steps of 256 binary angle units */
+#define ODOMETRY_TABLE_STEPS		64U
+#define ODOMETRY_TABLE_SHIFT		8
+#define ODOMETRY_QUARTER_MASK		0x3FFFU
+#define ODOMETRY_HALF_TURN			0x8000U
+
+/** @brief Wheel travel of one encoder edge in Q8 mm (pi * 256 = 804.25) */
+#define ODOMETRY_EDGE_Q8			((ODOMETRY_WHEEL_DIAMETER_MM * 80425UL) / (100UL * ODOMETRY_EDGES_PER_REV))
+
+/** @brief Heading change (32-bit binary angle) per Q8 mm of wheel distance difference: 2^32 / (2 pi base 256) */
+#define ODOMETRY_TURN_SCALE			(2670177UL / ODOMETRY_WHEEL_BASE_MM)
+
+/** @brief sin(i * 90 / 64 degrees) in Q14 for i = 0 .. 64 */
+static const sint16_t gc_s16_sin_table[ODOMETRY_TABLE_STEPS + 1] = {
+	    0,   402,   804,  1205,  1606,  2006,  2404,  2801,
+	 3196,  3590,  3981,  4370,  4756,  5139,  5520,  5897,
+	 6270,  6639,  7005,  7366,  7723,  8076,  8423,  8765,
+	 9102,  9434,  9760, 10080, 10394, 10702, 11003, 11297,
+	11585, 11866, 12140, 12406, 12665, 12916, 13160, 13395,
+	13623, 13842, 14053, 14256, 14449, 14635, 14811, 14978,
+	15137, 15286, 15426, 15557, 15679, 15791, 15893, 15986,
+	16069, 16143, 16207, 16261, 16305, 16340, 16364, 16379,
+	16384
+};
+
+/** @brief Position of the car in Q8 mm */
+static volatile sint32_t gv_s32_x = U8_ZERO_VALUE;
+static volatile sint32_t gv_s32_y = U8_ZERO_VALUE;
+
+/** @brief Heading of the car, 32-bit binary angle */
+static volatile uint32_t gv_u32_heading = U8_ZERO_VALUE;
+
+/** @brief Path length in Q8 mm */
+static volatile uint32_t gv_u32_distance = U8_ZERO_VALUE;
+
+sint16_t ODOMETRY_sin(uint16_t copy_u16_angle)
+{
+	uint16_t u16_quarter = copy_u16_angle & ODOMETRY_QUARTER_MASK;
+	uint8_t u8_index;
+	uint8_t u8_fraction;
+	sint16_t s16_value;
+
+	// Second and fourth quarters mirror the first one
+	if ((copy_u16_angle & ODOMETRY_QUARTER_TURN) != U8_ZERO_VALUE)
+	{
+		u16_quarter = ODOMETRY_QUARTER_TURN - u16_quarter;
+	}
+	u8_index = (uint8_t)(u16_quarter >> ODOMETRY_TABLE_SHIFT);
+	u8_fraction = (uint8_t)u16_quarter;
+
+	s16_value = gc_s16_sin_table[u8_index];
+	if (u8_index < ODOMETRY_TABLE_STEPS)
+	{
+		// The table rises over the quarter, the step is never negative
+		s16_value += (sint16_t)(((uint32_t)(gc_s16_sin_table[u8_index + 1] - s16_value) * u8_fraction) >> ODOMETRY_TABLE_SHIFT);
+	}
+
+	// Second half turn is the negative of the first one
+	if ((copy_u16_angle & ODOMETRY_HALF_TURN) != U8_ZERO_VALUE)
+	{
+		s16_value = -s16_value;
+	}
+	return s16_value;
+}
+
+sint16_t ODOMETRY_cos(uint16_t copy_u16_angle)
+{
+	return ODOMETRY_sin((uint16_t)(copy_u16_angle + ODOMETRY_QUARTER_TURN));
+}
+
+void ODOMETRY_reset(void)
+{
+	uint8_t u8_sreg;
+
+	ISR_ENTER_CRITICAL(u8_sreg);
+	gv_s32_x = U8_ZERO_VALUE;
+	gv_s32_y = U8_ZERO_VALUE;
+	gv_u32_heading = U8_ZERO_VALUE;
+	gv_u32_distance = U8_ZERO_VALUE;
+	ISR_EXIT_CRITICAL(u8_sreg);
+}
+
+void ODOMETRY_update(sint16_t copy_s16_left_edges, sint16_t copy_s16_right_edges)
+{
+	sint32_t s32_left;
+	sint32_t s32_right;
+	sint32_t s32_center;
+	sint32_t s32_turn;
+	uint16_t u16_mid_heading;
+	uint8_t u8_sreg;
+
+	if ((copy_s16_left_edges != 0) || (copy_s16_right_edges != 0))
+	{
+		s32_left = (sint32_t)copy_s16_left_edges * (sint32_t)ODOMETRY_EDGE_Q8;
+		s32_right = (sint32_t)copy_s16_right_edges * (sint32_t)ODOMETRY_EDGE_Q8;
+		s32_center = (s32_left + s32_right) / 2;
+		s32_turn = (s32_right - s32_left) * (sint32_t)ODOMETRY_TURN_SCALE;
+
+		// The pose is read from the main loop, update it in one piece
+		ISR_ENTER_CRITICAL(u8_sreg);
+		u16_mid_heading = (uint16_t)((gv_u32_heading + (uint32_t)(s32_turn / 2)) >> 16);
+		gv_s32_x += (s32_center * ODOMETRY_cos(u16_mid_heading)) / ODOMETRY_Q14_ONE;
+		gv_s32_y += (s32_center * ODOMETRY_sin(u16_mid_heading)) / ODOMETRY_Q14_ONE;
+		gv_u32_heading += (uint32_t)s32_turn;
+		gv_u32_distance += (uint32_t)((s32_center < 0) ? -s32_center : s32_center);
+		ISR_EXIT_CRITICAL(u8_sreg);
+	}
+}
+
+void ODOMETRY_get_pose(odometry_str_pose_t *ptr_str_pose)
+{
+	uint8_t u8_sreg;
+
+	if (ptr_str_pose != NULL)
+	{
+		ISR_ENTER_CRITICAL(u8_sreg);
+		ptr_str_pose->s32_x = gv_s32_x;
+		ptr_str_pose->s32_y = gv_s32_y;
+		ptr_str_pose->u16_heading = (uint16_t)(gv_u32_heading >> 16);
+		ptr_str_pose->u32_distance = gv_u32_distance;
+		ISR_EXIT_CRITICAL(u8_sreg);
+	}
+}
+
+uint16_t ODOMETRY_get_heading(void)
+{
+	uint16_t u16_heading;
+	uint8_t u8_sreg;
+
+	ISR_ENTER_CRITICAL(u8_sreg);
+	u16_heading = (uint16_t)(gv_u32_heading >> 16);
+	ISR_EXIT_CRITICAL(u8_sreg);
+	return u16_heading;
+}
+
+uint32_t ODOMETRY_get_distance_mm(void)
+{
+	uint32_t u32_distance;
+	uint8_t u8_sreg;
+
+	ISR_ENTER_CRITICAL(u8_sreg);
+	u32_distance = gv_u32_distance;
+	ISR_EXIT_CRITICAL(u8_sreg);
+	return u32_distance >> 8;
+}
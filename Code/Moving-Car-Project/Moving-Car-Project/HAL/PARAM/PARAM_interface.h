@@ -0,0 +1,71 @@
+/**
+ * @file PARAM_interface.h
+ * @brief Parameter Store Interface Header File
+ *
+ * This header file defines the interface of the parameter store: a block of RAM (a route, tuning values)
+ * kept in the EEPROM behind a header with its version, its size and a CRC-16 of both and of the data.
+ * The block is loaded into RAM at boot and written back in the background when it changes.
+ *
+ * EEPROM layout at the store address: version (2 bytes), size (2 bytes), CRC (2 bytes), then the data.
+ * The data is written first and the header last, a write cut by a reset leaves a CRC that does not match.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef PARAM_INTERFACE_H_
+#define PARAM_INTERFACE_H_
+
+#include "../../MCAL/EEPROM/EEPROM_interface.h"
+#include "../../STD_LIB/bit_math.h"
+#include "../../STD_LIB/std_types.h"
+
+
+/** @brief Size of the header in front of the data in the EEPROM */
+#define PARAM_HEADER_SIZE		6
+
+
+/**
+ * @brief Enumeration defining return states for parameter store functions.
+ */
+typedef enum {
+    PARAM_OK,		/**< Operation was successful. */
+    PARAM_NOK,		/**< NULL pointer or store out of the EEPROM. */
+    PARAM_INVALID,	/**< The EEPROM holds no valid store of this version and size, the RAM block is unchanged. */
+    PARAM_BUSY		/**< The EEPROM is still writing, try again later. */
+} param_enu_return_state_t;
+
+
+/**
+ * @brief Load a store from the EEPROM into RAM.
+ *
+ * The header and the CRC are checked first, the RAM block is only written if the store is valid,
+ * so it keeps the defaults it was filled with otherwise.
+ *
+ * @param copy_u16_address EEPROM address of the store.
+ * @param ptr_data Pointer to the RAM block.
+ * @param copy_u16_size Size of the RAM block in bytes.
+ * @param copy_u16_version Version of the block layout, a store of another version is invalid.
+ * @return The return state of loading the store.
+ *     - #PARAM_OK: Store loaded successfully.
+ *     - #PARAM_NOK: NULL pointer or store out of the EEPROM.
+ *     - #PARAM_INVALID: No valid store (blank EEPROM, other version or size, CRC error).
+ *     - #PARAM_BUSY: The EEPROM is still writing, the RAM block is unchanged.
+ */
+param_enu_return_state_t PARAM_load(uint16_t copy_u16_address, void *ptr_data, uint16_t copy_u16_size, uint16_t copy_u16_version);
+
+/**
+ * @brief Save a RAM block to the EEPROM in the background.
+ *
+ * @param copy_u16_address EEPROM address of the store.
+ * @param ptr_data Pointer to the RAM block, it must stay unchanged until EEPROM_is_idle() returns TRUE.
+ * @param copy_u16_size Size of the RAM block in bytes.
+ * @param copy_u16_version Version of the block layout.
+ * @return The return state of saving the store.
+ *     - #PARAM_OK: Store queued successfully.
+ *     - #PARAM_NOK: NULL pointer or store out of the EEPROM.
+ *     - #PARAM_BUSY: The EEPROM is still writing, nothing was queued.
+ */
+param_enu_return_state_t PARAM_save(uint16_t copy_u16_address, const void *ptr_data, uint16_t copy_u16_size, uint16_t copy_u16_version);
+
+#endif /* PARAM_INTERFACE_H_ */
@@ -0,0 +1,137 @@
+/**
+ * @file PARAM_prog.c
+ * @brief Parameter Store Implementation File
+ *
+ * This file implements the CRC protected parameter store on top of the queued EEPROM writes.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "PARAM_interface.h"
+#include "../../STD_LIB/crc16.h"
+
+/**
+ * @brief Header of a store in the EEPROM.
+ */
+typedef struct {
+	uint16_t u16_version;	/**< Version of the data layout. */
+	uint16_t u16_size;		/**< Size of the data in bytes. */
+	uint16_t u16_crc;		/**< CRC-16 of the version, the size and the data. */
+} param_str_header_t;
+
+/** @brief Header being written, the EEPROM queue reads it until the write is done */
+static param_str_header_t gs_str_param_header;
+
+/** @brief Bytes read from the EEPROM at once to check a store */
+#define PARAM_READ_CHUNK		16
+
+
+/**
+ * @brief Compute the CRC of a header's version and size.
+ *
+ * @param ptr_str_header Pointer to the header.
+ * @return The CRC to continue with the data.
+ */
+static uint16_t PARAM_header_crc(const param_str_header_t *ptr_str_header)
+{
+	uint16_t u16_crc = CRC16_INIT;
+
+	u16_crc = CRC16_block(u16_crc, &ptr_str_header->u16_version, sizeof(ptr_str_header->u16_version));
+	u16_crc = CRC16_block(u16_crc, &ptr_str_header->u16_size, sizeof(ptr_str_header->u16_size));
+	return u16_crc;
+}
+
+param_enu_return_state_t PARAM_load(uint16_t copy_u16_address, void *ptr_data, uint16_t copy_u16_size, uint16_t copy_u16_version)
+{
+	param_enu_return_state_t enu_return_state = PARAM_OK;
+	param_str_header_t str_header;
+	uint8_t au8_chunk[PARAM_READ_CHUNK];
+	uint16_t u16_crc;
+	uint16_t u16_offset = U8_ZERO_VALUE;
+	uint16_t u16_length;
+
+	if ((ptr_data == NULL) || (copy_u16_size > (EEPROM_SIZE - PARAM_HEADER_SIZE))
+		|| (copy_u16_address > (EEPROM_SIZE - PARAM_HEADER_SIZE - copy_u16_size)))
+	{
+		enu_return_state = PARAM_NOK;
+	}
+	else if (EEPROM_read(copy_u16_address, &str_header, PARAM_HEADER_SIZE) != EEPROM_OK)
+	{
+		enu_return_state = PARAM_BUSY;
+	}
+	else if ((str_header.u16_version != copy_u16_version) || (str_header.u16_size != copy_u16_size))
+	{
+		enu_return_state = PARAM_INVALID;
+	}
+	else
+	{
+		// Check the CRC in chunks before the RAM block is touched
+		u16_crc = PARAM_header_crc(&str_header);
+		while ((enu_return_state == PARAM_OK) && (u16_offset < copy_u16_size))
+		{
+			u16_length = copy_u16_size - u16_offset;
+			if (u16_length > PARAM_READ_CHUNK)
+			{
+				u16_length = PARAM_READ_CHUNK;
+			}
+			if (EEPROM_read(copy_u16_address + PARAM_HEADER_SIZE + u16_offset, au8_chunk, u16_length) != EEPROM_OK)
+			{
+				enu_return_state = PARAM_BUSY;
+			}
+			else
+			{
+				u16_crc = CRC16_block(u16_crc, au8_chunk, u16_length);
+				u16_offset += u16_length;
+			}
+		}
+
+		if (enu_return_state != PARAM_OK)
+		{
+			// The EEPROM started writing, the RAM block is unchanged
+		}
+		else if (u16_crc != str_header.u16_crc)
+		{
+			enu_return_state = PARAM_INVALID;
+		}
+		else if (EEPROM_read(copy_u16_address + PARAM_HEADER_SIZE, ptr_data, copy_u16_size) != EEPROM_OK)
+		{
+			enu_return_state = PARAM_BUSY;
+		}
+		else
+		{
+			// Loaded
+		}
+	}
+	return enu_return_state;
+}
+
+param_enu_return_state_t PARAM_save(uint16_t copy_u16_address, const void *ptr_data, uint16_t copy_u16_size, uint16_t copy_u16_version)
+{
+	param_enu_return_state_t enu_return_state = PARAM_OK;
+
+	if ((ptr_data == NULL) || (copy_u16_size == U8_ZERO_VALUE) || (copy_u16_size > (EEPROM_SIZE - PARAM_HEADER_SIZE))
+		|| (copy_u16_address > (EEPROM_SIZE - PARAM_HEADER_SIZE - copy_u16_size)))
+	{
+		enu_return_state = PARAM_NOK;
+	}
+	else if (EEPROM_is_idle() == FALSE)
+	{
+		// The header buffer may still be read by the queue
+		enu_return_state = PARAM_BUSY;
+	}
+	else
+	{
+		gs_str_param_header.u16_version = copy_u16_version;
+		gs_str_param_header.u16_size = copy_u16_size;
+		gs_str_param_header.u16_crc = CRC16_block(PARAM_header_crc(&gs_str_param_header), ptr_data, copy_u16_size);
+
+		// Data first, the header makes the store valid once the data is in
+		if ((EEPROM_write(copy_u16_address + PARAM_HEADER_SIZE, ptr_data, copy_u16_size) != EEPROM_OK)
+			|| (EEPROM_write(copy_u16_address, &gs_str_param_header, PARAM_HEADER_SIZE) != EEPROM_OK))
+		{
+			enu_return_state = PARAM_BUSY;
+		}
+	}
+	return enu_return_state;
+}
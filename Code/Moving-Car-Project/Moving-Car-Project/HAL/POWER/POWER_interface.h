@@ -0,0 +1,90 @@
+/**
+ * @file POWER_interface.h
+ * @brief Power Manager Interface Header File
+ *
+ * This header file defines the interface of the power manager. It puts the CPU to sleep whenever there is
+ * no work: Idle between the system ticks, Power-down while the car is parked. It switches off the peripherals
+ * that are not used and counts the sleeps of every mode with the time spent in them.
+ *
+ * Power-save would keep Timer 2 running only with a watch crystal on TOSC1/TOSC2. Timer 2 runs from the
+ * system clock here, so the parked car sleeps in Power-down and an external interrupt wakes it up.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef POWER_INTERFACE_H_
+#define POWER_INTERFACE_H_
+
+#include "../../MCAL/SLEEP/SLEEP_interface.h"
+#include "../../STD_LIB/bit_math.h"
+#include "../../STD_LIB/std_types.h"
+
+
+/**
+ * @brief Enumeration of the sleep modes the power manager uses.
+ */
+typedef enum {
+    POWER_MODE_IDLE = 0,	/**< CPU stopped between the system ticks. */
+    POWER_MODE_POWER_DOWN,	/**< All clocks stopped while parked. */
+    POWER_MODE_MAX			/**< Number of modes. */
+} power_enu_mode_t;
+
+/**
+ * @brief Statistics of a sleep mode.
+ */
+typedef struct {
+    uint32_t u32_entries;	/**< Number of times the CPU slept in the mode. */
+    uint32_t u32_cycles;	/**< CPU cycles spent asleep (Timer 1 counts), 0 in Power-down where every clock stops. */
+} power_str_stats_t;
+
+/**
+ * @brief Enumeration defining return states for power manager functions.
+ */
+typedef enum {
+    POWER_OK,	/**< Operation was successful. */
+    POWER_NOK	/**< Operation failed. */
+} power_enu_return_state_t;
+
+
+/**
+ * @brief Initialize the power manager and switch the unused ADC off.
+ *
+ * @return The return state of the initialization.
+ *     - #POWER_OK: Initialization successful.
+ */
+power_enu_return_state_t POWER_init(void);
+
+/**
+ * @brief Sleep in Idle until the next interrupt.
+ *
+ * Must be called with the interrupts disabled, after checking there is no work left (see SLEEP_enter()).
+ * It returns after the interrupt was served, with the interrupts enabled. Timer 1 must run free at F_CPU
+ * to time the sleep, which ends on the next system tick at the latest.
+ */
+void POWER_idle(void);
+
+/**
+ * @brief Sleep in Power-down until an external interrupt.
+ *
+ * The caller enables the wake up interrupt first (INT0/INT1 on low level or INT2). The analog comparator is
+ * powered off while asleep, its user starts it again after the wake up. The timers stop and resume where they were.
+ *
+ * @return The return state of sleeping.
+ *     - #POWER_OK: The CPU slept and was woken up.
+ *     - #POWER_NOK: The CPU could not sleep.
+ */
+power_enu_return_state_t POWER_power_down(void);
+
+/**
+ * @brief Read the statistics of a sleep mode.
+ *
+ * @param copy_enu_mode The sleep mode.
+ * @param ptr_str_stats Pointer to store the statistics.
+ * @return The return state of reading the statistics.
+ *     - #POWER_OK: Statistics read successfully.
+ *     - #POWER_NOK: NULL pointer or invalid mode.
+ */
+power_enu_return_state_t POWER_get_stats(power_enu_mode_t copy_enu_mode, power_str_stats_t *ptr_str_stats);
+
+#endif /* POWER_INTERFACE_H_ */
@@ -0,0 +1,80 @@
+/**
+ * @file POWER_prog.c
+ * @brief Power Manager Implementation File
+ *
+ * This file implements the power manager: the sleeps are timed with Timer 1 and counted per mode.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "POWER_interface.h"
+#include "../TIMER_manager/TIMER_manger_interface.h"
+#include "../../MCAL/ANA_COMP/ANA_COMP_interface.h"
+#include "../../MCAL/AVR_ARCH/ISR_interface.h"
+
+/** @brief Statistics of every sleep mode, only written from the main loop */
+static power_str_stats_t gs_str_power_stats[POWER_MODE_MAX];
+
+
+power_enu_return_state_t POWER_init(void)
+{
+	for (uint8_t u8_mode = U8_ZERO_VALUE ; u8_mode < POWER_MODE_MAX ; u8_mode++)
+	{
+		gs_str_power_stats[u8_mode].u32_entries = U8_ZERO_VALUE;
+		gs_str_power_stats[u8_mode].u32_cycles = U8_ZERO_VALUE;
+	}
+
+	// The ADC is not used, the comparator reaches the ADC pins through its multiplexer
+	SLEEP_adc_off();
+	return POWER_OK;
+}
+
+void POWER_idle(void)
+{
+	uint16_t u16_start = U8_ZERO_VALUE;
+	uint16_t u16_end = U8_ZERO_VALUE;
+
+	TIMER_MANGER_getValue(TIMER_1,&u16_start);
+	SLEEP_enter(SLEEP_IDLE);
+	TIMER_MANGER_getValue(TIMER_1,&u16_end);
+
+	gs_str_power_stats[POWER_MODE_IDLE].u32_entries++;
+	gs_str_power_stats[POWER_MODE_IDLE].u32_cycles += (uint16_t)(u16_end - u16_start);
+}
+
+power_enu_return_state_t POWER_power_down(void)
+{
+	power_enu_return_state_t enu_return_state = POWER_OK;
+	uint8_t u8_sreg;
+
+	// The comparator draws current in every sleep mode
+	ANA_COMP_deinit();
+
+	ISR_ENTER_CRITICAL(u8_sreg);
+	if (SLEEP_enter(SLEEP_POWER_DOWN) == SLEEP_OK)
+	{
+		gs_str_power_stats[POWER_MODE_POWER_DOWN].u32_entries++;
+	}
+	else
+	{
+		enu_return_state = POWER_NOK;
+	}
+	ISR_EXIT_CRITICAL(u8_sreg);
+	return enu_return_state;
+}
+
+power_enu_return_state_t POWER_get_stats(power_enu_mode_t copy_enu_mode, power_str_stats_t *ptr_str_stats)
+{
+	power_enu_return_state_t enu_return_state = POWER_OK;
+
+	if ((ptr_str_stats == NULL) || (copy_enu_mode >= POWER_MODE_MAX))
+	{
+		enu_return_state = POWER_NOK;
+	}
+	else
+	{
+		*ptr_str_stats = gs_str_power_stats[copy_enu_mode];
+	}
+	return enu_return_state;
+}
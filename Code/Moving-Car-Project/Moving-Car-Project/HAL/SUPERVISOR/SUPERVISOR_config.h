@@ -0,0 +1,29 @@
+/**
+ * @file SUPERVISOR_config.h
+ * @brief Watchdog Supervisor Configuration Header File
+ *
+ * This header file defines the check-in window of the supervisor and the watchdog timeout behind it.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef SUPERVISOR_CONFIG_H_
+#define SUPERVISOR_CONFIG_H_
+
+/**
+ * @brief Maximum number of supervised clients.
+ */
+#define SUPERVISOR_MAX_CLIENTS		8
+
+/**
+ * @brief Length of the check-in window in ms, every client must check in within it (longer than the slowest task period).
+ */
+#define SUPERVISOR_WINDOW_MS		200
+
+/**
+ * @brief Watchdog timeout, longer than the window: a missed window resets the MCU within 60 ms.
+ */
+#define SUPERVISOR_WDT_TIMEOUT		WDT_TIMEOUT_260MS
+
+#endif /* SUPERVISOR_CONFIG_H_ */
@@ -0,0 +1,95 @@
+/**
+ * @file SUPERVISOR_interface.h
+ * @brief Watchdog Supervisor Interface Header File
+ *
+ * This header file defines the interface of the watchdog supervisor. Every client (a task or a loop) checks in
+ * when it makes progress. The system tick closes a check-in window every #SUPERVISOR_WINDOW_MS: the watchdog is
+ * serviced only if every client has checked in during the window. Otherwise the clients that missed it are recorded
+ * in RAM that survives the reset, the watchdog is never serviced again and resets the MCU, which leaves the motors off.
+ *
+ * A check-in is one byte store. A hang with the interrupts off stops the system tick as well,
+ * the watchdog then resets the MCU with no client recorded.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef SUPERVISOR_INTERFACE_H_
+#define SUPERVISOR_INTERFACE_H_
+
+#include "../../MCAL/WDT/WDT_interface.h"
+#include "../../STD_LIB/bit_math.h"
+#include "../../STD_LIB/std_types.h"
+#include "SUPERVISOR_config.h"
+
+
+/** @brief Check-in flags of the clients, only to be used through #SUPERVISOR_CHECK_IN */
+extern volatile uint8_t gv_au8_supervisor_alive[SUPERVISOR_MAX_CLIENTS];
+
+/**
+ * @brief Check a client in for the current window.
+ *
+ * One byte store (2 cycles for a constant client), safe from any context.
+ *
+ * @param client Index of the client (below the number given to SUPERVISOR_start()).
+ */
+#define SUPERVISOR_CHECK_IN(client)		(gv_au8_supervisor_alive[(client)] = TRUE)
+
+/**
+ * @brief Enumeration defining return states for supervisor functions.
+ */
+typedef enum {
+    SUPERVISOR_OK,		/**< Operation was successful. */
+    SUPERVISOR_NOK		/**< Operation failed. */
+} supervisor_enu_return_state_t;
+
+
+/**
+ * @brief Read the cause of the reset and the clients that missed their window before a watchdog reset.
+ *
+ * Must be called once at boot, before SUPERVISOR_start(). It stops a watchdog left running.
+ */
+void SUPERVISOR_init(void);
+
+/**
+ * @brief Start supervising clients 0 .. copy_u8_clients_num - 1 and the watchdog.
+ *
+ * @param copy_u8_clients_num Number of clients.
+ * @return The return state of starting the supervisor.
+ *     - #SUPERVISOR_OK: Supervisor started.
+ *     - #SUPERVISOR_NOK: More than #SUPERVISOR_MAX_CLIENTS clients.
+ */
+supervisor_enu_return_state_t SUPERVISOR_start(uint8_t copy_u8_clients_num);
+
+/**
+ * @brief Stop the watchdog, before a sleep the system tick does not wake up from.
+ */
+void SUPERVISOR_suspend(void);
+
+/**
+ * @brief Start the watchdog again after SUPERVISOR_suspend(), with a new window.
+ */
+void SUPERVISOR_resume(void);
+
+/**
+ * @brief Close the check-in window when it is over.
+ *
+ * Must be called every 1 ms (usually from the system tick interrupt).
+ */
+void SUPERVISOR_tick(void);
+
+/**
+ * @brief Read the cause of the last reset.
+ *
+ * @return The reset flags read by SUPERVISOR_init(), see WDT_get_reset_cause().
+ */
+uint8_t SUPERVISOR_get_reset_cause(void);
+
+/**
+ * @brief Read the clients that missed their window before the last reset.
+ *
+ * @return One bit per client, 0 if the last reset was no supervisor reset or the system tick had stopped.
+ */
+uint8_t SUPERVISOR_get_missed(void);
+
+#endif /* SUPERVISOR_INTERFACE_H_ */
@@ -0,0 +1,150 @@
+/**
+ * @file SUPERVISOR_prog.c
+ * @brief Watchdog Supervisor Implementation File
+ *
+ * This file implements the watchdog supervisor: the system tick checks the client flags at the end of
+ * every window and services the watchdog only if they are all set.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "SUPERVISOR_interface.h"
+#include "../../MCAL/AVR_ARCH/ISR_interface.h"
+
+/** @brief Record of the clients that missed their window, kept across the reset (not cleared by the startup code) */
+typedef struct {
+	uint8_t u8_missed;		/**< One bit per client. */
+	uint8_t u8_check;		/**< Complement of u8_missed, tells a record from the RAM content at power on. */
+} supervisor_str_record_t;
+
+
+/** @brief Check-ins of the clients in the current window, set by SUPERVISOR_CHECK_IN and cleared with the window */
+volatile uint8_t gv_au8_supervisor_alive[SUPERVISOR_MAX_CLIENTS];
+
+/** @brief Record of the missed clients, written just before the watchdog reset */
+static volatile supervisor_str_record_t gv_str_supervisor_record __attribute__((section(".noinit")));
+
+/** @brief Number of supervised clients, 0 while the supervisor is stopped */
+static volatile uint8_t gv_u8_clients_num = U8_ZERO_VALUE;
+
+/** @brief Number of supervised clients while suspended */
+static uint8_t gs_u8_suspended_clients_num = U8_ZERO_VALUE;
+
+/** @brief Ticks counted in the current window */
+static volatile uint16_t gv_u16_window_ms = U8_ZERO_VALUE;
+
+/** @brief Set once a client missed its window, the watchdog is not serviced any more */
+static volatile uint8_t gv_u8_failed = FALSE;
+
+/** @brief Reset flags read at boot */
+static uint8_t gs_u8_reset_cause = U8_ZERO_VALUE;
+
+/** @brief Clients that missed their window before the last reset */
+static uint8_t gs_u8_missed = U8_ZERO_VALUE;
+
+
+void SUPERVISOR_init(void)
+{
+	uint8_t u8_missed = gv_str_supervisor_record.u8_missed;
+	uint8_t u8_check = (uint8_t)(~u8_missed);
+
+	WDT_disable();
+	gs_u8_reset_cause = WDT_get_reset_cause();
+
+	if (((gs_u8_reset_cause & WDT_RESET_WATCHDOG) != U8_ZERO_VALUE) && (gv_str_supervisor_record.u8_check == u8_check))
+	{
+		gs_u8_missed = u8_missed;
+	}
+	gv_str_supervisor_record.u8_missed = U8_ZERO_VALUE;
+	gv_str_supervisor_record.u8_check = U8_ZERO_VALUE;
+}
+
+supervisor_enu_return_state_t SUPERVISOR_start(uint8_t copy_u8_clients_num)
+{
+	supervisor_enu_return_state_t enu_return_state = SUPERVISOR_OK;
+	uint8_t u8_sreg;
+
+	if (copy_u8_clients_num > SUPERVISOR_MAX_CLIENTS)
+	{
+		enu_return_state = SUPERVISOR_NOK;
+	}
+	else
+	{
+		ISR_ENTER_CRITICAL(u8_sreg);
+		for (uint8_t u8_index = U8_ZERO_VALUE ; u8_index < SUPERVISOR_MAX_CLIENTS ; u8_index++)
+		{
+			gv_au8_supervisor_alive[u8_index] = FALSE;
+		}
+		gv_u16_window_ms = U8_ZERO_VALUE;
+		gv_u8_failed = FALSE;
+		gv_u8_clients_num = copy_u8_clients_num;
+		WDT_enable(SUPERVISOR_WDT_TIMEOUT);
+		ISR_EXIT_CRITICAL(u8_sreg);
+	}
+	return enu_return_state;
+}
+
+void SUPERVISOR_suspend(void)
+{
+	uint8_t u8_sreg;
+
+	// A missed window is not undone: the watchdog keeps running and resets the MCU in its sleep
+	ISR_ENTER_CRITICAL(u8_sreg);
+	if (gv_u8_failed == FALSE)
+	{
+		gs_u8_suspended_clients_num = gv_u8_clients_num;
+		gv_u8_clients_num = U8_ZERO_VALUE;
+		WDT_disable();
+	}
+	ISR_EXIT_CRITICAL(u8_sreg);
+}
+
+void SUPERVISOR_resume(void)
+{
+	if (gv_u8_failed == FALSE)
+	{
+		SUPERVISOR_start(gs_u8_suspended_clients_num);
+	}
+}
+
+void SUPERVISOR_tick(void)
+{
+	uint8_t u8_missed = U8_ZERO_VALUE;
+
+	gv_u16_window_ms++;
+	if ((gv_u16_window_ms >= SUPERVISOR_WINDOW_MS) && (gv_u8_clients_num != U8_ZERO_VALUE) && (gv_u8_failed == FALSE))
+	{
+		gv_u16_window_ms = U8_ZERO_VALUE;
+		for (uint8_t u8_index = U8_ZERO_VALUE ; u8_index < gv_u8_clients_num ; u8_index++)
+		{
+			if (gv_au8_supervisor_alive[u8_index] == FALSE)
+			{
+				u8_missed |= (uint8_t)(BIT_MASK << u8_index);
+			}
+			gv_au8_supervisor_alive[u8_index] = FALSE;
+		}
+
+		if (u8_missed == U8_ZERO_VALUE)
+		{
+			WDT_service();
+		}
+		else
+		{
+			// Leave the watchdog to reset the MCU, the record tells which clients hung
+			gv_str_supervisor_record.u8_missed = u8_missed;
+			gv_str_supervisor_record.u8_check = (uint8_t)~u8_missed;
+			gv_u8_failed = TRUE;
+		}
+	}
+}
+
+uint8_t SUPERVISOR_get_reset_cause(void)
+{
+	return gs_u8_reset_cause;
+}
+
+uint8_t SUPERVISOR_get_missed(void)
+{
+	return gs_u8_missed;
+}
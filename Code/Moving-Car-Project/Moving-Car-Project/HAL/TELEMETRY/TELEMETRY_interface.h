@@ -0,0 +1,118 @@
+/**
+ * @file TELEMETRY_interface.h
+ * @brief Telemetry Link Interface Header File
+ *
+ * This header file defines the interface of the telemetry link: binary frames sent and received over the USART.
+ *
+ * Every frame is laid out as (multi-byte fields little endian):
+ * | 0xA5 | 0x5A | type | length | sequence (2) | payload (length) | CRC-16 (2) |
+ *
+ * The CRC-16/CCITT covers the type, the length, the sequence and the payload. The sequence counts every frame,
+ * sent or dropped, so the host sees the lost frames as gaps. Sending a frame only copies it to the transmit
+ * ring buffer: it is sent whole or dropped and counted when the link is busy, the caller never waits.
+ *
+ * The host sends its frames in the same layout. They are assembled byte by byte out of the receive ring buffer
+ * by TELEMETRY_receive(), a frame with a bad CRC is dropped and counted.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef TELEMETRY_INTERFACE_H_
+#define TELEMETRY_INTERFACE_H_
+
+#include "../../MCAL/USART/USART_interface.h"
+#include "../../STD_LIB/bit_math.h"
+#include "../../STD_LIB/std_types.h"
+
+
+/** @brief First sync byte of a frame */
+#define TELEMETRY_SYNC_1			0xA5
+
+/** @brief Second sync byte of a frame */
+#define TELEMETRY_SYNC_2			0x5A
+
+/** @brief Bytes of a frame around its payload: sync (2), type, length, sequence (2) and CRC (2) */
+#define TELEMETRY_FRAME_OVERHEAD	8
+
+/** @brief Largest payload of a frame, a whole frame fits the transmit ring buffer */
+#define TELEMETRY_MAX_PAYLOAD		32
+
+/**
+ * @brief Enumeration of the frame types.
+ */
+typedef enum {
+    TELEMETRY_FRAME_STATUS = 1,		/**< Periodic status of the car, see the application for its payload. */
+    TELEMETRY_FRAME_GET,			/**< Host command: read a parameter, see COMMAND_interface.h. */
+    TELEMETRY_FRAME_SET,			/**< Host command: change a parameter. */
+    TELEMETRY_FRAME_SAVE,			/**< Host command: save the parameters to the EEPROM. */
+    TELEMETRY_FRAME_REPLY,			/**< Reply of the car to a host command. */
+    TELEMETRY_FRAME_TELEOP			/**< Host setpoint of the teleoperation, streamed and not replied. */
+} telemetry_enu_frame_t;
+
+/**
+ * @brief Enumeration defining return states for telemetry functions.
+ */
+typedef enum {
+    TELEMETRY_OK,		/**< Operation was successful. */
+    TELEMETRY_NOK,		/**< NULL pointer or payload too long. */
+    TELEMETRY_BUSY,		/**< The transmit ring buffer is full, the frame was dropped. */
+    TELEMETRY_EMPTY		/**< No whole frame was received yet. */
+} telemetry_enu_return_state_t;
+
+
+/**
+ * @brief Initialize the telemetry link and its USART.
+ *
+ * @return The return state of the initialization.
+ *     - #TELEMETRY_OK: Initialization successful.
+ */
+telemetry_enu_return_state_t TELEMETRY_init(void);
+
+/**
+ * @brief Send a frame.
+ *
+ * Must be called from the main loop. It frames the payload and queues it whole, it never waits for the USART.
+ *
+ * @param copy_u8_type Frame type, see telemetry_enu_frame_t.
+ * @param ptr_payload Pointer to the payload.
+ * @param copy_u8_size Size of the payload in bytes (up to #TELEMETRY_MAX_PAYLOAD).
+ * @return The return state of sending the frame.
+ *     - #TELEMETRY_OK: Frame queued successfully.
+ *     - #TELEMETRY_NOK: NULL pointer or payload too long.
+ *     - #TELEMETRY_BUSY: The link is busy, the frame was dropped and counted.
+ */
+telemetry_enu_return_state_t TELEMETRY_send(uint8_t copy_u8_type, const void *ptr_payload, uint8_t copy_u8_size);
+
+/**
+ * @brief Receive a frame.
+ *
+ * Must be called from the main loop. It parses the received bytes until a whole frame with a good CRC is in,
+ * the bytes of a partial frame are kept for the next call.
+ *
+ * @param ptr_u8_type Pointer to store the frame type.
+ * @param ptr_u16_sequence Pointer to store the sequence number of the frame.
+ * @param ptr_payload Pointer to store the payload, #TELEMETRY_MAX_PAYLOAD bytes.
+ * @param ptr_u8_size Pointer to store the size of the payload.
+ * @return The return state of receiving a frame.
+ *     - #TELEMETRY_OK: A frame was received.
+ *     - #TELEMETRY_NOK: NULL pointer.
+ *     - #TELEMETRY_EMPTY: No whole frame was received yet.
+ */
+telemetry_enu_return_state_t TELEMETRY_receive(uint8_t *ptr_u8_type, uint16_t *ptr_u16_sequence, void *ptr_payload, uint8_t *ptr_u8_size);
+
+/**
+ * @brief Read the number of received frames dropped on a bad CRC or length.
+ *
+ * @return The number of dropped frames (saturates at 65535).
+ */
+uint16_t TELEMETRY_get_rx_errors(void);
+
+/**
+ * @brief Read the number of frames dropped because the link was busy.
+ *
+ * @return The number of dropped frames (saturates at 65535).
+ */
+uint16_t TELEMETRY_get_dropped(void);
+
+#endif /* TELEMETRY_INTERFACE_H_ */
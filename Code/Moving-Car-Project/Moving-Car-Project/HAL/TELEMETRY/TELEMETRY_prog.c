@@ -0,0 +1,209 @@
+/**
+ * @file TELEMETRY_prog.c
+ * @brief Telemetry Link Implementation File
+ *
+ * This file implements the telemetry link: it frames a payload with the sync bytes, the sequence number
+ * and the CRC, and queues the whole frame on the USART at once. Received frames are assembled byte by byte
+ * and checked the same way.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "TELEMETRY_interface.h"
+#include "../../STD_LIB/crc16.h"
+
+/** @brief Offset of the type in a frame, the CRC starts there */
+#define TELEMETRY_TYPE_OFFSET		2
+
+/** @brief Offset of the payload in a frame */
+#define TELEMETRY_PAYLOAD_OFFSET	6
+
+
+/** @brief Offset of the payload length in a frame */
+#define TELEMETRY_LENGTH_OFFSET		3
+
+/** @brief Offset of the sequence number in a frame (low byte first) */
+#define TELEMETRY_SEQUENCE_OFFSET	4
+
+/***************************************************************************/
+/*******				Static function prototypes					*******/
+/***************************************************************************/
+
+static uint8_t TELEMETRY_parse(uint8_t u8_data);
+
+
+/** @brief Sequence number of the next frame */
+static uint16_t gs_u16_sequence = U8_ZERO_VALUE;
+
+/** @brief Frames dropped because the link was busy */
+static uint16_t gs_u16_dropped = U8_ZERO_VALUE;
+
+/** @brief Received frame being assembled */
+static uint8_t gs_au8_rx_frame[TELEMETRY_MAX_PAYLOAD + TELEMETRY_FRAME_OVERHEAD];
+
+/** @brief Bytes of the received frame assembled so far */
+static uint8_t gs_u8_rx_index = U8_ZERO_VALUE;
+
+/** @brief Received frames dropped on a bad CRC or length */
+static uint16_t gs_u16_rx_errors = U8_ZERO_VALUE;
+
+
+/**
+ * @brief Add a received byte to the frame being assembled.
+ *
+ * Outside a frame the bytes are skipped until the sync bytes. A frame with a bad length or CRC is dropped,
+ * the search for the sync bytes starts again after it.
+ *
+ * @param u8_data The received byte.
+ * @return TRUE when the byte completed a frame with a good CRC, FALSE otherwise.
+ */
+static uint8_t TELEMETRY_parse(uint8_t u8_data)
+{
+	uint8_t u8_done = FALSE;
+	uint8_t u8_size;
+	uint16_t u16_crc;
+
+	gs_au8_rx_frame[gs_u8_rx_index] = u8_data;
+	gs_u8_rx_index++;
+
+	if (gs_u8_rx_index == 1)
+	{
+		gs_u8_rx_index = (u8_data == TELEMETRY_SYNC_1) ? 1 : 0;
+	}
+	else if (gs_u8_rx_index == 2)
+	{
+		// A repeated first sync byte may still start the frame
+		gs_u8_rx_index = (u8_data == TELEMETRY_SYNC_2) ? 2 : ((u8_data == TELEMETRY_SYNC_1) ? 1 : 0);
+	}
+	else if ((gs_u8_rx_index == (TELEMETRY_LENGTH_OFFSET + 1)) && (u8_data > TELEMETRY_MAX_PAYLOAD))
+	{
+		gs_u8_rx_index = U8_ZERO_VALUE;
+		if (gs_u16_rx_errors < 0xFFFF)
+		{
+			gs_u16_rx_errors++;
+		}
+	}
+	else if (gs_u8_rx_index > TELEMETRY_LENGTH_OFFSET)
+	{
+		u8_size = gs_au8_rx_frame[TELEMETRY_LENGTH_OFFSET];
+		if (gs_u8_rx_index == (u8_size + TELEMETRY_FRAME_OVERHEAD))
+		{
+			gs_u8_rx_index = U8_ZERO_VALUE;
+			u16_crc = CRC16_block(CRC16_INIT, gs_au8_rx_frame + TELEMETRY_TYPE_OFFSET, (uint16_t)(u8_size + TELEMETRY_PAYLOAD_OFFSET - TELEMETRY_TYPE_OFFSET));
+			if ((gs_au8_rx_frame[TELEMETRY_PAYLOAD_OFFSET + u8_size] == (uint8_t)u16_crc)
+				&& (gs_au8_rx_frame[TELEMETRY_PAYLOAD_OFFSET + u8_size + 1] == (uint8_t)(u16_crc >> 8)))
+			{
+				u8_done = TRUE;
+			}
+			else if (gs_u16_rx_errors < 0xFFFF)
+			{
+				gs_u16_rx_errors++;
+			}
+			else
+			{
+				// Error count saturated
+			}
+		}
+	}
+	else
+	{
+		// Type and sequence
+	}
+	return u8_done;
+}
+
+
+telemetry_enu_return_state_t TELEMETRY_init(void)
+{
+	gs_u16_sequence = U8_ZERO_VALUE;
+	gs_u16_dropped = U8_ZERO_VALUE;
+	gs_u8_rx_index = U8_ZERO_VALUE;
+	USART_init();
+	return TELEMETRY_OK;
+}
+
+telemetry_enu_return_state_t TELEMETRY_send(uint8_t copy_u8_type, const void *ptr_payload, uint8_t copy_u8_size)
+{
+	telemetry_enu_return_state_t enu_return_state = TELEMETRY_OK;
+	uint8_t au8_frame[TELEMETRY_MAX_PAYLOAD + TELEMETRY_FRAME_OVERHEAD];
+	const uint8_t *ptr_u8_payload = (const uint8_t *)ptr_payload;
+	uint8_t u8_size = copy_u8_size + TELEMETRY_FRAME_OVERHEAD;
+	uint16_t u16_crc;
+
+	if ((ptr_payload == NULL) || (copy_u8_size > TELEMETRY_MAX_PAYLOAD))
+	{
+		enu_return_state = TELEMETRY_NOK;
+	}
+	else if (u8_size > USART_get_tx_free())
+	{
+		// Checked before the frame is built, a busy link costs nothing but the count
+		enu_return_state = TELEMETRY_BUSY;
+		gs_u16_sequence++;
+		if (gs_u16_dropped < 0xFFFF)
+		{
+			gs_u16_dropped++;
+		}
+	}
+	else
+	{
+		au8_frame[0] = TELEMETRY_SYNC_1;
+		au8_frame[1] = TELEMETRY_SYNC_2;
+		au8_frame[TELEMETRY_TYPE_OFFSET] = copy_u8_type;
+		au8_frame[TELEMETRY_LENGTH_OFFSET] = copy_u8_size;
+		au8_frame[TELEMETRY_SEQUENCE_OFFSET] = (uint8_t)gs_u16_sequence;
+		au8_frame[TELEMETRY_SEQUENCE_OFFSET + 1] = (uint8_t)(gs_u16_sequence >> 8);
+		for (uint8_t u8_index = U8_ZERO_VALUE ; u8_index < copy_u8_size ; u8_index++)
+		{
+			au8_frame[TELEMETRY_PAYLOAD_OFFSET + u8_index] = ptr_u8_payload[u8_index];
+		}
+		u16_crc = CRC16_block(CRC16_INIT, au8_frame + TELEMETRY_TYPE_OFFSET, (uint16_t)(copy_u8_size + TELEMETRY_PAYLOAD_OFFSET - TELEMETRY_TYPE_OFFSET));
+		au8_frame[TELEMETRY_PAYLOAD_OFFSET + copy_u8_size] = (uint8_t)u16_crc;
+		au8_frame[TELEMETRY_PAYLOAD_OFFSET + copy_u8_size + 1] = (uint8_t)(u16_crc >> 8);
+
+		USART_write(au8_frame, u8_size);
+		gs_u16_sequence++;
+	}
+	return enu_return_state;
+}
+
+telemetry_enu_return_state_t TELEMETRY_receive(uint8_t *ptr_u8_type, uint16_t *ptr_u16_sequence, void *ptr_payload, uint8_t *ptr_u8_size)
+{
+	telemetry_enu_return_state_t enu_return_state = TELEMETRY_EMPTY;
+	uint8_t *ptr_u8_payload = (uint8_t *)ptr_payload;
+	uint8_t u8_data;
+
+	if ((ptr_u8_type == NULL) || (ptr_u16_sequence == NULL) || (ptr_payload == NULL) || (ptr_u8_size == NULL))
+	{
+		enu_return_state = TELEMETRY_NOK;
+	}
+	else
+	{
+		// Stop at the end of a frame, the bytes after it stay in the ring buffer for the next call
+		while ((enu_return_state == TELEMETRY_EMPTY) && (USART_read(&u8_data) == USART_OK))
+		{
+			if (TELEMETRY_parse(u8_data) == TRUE)
+			{
+				*ptr_u8_type = gs_au8_rx_frame[TELEMETRY_TYPE_OFFSET];
+				*ptr_u16_sequence = (uint16_t)(gs_au8_rx_frame[TELEMETRY_SEQUENCE_OFFSET] | ((uint16_t)gs_au8_rx_frame[TELEMETRY_SEQUENCE_OFFSET + 1] << 8));
+				*ptr_u8_size = gs_au8_rx_frame[TELEMETRY_LENGTH_OFFSET];
+				for (uint8_t u8_index = U8_ZERO_VALUE ; u8_index < *ptr_u8_size ; u8_index++)
+				{
+					ptr_u8_payload[u8_index] = gs_au8_rx_frame[TELEMETRY_PAYLOAD_OFFSET + u8_index];
+				}
+				enu_return_state = TELEMETRY_OK;
+			}
+		}
+	}
+	return enu_return_state;
+}
+
+uint16_t TELEMETRY_get_rx_errors(void)
+{
+	return gs_u16_rx_errors;
+}
+
+uint16_t TELEMETRY_get_dropped(void)
+{
+	return gs_u16_dropped;
+}
@@ -56,6 +56,7 @@ typedef struct {
  * @brief Initialize and configure a timer using the Timer Manager module.
  *
  * This function initializes and configures a timer based on the provided configuration structure.
+ * In normal mode the overflow interrupt is only enabled when a callback is given.
  *
  * @param stPtr_a_TimerConfig Pointer to the timer configuration structure.
  * @return The return state of the timer initialization.
@@ -104,4 +105,86 @@ timerm_enu_return_state_t TIMER_MANGER_stop(const timer_enu_timer_number_t copy_
  */
 timerm_enu_return_state_t TIMER_MANGER_setValue(const timer_enu_timer_number_t copy_enu_timer_num , uint16_t copy_u16_InitialValue);
 
+/**
+ * @brief Set the compare match value of a timer using the Timer Manager module.
+ *
+ * This function sets the Output Compare Register of a specified timer, used as TOP in CTC mode.
+ *
+ * @param copy_enu_timer_num The timer number to set the compare value for.
+ * @param copy_u16_compare_value The compare match value to set for the timer.
+ * @return The return state of setting the timer's compare value.
+ *     - #TIMERM_E_OK: Timer compare value set successfully.
+ *     - #TIMERM_E_NOK: Timer compare value set failed.
+ */
+timerm_enu_return_state_t TIMER_MANGER_setCompare(const timer_enu_timer_number_t copy_enu_timer_num , uint16_t copy_u16_compare_value);
+
+/**
+ * @brief Read the counter value of a timer using the Timer Manager module.
+ *
+ * @param copy_enu_timer_num The timer number to read.
+ * @param ptr_u16_timer_value Pointer to store the current Timer/Counter Register value.
+ * @return The return state of reading the timer's value.
+ *     - #TIMERM_E_OK: Timer value read successfully.
+ *     - #TIMERM_E_NOK: Timer value read failed.
+ *     - #TIMERM_NULL_PTR: The value pointer is NULL.
+ */
+timerm_enu_return_state_t TIMER_MANGER_getValue(const timer_enu_timer_number_t copy_enu_timer_num , uint16_t *ptr_u16_timer_value);
+
+/**
+ * @brief Read the Timer 1 counter, the CPU cycle count while Timer 1 runs freely at F_CPU.
+ *
+ * Cheaper than TIMER_MANGER_getValue() and safe from any context: the difference of two reads times a piece
+ * of code up to 65535 cycles (8.2 ms at 8 MHz).
+ *
+ * @return The Timer 1 counter value.
+ */
+uint16_t TIMER_MANGER_getCycles(void);
+
+/**
+ * @brief Attach a callback to a Timer 1 compare unit.
+ *
+ * The compare units run on top of the Timer 1 counter in any mode, so a free-running Timer 1
+ * can time several independent events by moving the compare value forward from the callback.
+ *
+ * @param copy_enu_compare_unit The compare unit (A or B).
+ * @param ptr_call_back_func Pointer to the function called on every compare match.
+ * @return The return state of the compare unit initialization.
+ *     - #TIMERM_E_OK: Compare unit initialized successfully.
+ *     - #TIMERM_E_NOK: Compare unit initialization failed.
+ *     - #TIMERM_NULL_PTR: The callback pointer is NULL.
+ */
+timerm_enu_return_state_t TIMER_MANGER_compareUnitInit(const timer_enu_compare_unit_t copy_enu_compare_unit , ptr_to_v_fun_in_void_t ptr_call_back_func);
+
+/**
+ * @brief Load the first compare value of a Timer 1 compare unit and enable its compare match interrupt.
+ *
+ * @param copy_enu_compare_unit The compare unit (A or B).
+ * @param copy_u16_compare_value The Timer 1 counter value of the first compare match.
+ * @return The return state of starting the compare unit.
+ *     - #TIMERM_E_OK: Compare unit started successfully.
+ *     - #TIMERM_E_NOK: Compare unit start failed.
+ */
+timerm_enu_return_state_t TIMER_MANGER_compareUnitStart(const timer_enu_compare_unit_t copy_enu_compare_unit , uint16_t copy_u16_compare_value);
+
+/**
+ * @brief Disable the compare match interrupt of a Timer 1 compare unit.
+ *
+ * @param copy_enu_compare_unit The compare unit (A or B).
+ * @return The return state of stopping the compare unit.
+ *     - #TIMERM_E_OK: Compare unit stopped successfully.
+ *     - #TIMERM_E_NOK: Compare unit stop failed.
+ */
+timerm_enu_return_state_t TIMER_MANGER_compareUnitStop(const timer_enu_compare_unit_t copy_enu_compare_unit);
+
+/**
+ * @brief Set the compare value of a Timer 1 compare unit.
+ *
+ * @param copy_enu_compare_unit The compare unit (A or B).
+ * @param copy_u16_compare_value The Timer 1 counter value of the next compare match.
+ * @return The return state of setting the compare value.
+ *     - #TIMERM_E_OK: Compare value set successfully.
+ *     - #TIMERM_E_NOK: Compare value set failed.
+ */
+timerm_enu_return_state_t TIMER_MANGER_setCompareUnit(const timer_enu_compare_unit_t copy_enu_compare_unit , uint16_t copy_u16_compare_value);
+
 #endif /* TIMER_MANGER_H_ */
\ No newline at end of file
@@ -33,9 +33,12 @@ timerm_enu_return_state_t TIMER_MANGER_init(const timerm_str_config_t *stPtr_a_T
 		g_str_Timer.u16_timer_InitialValue	    =		stPtr_a_TimerConfig->u16_timer_initial_value;
 		g_str_Timer.u16_timer_compare_MatchValue=		stPtr_a_TimerConfig->u16_timer_compare_match_value;
 		
-		l_ret = TIMERx_init(&g_str_Timer);
-		/*set call-back function  */
-		l_ret |= TIMERx_setCallBack(stPtr_a_TimerConfig->ptr_call_back_func , stPtr_a_TimerConfig->enu_timer_no);
+		/*set call-back function first, the overflow interrupt is only enabled with a call-back */
+		if (stPtr_a_TimerConfig->ptr_call_back_func != NULL)
+		{
+			l_ret = (timerm_enu_return_state_t)TIMERx_setCallBack(stPtr_a_TimerConfig->ptr_call_back_func , stPtr_a_TimerConfig->enu_timer_no);
+		}
+		l_ret |= (timerm_enu_return_state_t)TIMERx_init(&g_str_Timer);
 	}
 	return l_ret;
 }
@@ -50,7 +53,7 @@ timerm_enu_return_state_t TIMER_MANGER_start(const timer_enu_clock_t copy_enu_ti
 	else
 	{
 		/*Configure the TIMER Pres-scaler value for Timer-x clock*/
-		l_ret = TIMERx_start(copy_enu_timer_clock,copy_enu_timer_num);
+		l_ret = (timerm_enu_return_state_t)TIMERx_start(copy_enu_timer_clock,copy_enu_timer_num);
 	}
 	return l_ret;
 }
@@ -66,7 +69,7 @@ timerm_enu_return_state_t TIMER_MANGER_stop(const timer_enu_timer_number_t copy_
 	else
 	{
 		/*stop the clock for the specific timer*/
-		l_ret = TIMERx_stop(copy_enu_timer_num);
+		l_ret = (timerm_enu_return_state_t)TIMERx_stop(copy_enu_timer_num);
 	}
 	return l_ret;
 }
@@ -81,7 +84,111 @@ timerm_enu_return_state_t TIMER_MANGER_setValue(const timer_enu_timer_number_t c
 	else
 	{
 		/*stop the clock for the specific timer*/
-		l_ret =  TIMERx_setValue(copy_enu_timer_num , u16_a_InitialValue);
+		l_ret = (timerm_enu_return_state_t)TIMERx_setValue(copy_enu_timer_num , u16_a_InitialValue);
 	}
 	return l_ret;
-}
\ No newline at end of file
+}
+
+timerm_enu_return_state_t TIMER_MANGER_setCompare(const timer_enu_timer_number_t copy_enu_timer_num , uint16_t copy_u16_compare_value)
+{
+	timerm_enu_return_state_t l_ret = TIMERM_E_OK;
+	if(copy_enu_timer_num >= INVALID_TIMER_TYPE)
+	{
+		l_ret = TIMERM_E_NOK;
+	}
+	else
+	{
+		/*load the compare match value of the specific timer*/
+		l_ret = (timerm_enu_return_state_t)TIMERx_CTC_SetCompare(copy_enu_timer_num , copy_u16_compare_value);
+	}
+	return l_ret;
+}
+
+timerm_enu_return_state_t TIMER_MANGER_getValue(const timer_enu_timer_number_t copy_enu_timer_num , uint16_t *ptr_u16_timer_value)
+{
+	timerm_enu_return_state_t l_ret = TIMERM_E_OK;
+	if(ptr_u16_timer_value == NULL)
+	{
+		l_ret = TIMERM_NULL_PTR;
+	}
+	else if(copy_enu_timer_num >= INVALID_TIMER_TYPE)
+	{
+		l_ret = TIMERM_E_NOK;
+	}
+	else
+	{
+		/*read the counter of the specific timer*/
+		l_ret = (timerm_enu_return_state_t)TIMERx_getValue(copy_enu_timer_num , ptr_u16_timer_value);
+	}
+	return l_ret;
+}
+
+uint16_t TIMER_MANGER_getCycles(void)
+{
+	return TIMER1_getCount();
+}
+
+timerm_enu_return_state_t TIMER_MANGER_compareUnitInit(const timer_enu_compare_unit_t copy_enu_compare_unit , ptr_to_v_fun_in_void_t ptr_call_back_func)
+{
+	timerm_enu_return_state_t l_ret = TIMERM_E_OK;
+	if(ptr_call_back_func == NULL)
+	{
+		l_ret = TIMERM_NULL_PTR;
+	}
+	else if(copy_enu_compare_unit >= INVALID_TIMER_COMPARE_UNIT)
+	{
+		l_ret = TIMERM_E_NOK;
+	}
+	else
+	{
+		/*set call-back function, the interrupt stays disabled until the compare unit is started */
+		l_ret = (timerm_enu_return_state_t)TIMER1_setCompareUnitCallBack(ptr_call_back_func , copy_enu_compare_unit);
+	}
+	return l_ret;
+}
+
+timerm_enu_return_state_t TIMER_MANGER_compareUnitStart(const timer_enu_compare_unit_t copy_enu_compare_unit , uint16_t copy_u16_compare_value)
+{
+	timerm_enu_return_state_t l_ret = TIMERM_E_OK;
+	if(copy_enu_compare_unit >= INVALID_TIMER_COMPARE_UNIT)
+	{
+		l_ret = TIMERM_E_NOK;
+	}
+	else
+	{
+		/*load the first compare match value then enable the compare match interrupt */
+		l_ret = (timerm_enu_return_state_t)TIMER1_setCompareUnitValue(copy_enu_compare_unit , copy_u16_compare_value);
+		l_ret |= (timerm_enu_return_state_t)TIMER1_enableCompareUnitInterrupt(copy_enu_compare_unit);
+	}
+	return l_ret;
+}
+
+timerm_enu_return_state_t TIMER_MANGER_compareUnitStop(const timer_enu_compare_unit_t copy_enu_compare_unit)
+{
+	timerm_enu_return_state_t l_ret = TIMERM_E_OK;
+	if(copy_enu_compare_unit >= INVALID_TIMER_COMPARE_UNIT)
+	{
+		l_ret = TIMERM_E_NOK;
+	}
+	else
+	{
+		/*disable the compare match interrupt, the call-back stays attached*/
+		l_ret = (timerm_enu_return_state_t)TIMER1_disableCompareUnitInterrupt(copy_enu_compare_unit);
+	}
+	return l_ret;
+}
+
+timerm_enu_return_state_t TIMER_MANGER_setCompareUnit(const timer_enu_compare_unit_t copy_enu_compare_unit , uint16_t copy_u16_compare_value)
+{
+	timerm_enu_return_state_t l_ret = TIMERM_E_OK;
+	if(copy_enu_compare_unit >= INVALID_TIMER_COMPARE_UNIT)
+	{
+		l_ret = TIMERM_E_NOK;
+	}
+	else
+	{
+		/*load the compare match value of the specific compare unit*/
+		l_ret = (timerm_enu_return_state_t)TIMER1_setCompareUnitValue(copy_enu_compare_unit , copy_u16_compare_value);
+	}
+	return l_ret;
+}
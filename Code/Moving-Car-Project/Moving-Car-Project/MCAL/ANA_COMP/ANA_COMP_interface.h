@@ -0,0 +1,151 @@
+/**
+ * @file ANA_COMP_interface.h
+ * @brief Analog Comparator Interface Header File
+ *
+ * This header file provides declarations for the analog comparator module's interface functions
+ * and related data types. It includes enums for the comparator inputs and interrupt edge, as well as
+ * function prototypes for initializing the comparator, switching its negative input, reading its output,
+ * enabling and disabling its interrupt and setting its callback function.
+ *
+ * The comparator output is high while the positive input is above the negative input.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef ANA_COMP_INTERFACE_H_
+#define ANA_COMP_INTERFACE_H_
+
+#include "../../STD_LIB/std_types.h"
+
+
+/**
+ * @brief Enumeration for Analog Comparator return states.
+ */
+typedef enum {
+    ANA_COMP_OK = 0,    /**< Operation performed successfully. */
+    ANA_COMP_NOK        /**< Operation performed with issues or errors. */
+} ana_comp_enu_return_state_t;
+
+
+/**
+ * @brief Enumeration for the positive input of the comparator.
+ */
+typedef enum {
+    ANA_COMP_POS_AIN0 = 0,      /**< AIN0 pin (PB2). */
+    ANA_COMP_POS_BANDGAP,       /**< Internal bandgap reference (1.23 V). */
+    ANA_COMP_POS_INVALID
+} ana_comp_enu_positive_input_t;
+
+
+/**
+ * @brief Enumeration for the negative input of the comparator.
+ *
+ * The ADCn inputs go through the ADC multiplexer, the ADC is switched off while one of them is selected.
+ */
+typedef enum {
+    ANA_COMP_NEG_ADC0 = 0,      /**< ADC0 pin (PA0). */
+    ANA_COMP_NEG_ADC1,          /**< ADC1 pin (PA1). */
+    ANA_COMP_NEG_ADC2,          /**< ADC2 pin (PA2). */
+    ANA_COMP_NEG_ADC3,          /**< ADC3 pin (PA3). */
+    ANA_COMP_NEG_ADC4,          /**< ADC4 pin (PA4). */
+    ANA_COMP_NEG_ADC5,          /**< ADC5 pin (PA5). */
+    ANA_COMP_NEG_ADC6,          /**< ADC6 pin (PA6). */
+    ANA_COMP_NEG_ADC7,          /**< ADC7 pin (PA7). */
+    ANA_COMP_NEG_AIN1,          /**< AIN1 pin (PB3). */
+    ANA_COMP_NEG_INVALID
+} ana_comp_enu_negative_input_t;
+
+
+/**
+ * @brief Enumeration for the comparator interrupt edge.
+ */
+typedef enum {
+    ANA_COMP_TOGGLE = 0,        /**< Interrupt on any output change. */
+    ANA_COMP_FALLING_EDGE,      /**< Interrupt when the output falls (negative input rises above the positive input). */
+    ANA_COMP_RISING_EDGE,       /**< Interrupt when the output rises (negative input falls below the positive input). */
+    ANA_COMP_INVALID_EDGE
+} ana_comp_enu_edge_t;
+
+
+/**
+ * @brief Structure to hold the configuration of the analog comparator.
+ */
+typedef struct {
+    ana_comp_enu_positive_input_t enu_positive_input;  /**< Positive (reference) input. */
+    ana_comp_enu_negative_input_t enu_negative_input;  /**< Negative input watched first. */
+    ana_comp_enu_edge_t           enu_edge;            /**< Output edge raising the interrupt. */
+} ana_comp_str_config_t;
+
+
+/**
+ * @brief Initialize and power up the analog comparator.
+ *
+ * This function selects the comparator inputs and the interrupt edge. The interrupt stays disabled.
+ *
+ * @param ptr_str_config Pointer to the comparator configuration structure.
+ * @return The return state of the initialization.
+ *     - #ANA_COMP_OK: Comparator initialization successful.
+ *     - #ANA_COMP_NOK: Comparator initialization failed.
+ */
+ana_comp_enu_return_state_t ANA_COMP_init(const ana_comp_str_config_t *ptr_str_config);
+
+/**
+ * @brief Switch the negative input of the comparator.
+ *
+ * The interrupt is masked while the multiplexer switches and a flag raised by the switch itself is cleared,
+ * so only a real crossing on the new input raises the interrupt. The function returns once the output has
+ * settled (about 2 us): an input already beyond the reference raises no edge, read it with ANA_COMP_get_output().
+ *
+ * @param copy_enu_negative_input The new negative input.
+ * @return The return state of switching the input.
+ *     - #ANA_COMP_OK: Negative input switched successfully.
+ *     - #ANA_COMP_NOK: Negative input switching failed.
+ */
+ana_comp_enu_return_state_t ANA_COMP_select_negative_input(ana_comp_enu_negative_input_t copy_enu_negative_input);
+
+/**
+ * @brief Read the comparator output.
+ *
+ * @param ptr_u8_output Pointer to store the output (1 while the positive input is above the negative input).
+ * @return The return state of reading the output.
+ *     - #ANA_COMP_OK: Output read successfully.
+ *     - #ANA_COMP_NOK: NULL pointer.
+ */
+ana_comp_enu_return_state_t ANA_COMP_get_output(uint8_t *ptr_u8_output);
+
+/**
+ * @brief Enable the comparator interrupt (a pending flag is cleared first).
+ *
+ * @return The return state of enabling the interrupt.
+ *     - #ANA_COMP_OK: Interrupt enabled successfully.
+ */
+ana_comp_enu_return_state_t ANA_COMP_enable_interrupt(void);
+
+/**
+ * @brief Disable the comparator interrupt.
+ *
+ * @return The return state of disabling the interrupt.
+ *     - #ANA_COMP_OK: Interrupt disabled successfully.
+ */
+ana_comp_enu_return_state_t ANA_COMP_disable_interrupt(void);
+
+/**
+ * @brief Power the comparator off to save current, ANA_COMP_init() powers it up again.
+ *
+ * @return The return state of powering the comparator off.
+ *     - #ANA_COMP_OK: Comparator powered off successfully.
+ */
+ana_comp_enu_return_state_t ANA_COMP_deinit(void);
+
+/**
+ * @brief Set a callback function for the comparator interrupt.
+ *
+ * @param callback Pointer to the callback function.
+ * @return The return state of setting the callback function.
+ *     - #ANA_COMP_OK: Callback function set successfully.
+ *     - #ANA_COMP_NOK: NULL pointer.
+ */
+ana_comp_enu_return_state_t ANA_COMP_set_callback(void(*callback)(void));
+
+#endif /* ANA_COMP_INTERFACE_H_ */
@@ -0,0 +1,79 @@
+/**
+ * @file ANA_COMP_private.h
+ * @brief Analog Comparator Private Register Definitions
+ *
+ * This private header file provides the register definitions used for configuring
+ * the analog comparator. It defines the addresses of the relevant registers and their
+ * bit indices for selecting the comparator inputs, the interrupt mode and the power state.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+
+#ifndef ANA_COMP_PRIVATE_H_
+#define ANA_COMP_PRIVATE_H_
+#include "../../STD_LIB/std_types.h"
+#include "../../STD_LIB/bit_math.h"
+
+/** @brief Analog Comparator Control and Status Register (ACSR) address */
+#define ACSR_ADD			(*((volatile uint8_t *) 0x28))
+
+/** @brief Bit index of the analog comparator disable (power off) */
+#define ACD_BIT			7
+
+/** @brief Bit index of the bandgap reference select for the positive input */
+#define ACBG_BIT		6
+
+/** @brief Bit index of the analog comparator output */
+#define ACO_BIT			5
+
+/** @brief Bit index of the analog comparator interrupt flag (cleared by writing one) */
+#define ACI_BIT			4
+
+/** @brief Bit index of the analog comparator interrupt enable */
+#define ACIE_BIT		3
+
+/** @brief Bit index of the analog comparator input capture enable */
+#define ACIC_BIT		2
+
+/** @brief Bit index of the interrupt mode select (ACIS1:0) */
+#define ACIS_INDEX		0
+
+/** @brief Mask of the interrupt mode select bits */
+#define ACIS_MASK		0x03
+
+/** @brief Special Function IO Register (SFIOR) address */
+#define SFIOR_ADD			(*((volatile uint8_t *) 0x50))
+
+/** @brief Bit index of the analog comparator multiplexer enable */
+#define ACME_BIT		3
+
+/** @brief ADC Multiplexer Selection Register (ADMUX) address */
+#define ADMUX_ADD			(*((volatile uint8_t *) 0x27))
+
+/** @brief Mask of the ADC channel select bits (MUX2:0) used by the comparator multiplexer */
+#define ADMUX_MUX_MASK	0x07
+
+/** @brief ADC Control and Status Register A (ADCSRA) address */
+#define ADCSRA_ADD			(*((volatile uint8_t *) 0x26))
+
+/** @brief Bit index of the ADC enable (the comparator multiplexer only works with the ADC off) */
+#define ADEN_BIT		7
+
+/** @brief ACIS1:0 values for the interrupt modes */
+#define ACIS_TOGGLE			0x00
+#define ACIS_FALLING_EDGE	0x02
+#define ACIS_RISING_EDGE	0x03
+
+/** @brief ACSR bits written as one to act (the interrupt flag), kept at zero by every other write */
+#define ACSR_WRITE_ONE_MASK	(U8_ONE_VALUE << ACI_BIT)
+
+/** @brief Loops of the settle wait after an input switch, at least 2 us at 8 MHz (multiplexer and propagation delay) */
+#define ANA_COMP_SETTLE_LOOPS	16
+
+/** @brief One cycle of the settle wait */
+#define ANA_COMP_NOP()		__asm__ __volatile__("nop" ::: "memory")
+
+
+#endif /* ANA_COMP_PRIVATE_H_ */
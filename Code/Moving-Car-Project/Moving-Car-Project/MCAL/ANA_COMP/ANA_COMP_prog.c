@@ -0,0 +1,183 @@
+/**
+ * @file ANA_COMP_prog.c
+ * @brief Analog Comparator Implementation
+ *
+ * This source file provides the implementation for initializing the analog comparator, switching its
+ * negative input, reading its output and handling its interrupt. It also includes the interrupt
+ * service routine (ISR) for the analog comparator event.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "ANA_COMP_interface.h"
+#include "ANA_COMP_private.h"
+#include "../AVR_ARCH/ISR_interface.h"
+#include "../../STD_LIB/bit_math.h"
+
+/** @brief Function pointer to hold callback function for the analog comparator interrupt */
+static void (*callback_ANA_COMP)(void) = NULL;
+
+/** @brief ACIS1:0 value of every interrupt edge, indexed by ana_comp_enu_edge_t */
+static const uint8_t gc_u8_acis_value[ANA_COMP_INVALID_EDGE] = {
+	ACIS_TOGGLE,
+	ACIS_FALLING_EDGE,
+	ACIS_RISING_EDGE
+};
+
+/**
+ * @brief Route the negative input through the comparator multiplexer or to AIN1.
+ *
+ * @param copy_enu_negative_input The negative input (must be valid).
+ */
+static void ANA_COMP_route_negative_input(ana_comp_enu_negative_input_t copy_enu_negative_input)
+{
+	if (copy_enu_negative_input == ANA_COMP_NEG_AIN1)
+	{
+		CLEAR_BIT(SFIOR_ADD,ACME_BIT);
+	}
+	else
+	{
+		// The ADC multiplexer feeds the comparator only while the ADC is off
+		CLEAR_BIT(ADCSRA_ADD,ADEN_BIT);
+		ADMUX_ADD = (ADMUX_ADD & (uint8_t)~ADMUX_MUX_MASK) | ((uint8_t)copy_enu_negative_input & ADMUX_MUX_MASK);
+		SET_BIT(SFIOR_ADD,ACME_BIT);
+	}
+}
+
+/**
+ * @brief Set and clear ACSR bits in a single write that leaves the interrupt flag pending.
+ *
+ * A read-modify-write with the flag read as one would write it back as one and clear it.
+ *
+ * @param copy_u8_set_mask Bits to set.
+ * @param copy_u8_clear_mask Bits to clear.
+ */
+static void ANA_COMP_write_acsr(uint8_t copy_u8_set_mask, uint8_t copy_u8_clear_mask)
+{
+	ACSR_ADD = (uint8_t)((ACSR_ADD & (uint8_t)~(copy_u8_clear_mask | ACSR_WRITE_ONE_MASK)) | copy_u8_set_mask);
+}
+
+/**
+ * @brief Wait until the output is valid for a newly routed input (multiplexer and comparator settled).
+ */
+static void ANA_COMP_wait_settle(void)
+{
+	for (uint8_t u8_loop = U8_ZERO_VALUE ; u8_loop < ANA_COMP_SETTLE_LOOPS ; u8_loop++)
+	{
+		ANA_COMP_NOP();
+	}
+}
+
+ana_comp_enu_return_state_t ANA_COMP_init(const ana_comp_str_config_t *ptr_str_config)
+{
+	ana_comp_enu_return_state_t enu_return_state = ANA_COMP_OK;
+	uint8_t u8_acsr;
+
+	if ((ptr_str_config == NULL) || (ptr_str_config->enu_positive_input >= ANA_COMP_POS_INVALID)
+		|| (ptr_str_config->enu_negative_input >= ANA_COMP_NEG_INVALID) || (ptr_str_config->enu_edge >= ANA_COMP_INVALID_EDGE))
+	{
+		enu_return_state = ANA_COMP_NOK;
+	}
+	else
+	{
+		// Interrupt off while the inputs change, comparator powered, no input capture
+		u8_acsr = (uint8_t)(gc_u8_acis_value[ptr_str_config->enu_edge] << ACIS_INDEX);
+		if (ptr_str_config->enu_positive_input == ANA_COMP_POS_BANDGAP)
+		{
+			u8_acsr |= (U8_ONE_VALUE << ACBG_BIT);
+		}
+		ACSR_ADD = u8_acsr;
+
+		ANA_COMP_route_negative_input(ptr_str_config->enu_negative_input);
+		ANA_COMP_wait_settle();
+
+		// Clear the flag raised while the inputs were switched
+		ACSR_ADD = u8_acsr | (U8_ONE_VALUE << ACI_BIT);
+	}
+	return enu_return_state;
+}
+
+ana_comp_enu_return_state_t ANA_COMP_select_negative_input(ana_comp_enu_negative_input_t copy_enu_negative_input)
+{
+	ana_comp_enu_return_state_t enu_return_state = ANA_COMP_OK;
+	uint8_t u8_interrupt_enable;
+
+	if (copy_enu_negative_input >= ANA_COMP_NEG_INVALID)
+	{
+		enu_return_state = ANA_COMP_NOK;
+	}
+	else
+	{
+		u8_interrupt_enable = ACSR_ADD & (U8_ONE_VALUE << ACIE_BIT);
+		ANA_COMP_write_acsr(U8_ZERO_VALUE, (U8_ONE_VALUE << ACIE_BIT));
+
+		ANA_COMP_route_negative_input(copy_enu_negative_input);
+		ANA_COMP_wait_settle();
+
+		// Clear the flag raised by the switch and give the interrupt enable back in the same write
+		ACSR_ADD = (uint8_t)(ACSR_ADD | ACSR_WRITE_ONE_MASK | u8_interrupt_enable);
+	}
+	return enu_return_state;
+}
+
+ana_comp_enu_return_state_t ANA_COMP_get_output(uint8_t *ptr_u8_output)
+{
+	ana_comp_enu_return_state_t enu_return_state = ANA_COMP_OK;
+
+	if (ptr_u8_output == NULL)
+	{
+		enu_return_state = ANA_COMP_NOK;
+	}
+	else
+	{
+		*ptr_u8_output = READ_BIT(ACSR_ADD,ACO_BIT);
+	}
+	return enu_return_state;
+}
+
+ana_comp_enu_return_state_t ANA_COMP_enable_interrupt(void)
+{
+	// Clearing the pending flag and enabling the interrupt in one write, no stale edge fires the interrupt
+	ACSR_ADD = (uint8_t)(ACSR_ADD | ACSR_WRITE_ONE_MASK | (U8_ONE_VALUE << ACIE_BIT));
+	return ANA_COMP_OK;
+}
+
+ana_comp_enu_return_state_t ANA_COMP_disable_interrupt(void)
+{
+	ANA_COMP_write_acsr(U8_ZERO_VALUE, (U8_ONE_VALUE << ACIE_BIT));
+	return ANA_COMP_OK;
+}
+
+ana_comp_enu_return_state_t ANA_COMP_deinit(void)
+{
+	// The interrupt must be off before the comparator is powered off or the change raises it
+	ANA_COMP_write_acsr(U8_ZERO_VALUE, (U8_ONE_VALUE << ACIE_BIT));
+	ANA_COMP_write_acsr((U8_ONE_VALUE << ACD_BIT), U8_ZERO_VALUE);
+	CLEAR_BIT(SFIOR_ADD,ACME_BIT);
+	return ANA_COMP_OK;
+}
+
+ana_comp_enu_return_state_t ANA_COMP_set_callback(void(*callback)(void))
+{
+	ana_comp_enu_return_state_t enu_return_state = ANA_COMP_OK;
+
+	if (callback == NULL)
+	{
+		enu_return_state = ANA_COMP_NOK;
+	}
+	else
+	{
+		callback_ANA_COMP = callback;
+	}
+	return enu_return_state;
+}
+
+ISR(ANA_COMP)
+{
+	// The analog comparator flag is cleared by hardware when the ISR is executed
+	if (callback_ANA_COMP != NULL)
+	{
+		callback_ANA_COMP();
+	}
+}
@@ -14,6 +14,7 @@
 #ifndef ISR_INTERFACE_H_
 #define ISR_INTERFACE_H_
 
+#include "../../STD_LIB/std_types.h"
 
 /** @defgroup InterruptControlMacros Interrupt Control Macros */
 /** @{ */
@@ -27,6 +28,28 @@
  * @brief Disable global interrupts.
  */
 #define cli() __asm__ __volatile__("cli" ::: "memory")
+
+/**
+ * @brief Status Register (SREG), holds the global interrupt flag (I-bit).
+ */
+#define ISR_SREG (*((volatile uint8_t *) 0x5F))
+
+/**
+ * @brief Enter a critical section.
+ *
+ * Saves the current SREG in the given variable and disables global interrupts.
+ * Must be paired with #ISR_EXIT_CRITICAL using the same variable, so nesting is safe.
+ *
+ * @param u8_sreg uint8_t variable used to hold the saved SREG.
+ */
+#define ISR_ENTER_CRITICAL(u8_sreg) do{ (u8_sreg) = ISR_SREG; cli(); }while(0)
+
+/**
+ * @brief Leave a critical section by restoring the SREG saved by #ISR_ENTER_CRITICAL.
+ *
+ * @param u8_sreg uint8_t variable holding the saved SREG.
+ */
+#define ISR_EXIT_CRITICAL(u8_sreg) do{ ISR_SREG = (u8_sreg); }while(0)
 /** @} */
 
 
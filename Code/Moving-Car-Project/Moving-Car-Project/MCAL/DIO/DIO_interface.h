@@ -110,6 +110,19 @@ dio_enu_return_state_t DIO_init (dio_enu_port_t copy_enu_port, dio_enu_pin_t cop
  */
 dio_enu_return_state_t DIO_write_pin (dio_enu_port_t copy_enu_port, dio_enu_pin_t copy_enu_pin, dio_enu_level_t copy_enu_state);
 
+/**
+ * @brief Write several pins of a port at once for the DIO module.
+ *
+ * This function writes the masked bits of the value to the port in a single atomic update,
+ * pins outside the mask keep their level.
+ *
+ * @param copy_enu_port The port to write.
+ * @param copy_u8_mask The pins to update (bit n for pin n).
+ * @param copy_u8_value The levels of the masked pins (bit n for pin n).
+ * @return The return state of writing to the port.
+ */
+dio_enu_return_state_t DIO_write_port (dio_enu_port_t copy_enu_port, uint8_t copy_u8_mask, uint8_t copy_u8_value);
+
 /**
  * @brief Read the level of a pin for the DIO module.
  *
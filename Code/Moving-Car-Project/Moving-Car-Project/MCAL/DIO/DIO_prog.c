@@ -10,6 +10,7 @@
 
 #include "DIO_interface.h"
 #include "DIO_private_.h"
+#include "../AVR_ARCH/ISR_interface.h"
 
 dio_enu_return_state_t DIO_init (dio_enu_port_t copy_enu_port, dio_enu_pin_t copy_enu_pin, dio_u8_enu_direction_t copy_enu_direction)
 {
@@ -54,9 +55,12 @@ dio_enu_return_state_t DIO_write_pin (dio_enu_port_t copy_enu_port, dio_enu_pin_
 {
 
 	dio_enu_return_state_t enu_return_state = DIO_OK;
+	uint8_t u8_sreg;
 
 	if (copy_enu_pin < DIO_MAX_PINS)
 	{
+		// Port update is read-modify-write, keep it atomic against ISRs writing the same port
+		ISR_ENTER_CRITICAL(u8_sreg);
 		if (copy_enu_port == PORTA)
 		{
 			if (copy_enu_state == DIO_PIN_HIGH_LEVEL)
@@ -66,7 +70,6 @@ dio_enu_return_state_t DIO_write_pin (dio_enu_port_t copy_enu_port, dio_enu_pin_
 			else{
 				WR_PORT_A &= ~(U8_ONE_VALUE << copy_enu_pin);
 			}
-			return DIO_OK;
 		}
 		else if (copy_enu_port == PORTB)
 		{
@@ -77,7 +80,6 @@ dio_enu_return_state_t DIO_write_pin (dio_enu_port_t copy_enu_port, dio_enu_pin_
 			else{
 				WR_PORT_B &= ~(U8_ONE_VALUE << copy_enu_pin);
 			}
-			return DIO_OK;
 		}
 		else if (copy_enu_port == PORTC)
 		{
@@ -88,7 +90,6 @@ dio_enu_return_state_t DIO_write_pin (dio_enu_port_t copy_enu_port, dio_enu_pin_
 			else{
 				WR_PORT_C &= ~(U8_ONE_VALUE << copy_enu_pin);
 			}
-			return DIO_OK;
 		}
 		else if (copy_enu_port == PORTD)
 		{
@@ -99,12 +100,12 @@ dio_enu_return_state_t DIO_write_pin (dio_enu_port_t copy_enu_port, dio_enu_pin_
 			else{
 				WR_PORT_D &= ~(U8_ONE_VALUE << copy_enu_pin);
 			}
-			return DIO_OK;
 		}
 		else
 		{
 			enu_return_state = DIO_INVALID_PORT;
 		}
+		ISR_EXIT_CRITICAL(u8_sreg);
 		
 	}
 	else{
@@ -116,6 +117,40 @@ dio_enu_return_state_t DIO_write_pin (dio_enu_port_t copy_enu_port, dio_enu_pin_
 	return enu_return_state;
 }
 
+dio_enu_return_state_t DIO_write_port (dio_enu_port_t copy_enu_port, uint8_t copy_u8_mask, uint8_t copy_u8_value)
+{
+	dio_enu_return_state_t enu_return_state = DIO_OK;
+	uint8_t u8_sreg;
+	
+	copy_u8_value &= copy_u8_mask;
+	
+	// Port update is read-modify-write, keep it atomic against ISRs writing the same port
+	ISR_ENTER_CRITICAL(u8_sreg);
+	if (copy_enu_port == PORTA)
+	{
+		WR_PORT_A = (WR_PORT_A & ~copy_u8_mask) | copy_u8_value;
+	}
+	else if (copy_enu_port == PORTB)
+	{
+		WR_PORT_B = (WR_PORT_B & ~copy_u8_mask) | copy_u8_value;
+	}
+	else if (copy_enu_port == PORTC)
+	{
+		WR_PORT_C = (WR_PORT_C & ~copy_u8_mask) | copy_u8_value;
+	}
+	else if (copy_enu_port == PORTD)
+	{
+		WR_PORT_D = (WR_PORT_D & ~copy_u8_mask) | copy_u8_value;
+	}
+	else
+	{
+		enu_return_state = DIO_INVALID_PORT;
+	}
+	ISR_EXIT_CRITICAL(u8_sreg);
+	
+	return enu_return_state;
+}
+
 dio_enu_return_state_t DIO_read_pin (dio_enu_port_t copy_enu_port, dio_enu_pin_t copy_enu_pin, dio_enu_level_t	*ptr_enu_state)
 {
 
@@ -0,0 +1,80 @@
+/**
+ * @file EEPROM_interface.h
+ * @brief EEPROM Interface Header File
+ *
+ * This header file provides declarations for reading and writing the internal EEPROM.
+ *
+ * Writes never wait for the 8.5 ms programming time of a byte: they are queued as blocks and the EEPROM ready
+ * interrupt programs the bytes one after the other. Bytes that already hold their value are skipped, which saves
+ * both the time and the wear. The data of a queued block is read when its bytes are programmed, so it must
+ * stay unchanged until the EEPROM is idle again.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef EEPROM_INTERFACE_H_
+#define EEPROM_INTERFACE_H_
+
+#include "../../STD_LIB/std_types.h"
+
+
+/** @brief Size of the EEPROM in bytes */
+#define EEPROM_SIZE					1024
+
+/** @brief Number of blocks the write queue holds */
+#define EEPROM_QUEUE_SIZE			8
+
+/** @brief Unchanged bytes skipped by one ready interrupt before it lets the other interrupts run */
+#define EEPROM_MAX_SKIPS_PER_IRQ	8
+
+
+/**
+ * @brief Enumeration for EEPROM return states.
+ */
+typedef enum {
+    EEPROM_OK = 0,      /**< Operation performed successfully. */
+    EEPROM_NOK,         /**< NULL pointer or block out of the EEPROM. */
+    EEPROM_BUSY,        /**< Writes are still queued, the EEPROM can't be read yet. */
+    EEPROM_QUEUE_FULL   /**< No room left in the write queue. */
+} eeprom_enu_return_state_t;
+
+
+/**
+ * @brief Read a block from the EEPROM.
+ *
+ * The EEPROM can't be read while it is programmed, the read is refused until all queued writes are done.
+ *
+ * @param copy_u16_address EEPROM address of the block.
+ * @param ptr_data Pointer to store the block.
+ * @param copy_u16_size Size of the block in bytes.
+ * @return The return state of the read.
+ *     - #EEPROM_OK: Block read successfully.
+ *     - #EEPROM_NOK: NULL pointer or block out of the EEPROM.
+ *     - #EEPROM_BUSY: Writes are still running, nothing was read.
+ */
+eeprom_enu_return_state_t EEPROM_read(uint16_t copy_u16_address, void *ptr_data, uint16_t copy_u16_size);
+
+/**
+ * @brief Queue a block to be written to the EEPROM.
+ *
+ * The function returns at once, the block is programmed in the background. The blocks are written in queue order.
+ *
+ * @param copy_u16_address EEPROM address of the block.
+ * @param ptr_data Pointer to the block, it must stay unchanged until EEPROM_is_idle() returns TRUE.
+ * @param copy_u16_size Size of the block in bytes.
+ * @return The return state of queuing the write.
+ *     - #EEPROM_OK: Block queued successfully.
+ *     - #EEPROM_NOK: NULL pointer, empty block or block out of the EEPROM.
+ *     - #EEPROM_QUEUE_FULL: #EEPROM_QUEUE_SIZE blocks are already queued.
+ */
+eeprom_enu_return_state_t EEPROM_write(uint16_t copy_u16_address, const void *ptr_data, uint16_t copy_u16_size);
+
+/**
+ * @brief Check the EEPROM is done with all queued writes.
+ *
+ * @return TRUE if no write is queued or running, FALSE otherwise.
+ */
+uint8_t EEPROM_is_idle(void);
+
+#endif /* EEPROM_INTERFACE_H_ */
@@ -0,0 +1,38 @@
+/**
+ * @file EEPROM_private.h
+ * @brief EEPROM Private Register Definitions
+ *
+ * This private header file provides the register definitions used for reading and writing
+ * the EEPROM. It defines the addresses of the relevant registers and their bit indices.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+
+#ifndef EEPROM_PRIVATE_H_
+#define EEPROM_PRIVATE_H_
+#include "../../STD_LIB/std_types.h"
+
+/** @brief EEPROM Address Register (EEARH:EEARL) address */
+#define EEAR_ADD			(*((volatile uint16_t *) 0x3E))
+
+/** @brief EEPROM Data Register (EEDR) address */
+#define EEDR_ADD			(*((volatile uint8_t *) 0x3D))
+
+/** @brief EEPROM Control Register (EECR) address */
+#define EECR_ADD			(*((volatile uint8_t *) 0x3C))
+
+/** @brief Bit index of the EEPROM ready interrupt enable */
+#define EERIE_BIT		3
+
+/** @brief Bit index of the EEPROM master write enable, EEWE must be set within 4 cycles */
+#define EEMWE_BIT		2
+
+/** @brief Bit index of the EEPROM write enable, stays set while the byte is programmed */
+#define EEWE_BIT		1
+
+/** @brief Bit index of the EEPROM read enable */
+#define EERE_BIT		0
+
+#endif /* EEPROM_PRIVATE_H_ */
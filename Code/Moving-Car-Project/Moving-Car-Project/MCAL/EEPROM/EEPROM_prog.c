@@ -0,0 +1,152 @@
+/**
+ * @file EEPROM_prog.c
+ * @brief EEPROM Implementation
+ *
+ * This source file provides the implementation for reading the EEPROM and for the queued writes.
+ * It also includes the interrupt service routine (ISR) for the EEPROM ready event, which programs the queued bytes.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "EEPROM_interface.h"
+#include "EEPROM_private.h"
+#include "../AVR_ARCH/ISR_interface.h"
+#include "../../STD_LIB/bit_math.h"
+
+/**
+ * @brief A queued block write.
+ */
+typedef struct {
+	uint16_t u16_address;		/**< EEPROM address of the block. */
+	const uint8_t *ptr_u8_data;	/**< Data of the block. */
+	uint16_t u16_size;			/**< Size of the block in bytes. */
+} eeprom_str_request_t;
+
+/** @brief Write queue, shared with the EEPROM ready interrupt */
+static volatile eeprom_str_request_t gv_str_eeprom_queue[EEPROM_QUEUE_SIZE];
+
+/** @brief Index of the block being written */
+static volatile uint8_t gv_u8_eeprom_head = U8_ZERO_VALUE;
+
+/** @brief Number of queued blocks, the one being written included */
+static volatile uint8_t gv_u8_eeprom_count = U8_ZERO_VALUE;
+
+/** @brief Bytes of the block being written that are done */
+static volatile uint16_t gv_u16_eeprom_done = U8_ZERO_VALUE;
+
+
+eeprom_enu_return_state_t EEPROM_read(uint16_t copy_u16_address, void *ptr_data, uint16_t copy_u16_size)
+{
+	eeprom_enu_return_state_t enu_return_state = EEPROM_OK;
+	uint8_t *ptr_u8_data = (uint8_t *)ptr_data;
+
+	if ((ptr_data == NULL) || (copy_u16_size > EEPROM_SIZE) || (copy_u16_address > (EEPROM_SIZE - copy_u16_size)))
+	{
+		enu_return_state = EEPROM_NOK;
+	}
+	else if (EEPROM_is_idle() == FALSE)
+	{
+		enu_return_state = EEPROM_BUSY;
+	}
+	else
+	{
+		for (uint16_t u16_index = U8_ZERO_VALUE ; u16_index < copy_u16_size ; u16_index++)
+		{
+			EEAR_ADD = copy_u16_address + u16_index;
+			SET_BIT(EECR_ADD,EERE_BIT);
+			ptr_u8_data[u16_index] = EEDR_ADD;
+		}
+	}
+	return enu_return_state;
+}
+
+eeprom_enu_return_state_t EEPROM_write(uint16_t copy_u16_address, const void *ptr_data, uint16_t copy_u16_size)
+{
+	eeprom_enu_return_state_t enu_return_state = EEPROM_OK;
+	uint8_t u8_sreg;
+	uint8_t u8_tail;
+
+	if ((ptr_data == NULL) || (copy_u16_size == U8_ZERO_VALUE) || (copy_u16_size > EEPROM_SIZE)
+		|| (copy_u16_address > (EEPROM_SIZE - copy_u16_size)))
+	{
+		enu_return_state = EEPROM_NOK;
+	}
+	else
+	{
+		ISR_ENTER_CRITICAL(u8_sreg);
+		if (gv_u8_eeprom_count >= EEPROM_QUEUE_SIZE)
+		{
+			enu_return_state = EEPROM_QUEUE_FULL;
+		}
+		else
+		{
+			u8_tail = (uint8_t)((gv_u8_eeprom_head + gv_u8_eeprom_count) % EEPROM_QUEUE_SIZE);
+			gv_str_eeprom_queue[u8_tail].u16_address = copy_u16_address;
+			gv_str_eeprom_queue[u8_tail].ptr_u8_data = (const uint8_t *)ptr_data;
+			gv_str_eeprom_queue[u8_tail].u16_size = copy_u16_size;
+			gv_u8_eeprom_count++;
+
+			// The ready interrupt fires as soon as the EEPROM is free and takes the block
+			SET_BIT(EECR_ADD,EERIE_BIT);
+		}
+		ISR_EXIT_CRITICAL(u8_sreg);
+	}
+	return enu_return_state;
+}
+
+uint8_t EEPROM_is_idle(void)
+{
+	return ((gv_u8_eeprom_count == U8_ZERO_VALUE) && (READ_BIT(EECR_ADD,EEWE_BIT) == U8_ZERO_VALUE)) ? TRUE : FALSE;
+}
+
+/**
+ * @brief Interrupt Service Routine for the EEPROM ready event.
+ *
+ * Programs the next queued byte that changes the EEPROM. The interrupt is level triggered: it fires again
+ * as soon as the byte is programmed, or at once if the skip budget ran out, and is disabled when the queue is empty.
+ */
+ISR(EE_RDY)
+{
+	volatile eeprom_str_request_t *ptr_str_request;
+	uint8_t u8_skips = U8_ZERO_VALUE;
+	uint8_t u8_done = FALSE;
+	uint8_t u8_data;
+
+	while (u8_done == FALSE)
+	{
+		if (gv_u8_eeprom_count == U8_ZERO_VALUE)
+		{
+			CLEAR_BIT(EECR_ADD,EERIE_BIT);
+			u8_done = TRUE;
+		}
+		else
+		{
+			ptr_str_request = &gv_str_eeprom_queue[gv_u8_eeprom_head];
+			EEAR_ADD = ptr_str_request->u16_address + gv_u16_eeprom_done;
+			u8_data = ptr_str_request->ptr_u8_data[gv_u16_eeprom_done];
+
+			gv_u16_eeprom_done++;
+			if (gv_u16_eeprom_done >= ptr_str_request->u16_size)
+			{
+				gv_u16_eeprom_done = U8_ZERO_VALUE;
+				gv_u8_eeprom_head = (uint8_t)((gv_u8_eeprom_head + U8_ONE_VALUE) % EEPROM_QUEUE_SIZE);
+				gv_u8_eeprom_count--;
+			}
+
+			SET_BIT(EECR_ADD,EERE_BIT);
+			if (EEDR_ADD != u8_data)
+			{
+				EEDR_ADD = u8_data;
+				SET_BIT(EECR_ADD,EEMWE_BIT);
+				SET_BIT(EECR_ADD,EEWE_BIT);
+				u8_done = TRUE;
+			}
+			else
+			{
+				u8_skips++;
+				u8_done = (u8_skips >= EEPROM_MAX_SKIPS_PER_IRQ) ? TRUE : FALSE;
+			}
+		}
+	}
+}
@@ -128,13 +128,13 @@ ISR(EXT_INT0)
 }
 
 
-/* Uncomment and implement ISR for external interrupt 1 (INT1) if needed */
-/*
+/**
+ * @brief Interrupt Service Routine for External Interrupt 1 (INT1)
+ */
 ISR(EXT_INT1)
 {
-    callback_EXT_1();
+	callback_EXT_1();
 }
-*/
 
 /* Uncomment and implement ISR for external interrupt 2 (INT2) if needed */
 /*
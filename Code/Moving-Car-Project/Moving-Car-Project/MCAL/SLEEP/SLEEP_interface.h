@@ -0,0 +1,66 @@
+/**
+ * @file SLEEP_interface.h
+ * @brief Sleep Interface Header File
+ *
+ * This header file provides declarations for putting the CPU to sleep and for switching
+ * the unused ADC off.
+ *
+ * Idle stops the CPU only: the timers keep running and any interrupt wakes it up.
+ * Power-down stops every clock: only INT0/INT1 low level, INT2, TWI address match and the watchdog wake it up.
+ * Power-save is Power-down with Timer 2 kept running, which needs Timer 2 clocked from its own crystal.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef SLEEP_INTERFACE_H_
+#define SLEEP_INTERFACE_H_
+
+#include "../../STD_LIB/std_types.h"
+
+
+/**
+ * @brief Enumeration for Sleep return states.
+ */
+typedef enum {
+    SLEEP_OK = 0,   /**< Operation performed successfully. */
+    SLEEP_NOK       /**< Operation performed with issues or errors. */
+} sleep_enu_return_state_t;
+
+
+/**
+ * @brief Enumeration for the sleep modes, the values are the SM2:0 bits.
+ */
+typedef enum {
+    SLEEP_IDLE = 0,             /**< CPU stopped, peripherals running. */
+    SLEEP_ADC_NOISE_REDUCTION,  /**< CPU and I/O clocks stopped, ADC, Timer 2 (asynchronous) and external interrupts running. */
+    SLEEP_POWER_DOWN,           /**< All clocks stopped. */
+    SLEEP_POWER_SAVE,           /**< All clocks stopped but Timer 2 (asynchronous). */
+    SLEEP_STANDBY = 6,          /**< Power-down with the oscillator running (external crystal only). */
+    SLEEP_INVALID_MODE
+} sleep_enu_mode_t;
+
+
+/**
+ * @brief Sleep until the next enabled interrupt.
+ *
+ * Must be called with the interrupts disabled, after checking there is no work left. The interrupts are enabled
+ * and the CPU sleeps in one step, so an interrupt raised since the check still wakes it up at once.
+ * The function returns after the interrupt was served, with the interrupts enabled.
+ *
+ * @param copy_enu_mode The sleep mode.
+ * @return The return state of sleeping.
+ *     - #SLEEP_OK: The CPU slept and was woken up.
+ *     - #SLEEP_NOK: Invalid mode, the CPU did not sleep (the interrupts are still disabled).
+ */
+sleep_enu_return_state_t SLEEP_enter(sleep_enu_mode_t copy_enu_mode);
+
+/**
+ * @brief Switch the ADC off to save current.
+ *
+ * @return The return state of switching the ADC off.
+ *     - #SLEEP_OK: ADC switched off successfully.
+ */
+sleep_enu_return_state_t SLEEP_adc_off(void);
+
+#endif /* SLEEP_INTERFACE_H_ */
@@ -0,0 +1,41 @@
+/**
+ * @file SLEEP_private.h
+ * @brief Sleep Private Register Definitions
+ *
+ * This private header file provides the register definitions used for the sleep modes
+ * and for switching the unused ADC off.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+
+#ifndef SLEEP_PRIVATE_H_
+#define SLEEP_PRIVATE_H_
+#include "../../STD_LIB/std_types.h"
+
+/** @brief MCU Control Register (MCUCR) address, shared with the INT0/INT1 sense control */
+#define MCUCR_ADD			(*((volatile uint8_t *) 0x55))
+
+/** @brief Bit index of the sleep enable */
+#define SE_BIT			7
+
+/** @brief Bit index of the sleep mode select (SM2:0) */
+#define SM_INDEX		4
+
+/** @brief Mask of the sleep mode select bits (SM2:0) */
+#define SM_MASK			0x70
+
+/** @brief SM2:0 values that are reserved (4 and 5), one bit per value */
+#define SM_RESERVED_VALUES	0x30
+
+/** @brief ADC Control and Status Register A (ADCSRA) address */
+#define ADCSRA_ADD			(*((volatile uint8_t *) 0x26))
+
+/** @brief Bit index of the ADC enable */
+#define ADEN_BIT		7
+
+/** @brief Enable the interrupts and sleep: the instruction after sei always runs before an interrupt */
+#define SLEEP_SEI_SLEEP()	__asm__ __volatile__("sei\n\tsleep" ::: "memory")
+
+#endif /* SLEEP_PRIVATE_H_ */
@@ -0,0 +1,40 @@
+/**
+ * @file SLEEP_prog.c
+ * @brief Sleep Implementation
+ *
+ * This source file provides the implementation for putting the CPU to sleep and for switching
+ * the unused ADC off.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "SLEEP_interface.h"
+#include "SLEEP_private.h"
+#include "../../STD_LIB/bit_math.h"
+
+sleep_enu_return_state_t SLEEP_enter(sleep_enu_mode_t copy_enu_mode)
+{
+	sleep_enu_return_state_t enu_return_state = SLEEP_OK;
+
+	if ((copy_enu_mode >= SLEEP_INVALID_MODE) || (READ_BIT(SM_RESERVED_VALUES,copy_enu_mode) == U8_ONE_VALUE))
+	{
+		enu_return_state = SLEEP_NOK;
+	}
+	else
+	{
+		MCUCR_ADD = (uint8_t)((MCUCR_ADD & ~SM_MASK) | (copy_enu_mode << SM_INDEX));
+		SET_BIT(MCUCR_ADD,SE_BIT);
+		SLEEP_SEI_SLEEP();
+
+		// Sleep enable is only set for the sleep instruction, a stray one can't put the CPU to sleep
+		CLEAR_BIT(MCUCR_ADD,SE_BIT);
+	}
+	return enu_return_state;
+}
+
+sleep_enu_return_state_t SLEEP_adc_off(void)
+{
+	CLEAR_BIT(ADCSRA_ADD,ADEN_BIT);
+	return SLEEP_OK;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file STACK_interface.h
+ * @brief Stack Monitor Interface Header File
+ *
+ * This header file provides declarations for the stack monitor. The SRAM between the variables and the top of the stack
+ * is painted with a known value by the startup code, before main() runs. The stack overwrites the paint as it grows,
+ * so the paint left at the bottom is the stack never used since the reset: its high-water mark, interrupts included.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef STACK_INTERFACE_H_
+#define STACK_INTERFACE_H_
+
+#include "../../STD_LIB/std_types.h"
+
+
+/**
+ * @brief Enumeration for stack monitor return states.
+ */
+typedef enum {
+    STACK_OK = 0,   /**< More stack left unused than the guard. */
+    STACK_LOW       /**< Less stack left unused than the guard. */
+} stack_enu_return_state_t;
+
+
+/**
+ * @brief Read the size of the SRAM the stack can grow into, from the end of the variables to the top of the SRAM.
+ *
+ * @return The size in bytes.
+ */
+uint16_t STACK_get_size(void);
+
+/**
+ * @brief Scan the whole painted SRAM for the high-water mark of the stack.
+ *
+ * Its cost grows with the unused stack (about 1500 bytes read with few variables), for a debugger or at boot.
+ *
+ * @return The bytes of stack never used since the reset.
+ */
+uint16_t STACK_get_unused(void);
+
+/**
+ * @brief Scan the next few bytes for the high-water mark of the stack and check it against a guard.
+ *
+ * Must be called periodically: each call reads at most 32 bytes, a scan over the whole unused stack
+ * takes a call per 32 unused bytes. The last complete scan is checked, the check passes until the first one ends.
+ *
+ * @param copy_u16_guard_bytes Stack that must stay unused in bytes.
+ * @return The return state of the check.
+ *     - #STACK_OK: More stack left unused than the guard.
+ *     - #STACK_LOW: Less stack left unused than the guard.
+ */
+stack_enu_return_state_t STACK_check(uint16_t copy_u16_guard_bytes);
+
+#endif /* STACK_INTERFACE_H_ */
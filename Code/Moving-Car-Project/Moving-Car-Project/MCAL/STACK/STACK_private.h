@@ -0,0 +1,35 @@
+/**
+ * @file STACK_private.h
+ * @brief Stack Monitor Private Definitions
+ *
+ * This private header file provides the memory layout the stack monitor watches.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+
+#ifndef STACK_PRIVATE_H_
+#define STACK_PRIVATE_H_
+#include "../../STD_LIB/bit_math.h"
+#include "../../STD_LIB/std_types.h"
+
+/** @brief Last SRAM address (RAMEND), the stack starts there and grows down */
+#define STACK_TOP_ADD			((uint8_t *) 0x085F)
+
+/** @brief Value painted over the free SRAM at startup, a byte still holding it was never used by the stack */
+#define STACK_PAINT_BYTE		0xC5
+
+/** @brief Text of a macro value, to use it in the paint assembly */
+#define STACK_STR(x)			#x
+#define STACK_XSTR(x)			STACK_STR(x)
+
+/** @brief Number of bytes STACK_check() reads at most per call */
+#define STACK_SCAN_STEP_BYTES	32
+
+/** @brief End of the variables (.data, .bss and .noinit), set by the linker: the stack may grow down to it */
+extern uint8_t _end;
+
+/* The linker also sets __stack, the top of the stack (STACK_TOP_ADD), used by the paint assembly */
+
+#endif /* STACK_PRIVATE_H_ */
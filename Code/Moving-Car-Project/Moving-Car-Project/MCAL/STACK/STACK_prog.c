@@ -0,0 +1,91 @@
+/**
+ * @file STACK_prog.c
+ * @brief Stack Monitor Implementation File
+ *
+ * This file paints the free SRAM at startup and scans the paint for the high-water mark of the stack.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "STACK_interface.h"
+#include "STACK_private.h"
+
+/***************************************************************************/
+/*******				Static function prototypes					*******/
+/***************************************************************************/
+
+static void STACK_paint(void) __attribute__((naked, used, section(".init3")));
+
+
+/** @brief Next byte the periodic scan reads */
+static uint8_t *gs_ptr_u8_scan = &_end;
+
+/** @brief Unused stack found by the last complete periodic scan in bytes, the most possible until the first one ends */
+static uint16_t gs_u16_unused = 0xFFFF;
+
+
+/**
+ * @brief Paint the free SRAM, from the end of the variables to the top of the SRAM.
+ *
+ * The startup code runs it after the stack pointer is set and before the variables are initialized.
+ * It must not use the stack: it is naked, with no return, and written in assembly. A C loop may be turned
+ * into a memset() call, whose return address the loop would then paint over.
+ */
+static void STACK_paint(void)
+{
+	__asm__ __volatile__(
+		"	ldi r30, lo8(_end)\n"
+		"	ldi r31, hi8(_end)\n"
+		"	ldi r24, " STACK_XSTR(STACK_PAINT_BYTE) "\n"
+		"	ldi r25, hi8(__stack)\n"
+		"	rjmp 2f\n"
+		"1:	st Z+, r24\n"
+		"2:	cpi r30, lo8(__stack)\n"
+		"	cpc r31, r25\n"
+		"	brlo 1b\n"
+		"	breq 1b\n"
+	);
+}
+
+uint16_t STACK_get_size(void)
+{
+	return (uint16_t)(STACK_TOP_ADD - &_end) + U8_ONE_VALUE;
+}
+
+uint16_t STACK_get_unused(void)
+{
+	const uint8_t *ptr_u8_byte = &_end;
+
+	// The paint at the bottom of the stack was never overwritten
+	while ((ptr_u8_byte <= STACK_TOP_ADD) && (*ptr_u8_byte == STACK_PAINT_BYTE))
+	{
+		ptr_u8_byte++;
+	}
+	return (uint16_t)(ptr_u8_byte - &_end);
+}
+
+stack_enu_return_state_t STACK_check(uint16_t copy_u16_guard_bytes)
+{
+	stack_enu_return_state_t enu_return_state = STACK_OK;
+	uint8_t u8_bytes = U8_ZERO_VALUE;
+
+	while ((u8_bytes < STACK_SCAN_STEP_BYTES) && (gs_ptr_u8_scan <= STACK_TOP_ADD) && (*gs_ptr_u8_scan == STACK_PAINT_BYTE))
+	{
+		gs_ptr_u8_scan++;
+		u8_bytes++;
+	}
+
+	if (u8_bytes < STACK_SCAN_STEP_BYTES)
+	{
+		// Reached the used stack: the scan is complete, the next one starts from the bottom again
+		gs_u16_unused = (uint16_t)(gs_ptr_u8_scan - &_end);
+		gs_ptr_u8_scan = &_end;
+	}
+
+	if (gs_u16_unused < copy_u16_guard_bytes)
+	{
+		enu_return_state = STACK_LOW;
+	}
+	return enu_return_state;
+}
@@ -87,6 +87,13 @@ typedef enum
 	PC_INVALID_TIMER_PHASE_CORRECT_PWM_MODE
 }timer_enu_phase_correct_pwm_mode_t;
 
+typedef enum
+{
+	TIMER_COMPARE_UNIT_A,
+	TIMER_COMPARE_UNIT_B,
+	INVALID_TIMER_COMPARE_UNIT
+}timer_enu_compare_unit_t;
+
 typedef struct
 {
 	timer_enu_timer_number_t  enu_timer_no;  /* @ref timer_enu_timer_number_t*/
@@ -170,4 +177,58 @@ timer_enu_return_state_t TIMERx_reset(const timer_enu_timer_number_t copy_enu_ti
 */
 timer_enu_return_state_t TIMERx_stop(const timer_enu_timer_number_t copy_enu_timer_number);
 
+/*
+* Description :read the current value of the timer counting register
+* @param the  timer type and a pointer to store the counter value
+* @return status of the function
+*  TIMER_OK :the function done successfully
+*  TIMER_NOT_OK :the function has issues performing the function
+*/
+timer_enu_return_state_t TIMERx_getValue(const timer_enu_timer_number_t copy_enu_timer_number ,uint16_t *ptr_u16_timer_value);
+
+/*
+* Description :read the TIMER_1 counting register with the interrupts off, no interrupt can use the TEMP register
+*              between its two bytes (cheap enough to time short code in CPU cycles when TIMER_1 runs at F_CPU)
+* @param void
+* @return the counter value
+*/
+uint16_t TIMER1_getCount(void);
+
+/*
+* Description :Call the Call Back function in the application on a TIMER_1 compare unit match
+*              (the compare units can be used while TIMER_1 runs in normal mode)
+* @param A pointer to function & the compare unit (TIMER_COMPARE_UNIT_A, TIMER_COMPARE_UNIT_B)
+* @return status of the function
+*  TIMER_OK :the function done successfully
+*  TIMER_NOT_OK :the function has issues performing the function
+*/
+timer_enu_return_state_t TIMER1_setCompareUnitCallBack(ptr_to_v_fun_in_void_t ptr_v_fun_in_v, const timer_enu_compare_unit_t copy_enu_compare_unit);
+
+/*
+* Description :set the value of a TIMER_1 compare unit Output Compare Register
+* @param the compare unit and the value to be compared with TCNT1
+* @return status of the function
+*  TIMER_OK :the function done successfully
+*  TIMER_NOT_OK :the function has issues performing the function
+*/
+timer_enu_return_state_t TIMER1_setCompareUnitValue(const timer_enu_compare_unit_t copy_enu_compare_unit ,const uint16_t copy_u16_compare_value);
+
+/*
+* Description :enable the compare match interrupt of a TIMER_1 compare unit
+* @param the compare unit
+* @return status of the function
+*  TIMER_OK :the function done successfully
+*  TIMER_NOT_OK :the function has issues performing the function
+*/
+timer_enu_return_state_t TIMER1_enableCompareUnitInterrupt(const timer_enu_compare_unit_t copy_enu_compare_unit);
+
+/*
+* Description :disable the compare match interrupt of a TIMER_1 compare unit
+* @param the compare unit
+* @return status of the function
+*  TIMER_OK :the function done successfully
+*  TIMER_NOT_OK :the function has issues performing the function
+*/
+timer_enu_return_state_t TIMER1_disableCompareUnitInterrupt(const timer_enu_compare_unit_t copy_enu_compare_unit);
+
 #endif /* TIMER_H_ */
\ No newline at end of file
@@ -110,6 +110,14 @@
 #ifndef TCNT1L
 #define TCNT1L   (*(volatile uint8_t*)0x4C)
 #endif
+/*OCR1A Timer/Counter1   Output Compare Register A (16-bit access)*/
+#ifndef OCR1A
+#define OCR1A   (*(volatile uint16_t*)0x4A)
+#endif
+/*OCR1B Timer/Counter1   Output Compare Register B (16-bit access)*/
+#ifndef OCR1B
+#define OCR1B   (*(volatile uint16_t*)0x48)
+#endif
 /*OCR1AH Timer/Counter1   Output Compare Register A High Byte */
 #ifndef OCR1AH
 #define OCR1AH   (*(volatile uint8_t*)0x4B)
@@ -256,13 +264,13 @@
 #endif
 /*Bit 2:0   CS2[2:0]: Clock Select*/
 #ifndef CS20
-#define CS20 (2u)
+#define CS20 (0u)
 #endif
 #ifndef CS21
 #define CS21 (1u)
 #endif
 #ifndef CS22
-#define CS22 (0u)
+#define CS22 (2u)
 #endif
 
 /*TIMSK-TIMER 2 INTERRUPT MASK REG BITS*/
@@ -12,12 +12,14 @@
 static void (*g_Timer0_callBackPtr)(void) = NULL;
 static void (*g_Timer1_callBackPtr)(void) = NULL;
 static void (*g_Timer2_callBackPtr)(void) = NULL;
+static void (*g_Timer1_compA_callBackPtr)(void) = NULL;
+static void (*g_Timer1_compB_callBackPtr)(void) = NULL;
 
 /*helper static functions prototypes*/
 static  timer_enu_return_state_t TIMERx_selectClk(const  timer_enu_timer_number_t copy_enu_timer_number,const timer_enu_clock_t copy_enu_timer_clk);
 static  timer_enu_return_state_t TIMERx_setTimerMode(const timer_str_config_t * ptr_str_timer_Config);
 
-/***********************Interrupt Service Routines for TIMER_0 *************************/
+/***********************Interrupt Service Routines for TIMER_0, TIMER_1, TIMER_2 *************************/
 
 ISR(TIMER1_OVF)
 {
@@ -29,6 +31,24 @@ ISR(TIMER1_OVF)
 		(*g_Timer1_callBackPtr)();
 	}
 }
+ISR(TIMER1_COMPA)
+{
+	if(g_Timer1_compA_callBackPtr != NULL)
+	{
+		// The TIMER_1 compare A match flag is cleared by hardware when the ISR is executed
+		//Call the Call Back function in the upper layer after the compare match
+		(*g_Timer1_compA_callBackPtr)();
+	}
+}
+ISR(TIMER1_COMPB)
+{
+	if(g_Timer1_compB_callBackPtr != NULL)
+	{
+		// The TIMER_1 compare B match flag is cleared by hardware when the ISR is executed
+		//Call the Call Back function in the upper layer after the compare match
+		(*g_Timer1_compB_callBackPtr)();
+	}
+}
 ISR(TIMER0_OVF)
 {
 	if(g_Timer0_callBackPtr != NULL)
@@ -39,6 +59,33 @@ ISR(TIMER0_OVF)
 		(*g_Timer0_callBackPtr)();
 	}
 }
+ISR(TIMER0_COMP)
+{
+	if(g_Timer0_callBackPtr != NULL)
+	{
+		// The TIMER_0 compare match flag is cleared by hardware when the ISR is executed
+		//Call the Call Back function in the upper layer after the compare match
+		(*g_Timer0_callBackPtr)();
+	}
+}
+ISR(TIMER2_OVF)
+{
+	if(g_Timer2_callBackPtr != NULL)
+	{
+		// The TIMER_2 overflow flag is cleared by hardware when the ISR is executed
+		//Call the Call Back function in the upper layer after the timer overflow
+		(*g_Timer2_callBackPtr)();
+	}
+}
+ISR(TIMER2_COMP)
+{
+	if(g_Timer2_callBackPtr != NULL)
+	{
+		// The TIMER_2 compare match flag is cleared by hardware when the ISR is executed
+		//Call the Call Back function in the upper layer after the compare match
+		(*g_Timer2_callBackPtr)();
+	}
+}
 
 timer_enu_return_state_t TIMERx_setCallBack(  ptr_to_v_fun_in_void_t ptr_v_fun_in_v, const  timer_enu_timer_number_t copy_enu_timer_number )
 {
@@ -194,8 +241,8 @@ timer_enu_return_state_t TIMERx_CTC_SetCompare(const  timer_enu_timer_number_t c
 				break;
 				
 			case TIMER_1:
-				OCR1AL = (uint8_t)copy_u16_compare_value ;
-				OCR1AH = (uint8_t)(copy_u16_compare_value >> 8);
+				/*16-bit access writes the high byte first as required by the TEMP register*/
+				OCR1A = copy_u16_compare_value;
 				break;
 				
 			case TIMER_2:
@@ -300,6 +347,135 @@ timer_enu_return_state_t TIMERx_stop(const  timer_enu_timer_number_t copy_enu_ti
 	return  enu_return_state;
 }
 
+timer_enu_return_state_t TIMERx_getValue(const  timer_enu_timer_number_t copy_enu_timer_number ,uint16_t *ptr_u16_timer_value)
+{
+	 timer_enu_return_state_t  enu_return_state =  TIMER_OK;
+	if( (copy_enu_timer_number >= INVALID_TIMER_TYPE) || (NULL == ptr_u16_timer_value) )
+	{
+		 enu_return_state =  TIMER_NOT_OK;
+	}
+	else
+	{
+		switch(copy_enu_timer_number)
+		{
+			case TIMER_0:
+				*ptr_u16_timer_value = TCNT0;
+				break;
+				
+			case TIMER_1:
+				/*16-bit access reads the low byte first as required by the TEMP register*/
+				*ptr_u16_timer_value = TCNT1;
+				break;
+				
+			case TIMER_2:
+				*ptr_u16_timer_value = TCNT2;
+				break;
+				
+			default:
+				 enu_return_state |=  TIMER_NOT_OK;
+				break;
+		}
+	}
+	return  enu_return_state;
+}
+
+uint16_t TIMER1_getCount(void)
+{
+	uint16_t u16_count;
+	uint8_t u8_sreg;
+	
+	/*the compare unit interrupts write OCR1x through the same TEMP register*/
+	ISR_ENTER_CRITICAL(u8_sreg);
+	u16_count = TCNT1;
+	ISR_EXIT_CRITICAL(u8_sreg);
+	return u16_count;
+}
+
+timer_enu_return_state_t TIMER1_setCompareUnitCallBack(ptr_to_v_fun_in_void_t ptr_v_fun_in_v, const timer_enu_compare_unit_t copy_enu_compare_unit)
+{
+	 timer_enu_return_state_t  enu_return_state =  TIMER_OK;
+	if( (copy_enu_compare_unit >= INVALID_TIMER_COMPARE_UNIT) || (NULL==ptr_v_fun_in_v) )
+	{
+		 enu_return_state =  TIMER_NOT_OK;
+	}
+	else
+	{
+		switch(copy_enu_compare_unit)
+		{
+			case TIMER_COMPARE_UNIT_A:
+				/* load the address of the Call back function from upper layer in the global pointer to function */
+				g_Timer1_compA_callBackPtr = ptr_v_fun_in_v;
+				break;
+			case TIMER_COMPARE_UNIT_B:
+				/* load the address of the Call back function from upper layer in the global pointer to function */
+				g_Timer1_compB_callBackPtr = ptr_v_fun_in_v;
+				break;
+			default:
+				 enu_return_state =  TIMER_NOT_OK;
+				break;
+		}
+	}
+	return  enu_return_state;
+}
+
+timer_enu_return_state_t TIMER1_setCompareUnitValue(const timer_enu_compare_unit_t copy_enu_compare_unit ,const uint16_t copy_u16_compare_value)
+{
+	 timer_enu_return_state_t  enu_return_state =  TIMER_OK;
+	switch(copy_enu_compare_unit)
+	{
+		case TIMER_COMPARE_UNIT_A:
+			/*16-bit access writes the high byte first as required by the TEMP register*/
+			OCR1A = copy_u16_compare_value;
+			break;
+		case TIMER_COMPARE_UNIT_B:
+			OCR1B = copy_u16_compare_value;
+			break;
+		default:
+			 enu_return_state =  TIMER_NOT_OK;
+			break;
+	}
+	return  enu_return_state;
+}
+
+timer_enu_return_state_t TIMER1_enableCompareUnitInterrupt(const timer_enu_compare_unit_t copy_enu_compare_unit)
+{
+	 timer_enu_return_state_t  enu_return_state =  TIMER_OK;
+	switch(copy_enu_compare_unit)
+	{
+		case TIMER_COMPARE_UNIT_A:
+			/*clear a pending match (flag is cleared by writing one) then enable the interrupt*/
+			TIFR = (1u << OCF1A);
+			SET_BIT(TIMSK,OCIE1A);
+			break;
+		case TIMER_COMPARE_UNIT_B:
+			TIFR = (1u << OCF1B);
+			SET_BIT(TIMSK,OCIE1B);
+			break;
+		default:
+			 enu_return_state =  TIMER_NOT_OK;
+			break;
+	}
+	return  enu_return_state;
+}
+
+timer_enu_return_state_t TIMER1_disableCompareUnitInterrupt(const timer_enu_compare_unit_t copy_enu_compare_unit)
+{
+	 timer_enu_return_state_t  enu_return_state =  TIMER_OK;
+	switch(copy_enu_compare_unit)
+	{
+		case TIMER_COMPARE_UNIT_A:
+			CLEAR_BIT(TIMSK,OCIE1A);
+			break;
+		case TIMER_COMPARE_UNIT_B:
+			CLEAR_BIT(TIMSK,OCIE1B);
+			break;
+		default:
+			 enu_return_state =  TIMER_NOT_OK;
+			break;
+	}
+	return  enu_return_state;
+}
+
 static timer_enu_return_state_t TIMERx_selectClk(const  timer_enu_timer_number_t copy_enu_timer_number,const timer_enu_clock_t copy_enu_timer_clk)
 {
 	 timer_enu_return_state_t  enu_return_state =  TIMER_OK;
@@ -491,9 +667,15 @@ static timer_enu_return_state_t TIMERx_setTimerMode(const timer_str_config_t * p
 						/*Normal port operation, OC0 disconnected*/
 						CLEAR_BIT(TCCR0,COM00);
 						CLEAR_BIT(TCCR0,COM01);
-						/* Enable TIMER_0 overflow interrupt*/
-						//TIMSK |= 1<< TOIE0;
-						SET_BIT(TIMSK,TOIE0);
+						/* Enable TIMER_0 overflow interrupt, only with a call-back to run*/
+						if(g_Timer0_callBackPtr != NULL)
+						{
+							SET_BIT(TIMSK,TOIE0);
+						}
+						else
+						{
+							CLEAR_BIT(TIMSK,TOIE0);
+						}
 						break;
 					case TIMER_PHASE_CORRECT_PWM_MODE:
 						/*PWM Phase Correct*/
@@ -607,9 +789,15 @@ static timer_enu_return_state_t TIMERx_setTimerMode(const timer_str_config_t * p
 						CLEAR_BIT(TCCR1A,COM1A1);
 						CLEAR_BIT(TCCR1A,COM1B0);
 						CLEAR_BIT(TCCR1A,COM1B1);
-						/* Enable TIMER_0 overflow interrupt*/
-						//TIMSK |= 1<<  TOIE1;
-						SET_BIT(TIMSK,TOIE1);
+						/* Enable TIMER_1 overflow interrupt, only with a call-back to run*/
+						if(g_Timer1_callBackPtr != NULL)
+						{
+							SET_BIT(TIMSK,TOIE1);
+						}
+						else
+						{
+							CLEAR_BIT(TIMSK,TOIE1);
+						}
 						break;
 					case TIMER_PHASE_CORRECT_PWM_MODE:
 						/*PWM Phase Correct 8-bit,top= 0x00FF ,Update of OCR1A at TOP,TOV1 Flag Set on BOTTOM*/
@@ -765,8 +953,15 @@ static timer_enu_return_state_t TIMERx_setTimerMode(const timer_str_config_t * p
 						/*Normal port operation, OC2 disconnected*/
 						CLEAR_BIT(TCCR2,COM20);
 						CLEAR_BIT(TCCR2,COM21);
-						/* Enable TIMER_2 overflow interrupt*/
-						SET_BIT(TIMSK,TOIE2);
+						/* Enable TIMER_2 overflow interrupt, only with a call-back to run*/
+						if(g_Timer2_callBackPtr != NULL)
+						{
+							SET_BIT(TIMSK,TOIE2);
+						}
+						else
+						{
+							CLEAR_BIT(TIMSK,TOIE2);
+						}
 						break;
 					case TIMER_PHASE_CORRECT_PWM_MODE:
 						/*PWM Phase Correct*/
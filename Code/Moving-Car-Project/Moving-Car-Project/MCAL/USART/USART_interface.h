@@ -0,0 +1,89 @@
+/**
+ * @file USART_interface.h
+ * @brief USART Interface Header File
+ *
+ * This header file provides declarations for the USART driver: 8N1 frames on PD0 (RXD) and PD1 (TXD).
+ *
+ * Writes are copied to a ring buffer and return at once, the data register empty interrupt sends
+ * the bytes one after the other. The receive complete interrupt stores the received bytes in another
+ * ring buffer, they are read and parsed outside the interrupt.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef USART_INTERFACE_H_
+#define USART_INTERFACE_H_
+
+#include "../../STD_LIB/std_types.h"
+
+
+/** @brief Baud rate register value: 38400 baud with double speed and F_CPU = 8M (0.2% error) */
+#define USART_UBRR_VALUE		25
+
+/** @brief Size of the transmit ring buffer in bytes (a power of 2) */
+#define USART_TX_BUFFER_SIZE	64
+
+/** @brief Size of the receive ring buffer in bytes (a power of 2), holds 16 ms of bytes at 38400 baud */
+#define USART_RX_BUFFER_SIZE	64
+
+
+/**
+ * @brief Enumeration for USART return states.
+ */
+typedef enum {
+    USART_OK = 0,       /**< Operation performed successfully. */
+    USART_NOK,          /**< NULL pointer. */
+    USART_BUFFER_FULL,  /**< Not enough room in the ring buffer, nothing was written. */
+    USART_EMPTY         /**< No received byte to read. */
+} usart_enu_return_state_t;
+
+
+/**
+ * @brief Initialize the USART: 38400 baud 8N1, transmitter and receiver enabled.
+ *
+ * @return The return state of the initialization.
+ *     - #USART_OK: USART initialization successful.
+ */
+usart_enu_return_state_t USART_init(void);
+
+/**
+ * @brief Queue bytes for sending.
+ *
+ * The bytes are all queued or none of them, so a frame is never cut. The function returns at once.
+ *
+ * @param ptr_data Pointer to the bytes.
+ * @param copy_u8_size Number of bytes.
+ * @return The return state of the write.
+ *     - #USART_OK: Bytes queued successfully.
+ *     - #USART_NOK: NULL pointer.
+ *     - #USART_BUFFER_FULL: Not enough room, nothing was queued.
+ */
+usart_enu_return_state_t USART_write(const void *ptr_data, uint8_t copy_u8_size);
+
+/**
+ * @brief Read the room left in the transmit ring buffer.
+ *
+ * @return Number of bytes that can be queued.
+ */
+uint8_t USART_get_tx_free(void);
+
+/**
+ * @brief Read the next received byte.
+ *
+ * @param ptr_u8_data Pointer to store the byte.
+ * @return The return state of the read.
+ *     - #USART_OK: Byte read successfully.
+ *     - #USART_NOK: NULL pointer.
+ *     - #USART_EMPTY: No byte was received since the last read.
+ */
+usart_enu_return_state_t USART_read(uint8_t *ptr_u8_data);
+
+/**
+ * @brief Read the number of received bytes lost, on a full receive ring buffer or a hardware overrun.
+ *
+ * @return The number of lost bytes (saturates at 65535).
+ */
+uint16_t USART_get_rx_lost(void);
+
+#endif /* USART_INTERFACE_H_ */
@@ -0,0 +1,62 @@
+/**
+ * @file USART_private.h
+ * @brief USART Private Register Definitions
+ *
+ * This private header file provides the register definitions used for configuring
+ * the USART. It defines the addresses of the relevant registers and their bit indices.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+
+#ifndef USART_PRIVATE_H_
+#define USART_PRIVATE_H_
+#include "../../STD_LIB/std_types.h"
+
+/** @brief USART I/O Data Register (UDR) address */
+#define UDR_ADD				(*((volatile uint8_t *) 0x2C))
+
+/** @brief USART Control and Status Register A (UCSRA) address */
+#define UCSRA_ADD			(*((volatile uint8_t *) 0x2B))
+
+/** @brief Bit index of the frame error flag */
+#define FE_BIT			4
+
+/** @brief Bit index of the data overrun flag */
+#define DOR_BIT			3
+
+/** @brief Bit index of the double transmission speed */
+#define U2X_BIT			1
+
+/** @brief USART Control and Status Register B (UCSRB) address */
+#define UCSRB_ADD			(*((volatile uint8_t *) 0x2A))
+
+/** @brief Bit index of the receive complete interrupt enable */
+#define RXCIE_BIT		7
+
+/** @brief Bit index of the data register empty interrupt enable */
+#define UDRIE_BIT		5
+
+/** @brief Bit index of the receiver enable */
+#define RXEN_BIT		4
+
+/** @brief Bit index of the transmitter enable */
+#define TXEN_BIT		3
+
+/** @brief USART Control and Status Register C (UCSRC) address, shared with UBRRH and selected by URSEL */
+#define UCSRC_ADD			(*((volatile uint8_t *) 0x40))
+
+/** @brief Bit index of the register select (1 = UCSRC, 0 = UBRRH) */
+#define URSEL_BIT		7
+
+/** @brief UCSRC value of 8 data bits, no parity, 1 stop bit (URSEL, UCSZ1, UCSZ0) */
+#define UCSRC_8N1			0x86
+
+/** @brief USART Baud Rate Register High (UBRRH) address, shared with UCSRC */
+#define UBRRH_ADD			(*((volatile uint8_t *) 0x40))
+
+/** @brief USART Baud Rate Register Low (UBRRL) address */
+#define UBRRL_ADD			(*((volatile uint8_t *) 0x29))
+
+#endif /* USART_PRIVATE_H_ */
@@ -0,0 +1,172 @@
+/**
+ * @file USART_prog.c
+ * @brief USART Implementation
+ *
+ * This source file provides the implementation for initializing the USART and for the ring buffered transmit.
+ * It also includes the interrupt service routines (ISR) for the data register empty and the receive complete events.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "USART_interface.h"
+#include "USART_private.h"
+#include "../AVR_ARCH/ISR_interface.h"
+#include "../../STD_LIB/bit_math.h"
+
+/** @brief Index mask of the transmit ring buffer */
+#define USART_TX_MASK		(USART_TX_BUFFER_SIZE - 1)
+
+/** @brief Index mask of the receive ring buffer */
+#define USART_RX_MASK		(USART_RX_BUFFER_SIZE - 1)
+
+/** @brief Transmit ring buffer */
+static volatile uint8_t gv_au8_usart_tx_buffer[USART_TX_BUFFER_SIZE];
+
+/** @brief Index of the next byte to queue, only written by USART_write() */
+static volatile uint8_t gv_u8_usart_tx_head = U8_ZERO_VALUE;
+
+/** @brief Index of the next byte to send, only written by the interrupt */
+static volatile uint8_t gv_u8_usart_tx_tail = U8_ZERO_VALUE;
+
+/** @brief Receive ring buffer */
+static volatile uint8_t gv_au8_usart_rx_buffer[USART_RX_BUFFER_SIZE];
+
+/** @brief Index of the next received byte to store, only written by the interrupt */
+static volatile uint8_t gv_u8_usart_rx_head = U8_ZERO_VALUE;
+
+/** @brief Index of the next received byte to read, only written by USART_read() */
+static volatile uint8_t gv_u8_usart_rx_tail = U8_ZERO_VALUE;
+
+/** @brief Received bytes lost */
+static volatile uint16_t gv_u16_usart_rx_lost = U8_ZERO_VALUE;
+
+
+usart_enu_return_state_t USART_init(void)
+{
+	UBRRH_ADD = (uint8_t)(USART_UBRR_VALUE >> 8);
+	UBRRL_ADD = (uint8_t)USART_UBRR_VALUE;
+	SET_BIT(UCSRA_ADD,U2X_BIT);
+	UCSRC_ADD = UCSRC_8N1;
+	SET_BIT(UCSRB_ADD,TXEN_BIT);
+	SET_BIT(UCSRB_ADD,RXEN_BIT);
+	SET_BIT(UCSRB_ADD,RXCIE_BIT);
+	return USART_OK;
+}
+
+uint8_t USART_get_tx_free(void)
+{
+	// One slot stays empty to tell a full buffer from an empty one
+	return (uint8_t)(USART_TX_MASK - ((gv_u8_usart_tx_head - gv_u8_usart_tx_tail) & USART_TX_MASK));
+}
+
+usart_enu_return_state_t USART_write(const void *ptr_data, uint8_t copy_u8_size)
+{
+	usart_enu_return_state_t enu_return_state = USART_OK;
+	const uint8_t *ptr_u8_data = (const uint8_t *)ptr_data;
+	uint8_t u8_head;
+
+	if (ptr_data == NULL)
+	{
+		enu_return_state = USART_NOK;
+	}
+	else if (copy_u8_size > USART_get_tx_free())
+	{
+		enu_return_state = USART_BUFFER_FULL;
+	}
+	else
+	{
+		// The interrupt only moves the tail, the head is published once the bytes are in
+		u8_head = gv_u8_usart_tx_head;
+		for (uint8_t u8_index = U8_ZERO_VALUE ; u8_index < copy_u8_size ; u8_index++)
+		{
+			gv_au8_usart_tx_buffer[u8_head] = ptr_u8_data[u8_index];
+			u8_head = (uint8_t)((u8_head + U8_ONE_VALUE) & USART_TX_MASK);
+		}
+		gv_u8_usart_tx_head = u8_head;
+		SET_BIT(UCSRB_ADD,UDRIE_BIT);
+	}
+	return enu_return_state;
+}
+
+usart_enu_return_state_t USART_read(uint8_t *ptr_u8_data)
+{
+	usart_enu_return_state_t enu_return_state = USART_OK;
+	uint8_t u8_tail = gv_u8_usart_rx_tail;
+
+	if (ptr_u8_data == NULL)
+	{
+		enu_return_state = USART_NOK;
+	}
+	else if (u8_tail == gv_u8_usart_rx_head)
+	{
+		enu_return_state = USART_EMPTY;
+	}
+	else
+	{
+		*ptr_u8_data = gv_au8_usart_rx_buffer[u8_tail];
+		gv_u8_usart_rx_tail = (uint8_t)((u8_tail + U8_ONE_VALUE) & USART_RX_MASK);
+	}
+	return enu_return_state;
+}
+
+uint16_t USART_get_rx_lost(void)
+{
+	uint16_t u16_lost;
+	uint8_t u8_sreg;
+
+	ISR_ENTER_CRITICAL(u8_sreg);
+	u16_lost = gv_u16_usart_rx_lost;
+	ISR_EXIT_CRITICAL(u8_sreg);
+	return u16_lost;
+}
+
+/**
+ * @brief Interrupt Service Routine for the data register empty event.
+ *
+ * Sends the next queued byte, the interrupt is disabled once the ring buffer is empty.
+ */
+ISR(USART_UDRE)
+{
+	uint8_t u8_tail = gv_u8_usart_tx_tail;
+
+	if (u8_tail == gv_u8_usart_tx_head)
+	{
+		CLEAR_BIT(UCSRB_ADD,UDRIE_BIT);
+	}
+	else
+	{
+		UDR_ADD = gv_au8_usart_tx_buffer[u8_tail];
+		gv_u8_usart_tx_tail = (uint8_t)((u8_tail + U8_ONE_VALUE) & USART_TX_MASK);
+	}
+}
+
+/**
+ * @brief Interrupt Service Routine for the receive complete event.
+ *
+ * Stores the received byte. A byte with a frame error or one that finds the ring buffer full is dropped,
+ * it is counted as lost like the bytes the hardware overran.
+ */
+ISR(USART_RXC)
+{
+	uint8_t u8_status = UCSRA_ADD;
+	uint8_t u8_data = UDR_ADD;
+	uint8_t u8_head = gv_u8_usart_rx_head;
+	uint8_t u8_next = (uint8_t)((u8_head + U8_ONE_VALUE) & USART_RX_MASK);
+	uint8_t u8_lost = READ_BIT(u8_status,DOR_BIT);
+
+	if ((READ_BIT(u8_status,FE_BIT) != U8_ZERO_VALUE) || (u8_next == gv_u8_usart_rx_tail))
+	{
+		u8_lost++;
+	}
+	else
+	{
+		gv_au8_usart_rx_buffer[u8_head] = u8_data;
+		gv_u8_usart_rx_head = u8_next;
+	}
+
+	if (u8_lost != U8_ZERO_VALUE)
+	{
+		gv_u16_usart_rx_lost = (gv_u16_usart_rx_lost > (0xFFFF - u8_lost)) ? 0xFFFF : (gv_u16_usart_rx_lost + u8_lost);
+	}
+}
@@ -0,0 +1,90 @@
+/**
+ * @file WDT_interface.h
+ * @brief Watchdog Timer Interface Header File
+ *
+ * This header file provides declarations for the watchdog timer: it resets the MCU unless it is
+ * serviced within its timeout. It runs from its own 1 MHz oscillator, in every sleep mode as well.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#ifndef WDT_INTERFACE_H_
+#define WDT_INTERFACE_H_
+
+#include "../../STD_LIB/std_types.h"
+
+
+/** @brief Reset flag: power-on reset */
+#define WDT_RESET_POWER_ON		0x01
+
+/** @brief Reset flag: external reset (RESET pin) */
+#define WDT_RESET_EXTERNAL		0x02
+
+/** @brief Reset flag: brown-out reset */
+#define WDT_RESET_BROWN_OUT		0x04
+
+/** @brief Reset flag: watchdog reset */
+#define WDT_RESET_WATCHDOG		0x08
+
+/** @brief Reset flag: JTAG reset */
+#define WDT_RESET_JTAG			0x10
+
+
+/**
+ * @brief Enumeration for WDT return states.
+ */
+typedef enum {
+    WDT_OK = 0,     /**< Operation performed successfully. */
+    WDT_NOK         /**< Invalid timeout. */
+} wdt_enu_return_state_t;
+
+/**
+ * @brief Enumeration for the watchdog timeouts at 5 V (about 10% longer at 3 V), the values are the WDP2:0 bits.
+ */
+typedef enum {
+    WDT_TIMEOUT_16MS = 0,   /**< 16.3 ms. */
+    WDT_TIMEOUT_32MS,       /**< 32.5 ms. */
+    WDT_TIMEOUT_65MS,       /**< 65 ms. */
+    WDT_TIMEOUT_130MS,      /**< 0.13 s. */
+    WDT_TIMEOUT_260MS,      /**< 0.26 s. */
+    WDT_TIMEOUT_520MS,      /**< 0.52 s. */
+    WDT_TIMEOUT_1S,         /**< 1.0 s. */
+    WDT_TIMEOUT_2S,         /**< 2.1 s. */
+    WDT_INVALID_TIMEOUT
+} wdt_enu_timeout_t;
+
+
+/**
+ * @brief Start the watchdog timer from zero.
+ *
+ * @param copy_enu_timeout The timeout.
+ * @return The return state of enabling the watchdog.
+ *     - #WDT_OK: Watchdog started.
+ *     - #WDT_NOK: Invalid timeout.
+ */
+wdt_enu_return_state_t WDT_enable(wdt_enu_timeout_t copy_enu_timeout);
+
+/**
+ * @brief Stop the watchdog timer, with the timed sequence the hardware requires.
+ *
+ * @return The return state of disabling the watchdog.
+ *     - #WDT_OK: Watchdog stopped.
+ */
+wdt_enu_return_state_t WDT_disable(void);
+
+/**
+ * @brief Service the watchdog timer, it starts counting its timeout again.
+ */
+void WDT_service(void);
+
+/**
+ * @brief Read and clear the cause of the last reset.
+ *
+ * Must be called once at boot, the flags add up across resets until cleared.
+ *
+ * @return The reset flags (#WDT_RESET_POWER_ON, #WDT_RESET_EXTERNAL, #WDT_RESET_BROWN_OUT, #WDT_RESET_WATCHDOG, #WDT_RESET_JTAG).
+ */
+uint8_t WDT_get_reset_cause(void);
+
+#endif /* WDT_INTERFACE_H_ */
@@ -0,0 +1,38 @@
+/**
+ * @file WDT_private.h
+ * @brief Watchdog Timer Private Register Definitions
+ *
+ * This private header file provides the register definitions used for configuring
+ * the watchdog timer and reading the reset cause.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+
+#ifndef WDT_PRIVATE_H_
+#define WDT_PRIVATE_H_
+#include "../../STD_LIB/std_types.h"
+
+/** @brief Watchdog Timer Control Register (WDTCR) address */
+#define WDTCR_ADD			(*((volatile uint8_t *) 0x41))
+
+/** @brief Bit index of the watchdog turn-off enable */
+#define WDTOE_BIT		4
+
+/** @brief Bit index of the watchdog enable */
+#define WDE_BIT			3
+
+/** @brief Mask of the watchdog prescaler bits (WDP2:0) */
+#define WDP_MASK		0x07
+
+/** @brief MCU Control and Status Register (MCUCSR) address, shared with the INT2 sense control and JTAG disable */
+#define MCUCSR_ADD			(*((volatile uint8_t *) 0x54))
+
+/** @brief Mask of the reset flags (JTRF, WDRF, BORF, EXTRF, PORF) */
+#define RESET_FLAGS_MASK	0x1F
+
+/** @brief Reset the watchdog timer */
+#define WDT_WDR()			__asm__ __volatile__("wdr" ::: "memory")
+
+#endif /* WDT_PRIVATE_H_ */
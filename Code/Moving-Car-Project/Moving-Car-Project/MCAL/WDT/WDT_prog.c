@@ -0,0 +1,58 @@
+/**
+ * @file WDT_prog.c
+ * @brief Watchdog Timer Implementation
+ *
+ * This source file provides the implementation for starting, stopping and servicing the watchdog timer
+ * and for reading the reset cause.
+ *
+ * @date 2023-08-21
+ * @author Arafa Arafa
+ */
+
+#include "WDT_interface.h"
+#include "WDT_private.h"
+#include "../AVR_ARCH/ISR_interface.h"
+#include "../../STD_LIB/bit_math.h"
+
+wdt_enu_return_state_t WDT_enable(wdt_enu_timeout_t copy_enu_timeout)
+{
+	wdt_enu_return_state_t enu_return_state = WDT_OK;
+
+	if (copy_enu_timeout >= WDT_INVALID_TIMEOUT)
+	{
+		enu_return_state = WDT_NOK;
+	}
+	else
+	{
+		WDT_WDR();
+		WDTCR_ADD = (uint8_t)((BIT_MASK << WDE_BIT) | (copy_enu_timeout & WDP_MASK));
+	}
+	return enu_return_state;
+}
+
+wdt_enu_return_state_t WDT_disable(void)
+{
+	uint8_t u8_sreg;
+
+	// WDE can only be cleared within 4 cycles of setting WDTOE: no interrupt in between
+	ISR_ENTER_CRITICAL(u8_sreg);
+	WDT_WDR();
+	WDTCR_ADD = (uint8_t)((BIT_MASK << WDTOE_BIT) | (BIT_MASK << WDE_BIT));
+	WDTCR_ADD = U8_ZERO_VALUE;
+	ISR_EXIT_CRITICAL(u8_sreg);
+	return WDT_OK;
+}
+
+void WDT_service(void)
+{
+	WDT_WDR();
+}
+
+uint8_t WDT_get_reset_cause(void)
+{
+	uint8_t u8_cause = (uint8_t)(MCUCSR_ADD & RESET_FLAGS_MASK);
+
+	// The flags are cleared by writing 0, the other bits are kept
+	MCUCSR_ADD &= (uint8_t)~RESET_FLAGS_MASK;
+	return u8_cause;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file crc16.c
+ * @brief CRC-16/CCITT checksum implementation.
+ *
+ * @date 8/21/2023
+ * @author Arafa Arafa
+ */
+
+#include "crc16.h"
+#include "bit_math.h"
+
+/** @brief CRC-16/CCITT polynomial */
+#define CRC16_POLYNOMIAL	((uint16_t)0x1021)
+
+uint16_t CRC16_update(uint16_t copy_u16_crc, uint8_t copy_u8_data)
+{
+	copy_u16_crc ^= (uint16_t)((uint16_t)copy_u8_data << 8);
+	for (uint8_t u8_bit = U8_ZERO_VALUE ; u8_bit < 8 ; u8_bit++)
+	{
+		if ((copy_u16_crc & 0x8000) != 0)
+		{
+			copy_u16_crc = (uint16_t)((copy_u16_crc << 1) ^ CRC16_POLYNOMIAL);
+		}
+		else
+		{
+			copy_u16_crc = (uint16_t)(copy_u16_crc << 1);
+		}
+	}
+	return copy_u16_crc;
+}
+
+uint16_t CRC16_block(uint16_t copy_u16_crc, const void *ptr_data, uint16_t copy_u16_size)
+{
+	const uint8_t *ptr_u8_data = (const uint8_t *)ptr_data;
+
+	for (uint16_t u16_index = U8_ZERO_VALUE ; u16_index < copy_u16_size ; u16_index++)
+	{
+		copy_u16_crc = CRC16_update(copy_u16_crc, ptr_u8_data[u16_index]);
+	}
+	return copy_u16_crc;
+}
@@ -0,0 +1,40 @@
+/**
+ * @file crc16.h
+ * @brief CRC-16/CCITT checksum.
+ *
+ * Polynomial 0x1021, initial value #CRC16_INIT, no reflection (CRC-16/CCITT-FALSE): the CRC of "123456789" is 0x29B1.
+ * It is computed bit by bit, without a table, to keep the flash and RAM free.
+ *
+ * @date 8/21/2023
+ * @author Arafa Arafa
+ */
+
+
+#ifndef CRC16_H_
+#define CRC16_H_
+
+#include "std_types.h"
+
+/** @brief Initial value of a CRC */
+#define CRC16_INIT		((uint16_t)0xFFFF)
+
+/**
+ * @brief Add a byte to a CRC.
+ *
+ * @param copy_u16_crc CRC so far (#CRC16_INIT for the first byte).
+ * @param copy_u8_data Byte to add.
+ * @return The CRC including the byte.
+ */
+uint16_t CRC16_update(uint16_t copy_u16_crc, uint8_t copy_u8_data);
+
+/**
+ * @brief Add a block of bytes to a CRC.
+ *
+ * @param copy_u16_crc CRC so far (#CRC16_INIT for the first block).
+ * @param ptr_data Pointer to the bytes.
+ * @param copy_u16_size Number of bytes.
+ * @return The CRC including the block.
+ */
+uint16_t CRC16_block(uint16_t copy_u16_crc, const void *ptr_data, uint16_t copy_u16_size);
+
+#endif /* CRC16_H_ */
@@ -0,0 +1,119 @@
+/**
+ * @file protothread.h
+ * @brief Protothreads: stackless coroutines for cooperative sequencing.
+ *
+ * A protothread is a function that returns whenever it has to wait and carries on from that point on the next call.
+ * It is written as linear code between PT_BEGIN() and PT_END(), its whole state is a pt_str_t (4 bytes): the line
+ * to resume at and the start of the running wait. Every call jumps straight to that line, so a resume costs the same
+ * whatever the length of the thread.
+ *
+ * Rules of the thread function:
+ *  - It returns uint8_t and takes the pt_str_t to resume.
+ *  - Local variables are lost at every wait, keep the state in static variables.
+ *  - No switch statement may wait: the macros are built on a switch on the resume line.
+ *  - One wait per source line: the line number is the resume point.
+ *
+ * Example:
+ * @code{.c}
+ * static uint8_t blink_thread(pt_str_t *ptr_pt)
+ * {
+ *     PT_BEGIN(ptr_pt);
+ *     while (1)
+ *     {
+ *         LED_on(ptr_led);
+ *         PT_WAIT_MS(ptr_pt, now_ms(), 500);
+ *         LED_off(ptr_led);
+ *         PT_WAIT_EVENT(ptr_pt, button_pushed() == TRUE);
+ *     }
+ *     PT_END(ptr_pt);
+ * }
+ * @endcode
+ *
+ * @date 8/21/2023
+ * @author Arafa Arafa
+ */
+
+
+#ifndef PROTOTHREAD_H_
+#define PROTOTHREAD_H_
+
+#include "std_types.h"
+
+
+/** @brief Thread return value: the thread waits and must be called again */
+#define PT_WAITING		(0u)
+
+/** @brief Thread return value: the thread ran to PT_END() or PT_EXIT() and starts over on the next call */
+#define PT_ENDED		(1u)
+
+/**
+ * @brief State of a protothread.
+ */
+typedef struct {
+	uint16_t u16_lc;			/**< Line the thread resumes at, 0 to start from PT_BEGIN(). */
+	uint16_t u16_wait_start;	/**< Time the running timed wait started at (unit of the caller's clock). */
+} pt_str_t;
+
+
+/** @cond */
+#if defined(__GNUC__) && (__GNUC__ >= 7)
+#define PT_FALLTHROUGH		__attribute__((fallthrough))
+#else
+#define PT_FALLTHROUGH
+#endif
+/** @endcond */
+
+/**
+ * @brief Initialize a protothread, its next call starts from PT_BEGIN().
+ */
+#define PT_INIT(ptr_pt)					do{ (ptr_pt)->u16_lc = 0; }while(0)
+
+/**
+ * @brief Start the body of a protothread, resumes at the line of the last wait.
+ */
+#define PT_BEGIN(ptr_pt)				switch((ptr_pt)->u16_lc) { case 0:
+
+/**
+ * @brief End the body of a protothread: it returns #PT_ENDED and starts over on the next call.
+ */
+#define PT_END(ptr_pt)					} (ptr_pt)->u16_lc = 0; return PT_ENDED
+
+/**
+ * @brief Wait until a condition is true, it is evaluated again on every call.
+ */
+#define PT_WAIT_EVENT(ptr_pt, cond)		do{ (ptr_pt)->u16_lc = __LINE__; PT_FALLTHROUGH; case __LINE__: \
+											if(!(cond)) { return PT_WAITING; } }while(0)
+
+/**
+ * @brief Start timing a wait, PT_ELAPSED() gives the time since.
+ *
+ * @param now Current time of a free running uint16_t clock (usually in ms).
+ */
+#define PT_TIMER_START(ptr_pt, now)		do{ (ptr_pt)->u16_wait_start = (now); }while(0)
+
+/**
+ * @brief Time since PT_TIMER_START(), right across the clock wrap around.
+ */
+#define PT_ELAPSED(ptr_pt, now)			((uint16_t)((uint16_t)(now) - (ptr_pt)->u16_wait_start))
+
+/**
+ * @brief Wait for a time.
+ *
+ * @param now Current time of a free running uint16_t clock, evaluated on every call.
+ * @param time Time to wait, in the unit of the clock (up to 65535).
+ */
+#define PT_WAIT_MS(ptr_pt, now, time)	do{ PT_TIMER_START(ptr_pt, now); \
+											PT_WAIT_EVENT(ptr_pt, PT_ELAPSED(ptr_pt, now) >= (time)); }while(0)
+
+/**
+ * @brief Give the other work a turn, the thread carries on from here on the next call.
+ */
+#define PT_YIELD(ptr_pt)				do{ (ptr_pt)->u16_lc = __LINE__; return PT_WAITING; case __LINE__:; }while(0)
+
+/**
+ * @brief Leave the thread: it returns #PT_ENDED and starts over on the next call.
+ */
+#define PT_EXIT(ptr_pt)					do{ (ptr_pt)->u16_lc = 0; return PT_ENDED; }while(0)
+
+
+#endif /* PROTOTHREAD_H_ */
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""Read and change the runtime parameters of the Moving Car over its serial link.
+
+Every command is a telemetry frame answered by a reply frame, see
+HAL/COMMAND/COMMAND_interface.h. The parameter numbers are app_enu_param_t
+in APP/APP_interface.h.
+
+Usage (needs pyserial):
+    param_tool.py /dev/ttyUSB0 get duration 1        long side timeout
+    param_tool.py /dev/ttyUSB0 set speed 1 60        long side at 60 %
+    param_tool.py /dev/ttyUSB0 save                  keep the changes across resets
+    param_tool.py /dev/ttyUSB0 teleop 40 -20 3       drive at 40 %, turning right, for 3 s
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+from telemetry_decode import BAUD_RATE, SYNC, crc16, frames
+
+FRAME_GET = 2
+FRAME_SET = 3
+FRAME_SAVE = 4
+FRAME_REPLY = 5
+FRAME_TELEOP = 6
+
+# app_enu_param_t in APP/APP_interface.h
+PARAMS = {
+    "duration": 0,
+    "speed": 1,
+    "goal": 2,
+    "brightness": 3,
+    "heading_hold": 4,
+    "park_sleep": 5,
+    "debounce": 6,
+    "teleop_timeout": 7,
+}
+
+# cmd_enu_status_t in HAL/COMMAND/COMMAND_interface.h
+STATUSES = ("OK", "UNKNOWN_PARAM", "OUT_OF_RANGE", "BAD_LENGTH", "BUSY", "UNKNOWN_COMMAND")
+
+REPLY_FORMAT = "<BHBBBi"
+TIMEOUT_S = 1.0
+TELEOP_PERIOD_S = 0.02
+
+
+def encode(frame_type, sequence, payload):
+    """Frame a payload as the car does."""
+    body = struct.pack("<BBH", frame_type, len(payload), sequence) + payload
+    return SYNC + body + struct.pack("<H", crc16(body))
+
+
+def command(port, frame_type, sequence, payload):
+    """Send a command and wait for its reply, the status frames in between are skipped."""
+    port.write(encode(frame_type, sequence, payload))
+    deadline = time.monotonic() + TIMEOUT_S
+
+    def chunks():
+        while time.monotonic() < deadline:
+            yield port.read(64)
+
+    for reply_type, _, reply in frames(chunks()):
+        if reply_type != FRAME_REPLY or len(reply) != struct.calcsize(REPLY_FORMAT):
+            continue
+        command_type, command_sequence, status, _, _, value = struct.unpack(REPLY_FORMAT, reply)
+        if command_type == frame_type and command_sequence == sequence:
+            return status, value
+    return None, None
+
+
+def teleop(port, linear, angular, seconds):
+    """Stream a setpoint at 50 Hz, the car brakes on its teleoperation timeout once the stream stops."""
+    sequence = 0
+    end = time.monotonic() + seconds
+    while time.monotonic() < end:
+        port.write(encode(FRAME_TELEOP, sequence, struct.pack("<bb", linear, angular)))
+        sequence = (sequence + 1) & 0xFFFF
+        time.sleep(TELEOP_PERIOD_S)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("port", help="serial port of the car")
+    parser.add_argument("action", choices=("get", "set", "save", "teleop"))
+    parser.add_argument("param", nargs="?", help="|".join(PARAMS))
+    parser.add_argument("index", nargs="?", type=int, default=0, help="segment of the route parameters")
+    parser.add_argument("value", nargs="?", type=int, help="new value (set)")
+    args = parser.parse_args()
+
+    if args.action == "teleop":
+        # teleop LINEAR ANGULAR SECONDS: the positional arguments are reused
+        if args.value is None:
+            parser.error("teleop needs the linear and angular velocity and the time in s")
+    elif args.action != "save" and args.param not in PARAMS:
+        parser.error("unknown parameter")
+    elif args.action == "set" and args.value is None:
+        parser.error("set needs a value")
+
+    import serial  # pyserial
+    port = serial.Serial(args.port, BAUD_RATE, timeout=0.05)
+
+    if args.action == "teleop":
+        teleop(port, int(args.param), args.index, args.value)
+        return 0
+
+    sequence = int(time.monotonic() * 1000) & 0xFFFF
+
+    if args.action == "save":
+        status, value = command(port, FRAME_SAVE, sequence, b"")
+    elif args.action == "get":
+        status, value = command(port, FRAME_GET, sequence, struct.pack("<BB", PARAMS[args.param], args.index))
+    else:
+        status, value = command(port, FRAME_SET, sequence,
+                                struct.pack("<BBi", PARAMS[args.param], args.index, args.value))
+
+    if status is None:
+        print("no reply", file=sys.stderr)
+        return 1
+    name = STATUSES[status] if status < len(STATUSES) else str(status)
+    print("%s %d" % (name, value) if args.action != "save" else name)
+    return 0 if status == 0 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""Decode the telemetry frames of the Moving Car.
+
+Reads the byte stream of the car's USART (38400 baud 8N1) from a serial port
+or a capture file and prints one line per status frame. Frames with a bad
+CRC are skipped and resynchronised on the next sync bytes, gaps in the
+sequence numbers are reported as lost frames.
+
+Frame layout (little endian), see HAL/TELEMETRY/TELEMETRY_interface.h:
+    0xA5 0x5A | type | length | sequence (2) | payload (length) | CRC-16 (2)
+
+Usage:
+    telemetry_decode.py /dev/ttyUSB0        (needs pyserial)
+    telemetry_decode.py capture.bin
+"""
+
+import argparse
+import struct
+import sys
+
+SYNC = b"\xa5\x5a"
+HEADER_SIZE = 6
+CRC_SIZE = 2
+BAUD_RATE = 38400
+
+FRAME_STATUS = 1
+
+# app_str_telemetry_t in APP/APP_interface.h
+STATUS_FORMAT = "<HBBbbHIHBB"
+STATUS_FIELDS = ("time_ms", "state", "segment", "velocity_left", "velocity_right",
+                 "heading", "distance_mm", "speed_ctrl_cycles", "idle_percent", "fault_mask")
+STATES = ("START", "STOP", "TELEOP")
+
+
+def crc16(data, crc=0xFFFF):
+    """CRC-16/CCITT-FALSE, as STD_LIB/crc16.c."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def frames(chunks):
+    """Yield (type, sequence, payload) of the valid frames found in a stream of byte chunks."""
+    buffer = bytearray()
+    for chunk in chunks:
+        buffer += chunk
+        while True:
+            start = buffer.find(SYNC)
+            if start < 0:
+                # Keep a last byte that may be the first sync byte
+                del buffer[:max(len(buffer) - 1, 0)]
+                break
+            del buffer[:start]
+            if len(buffer) < HEADER_SIZE:
+                break
+            length = buffer[3]
+            size = HEADER_SIZE + length + CRC_SIZE
+            if len(buffer) < size:
+                break
+            (crc,) = struct.unpack_from("<H", buffer, HEADER_SIZE + length)
+            if crc16(buffer[2:HEADER_SIZE + length]) != crc:
+                # Not a frame, or a corrupt one: look for the next sync bytes
+                del buffer[:1]
+                continue
+            (sequence,) = struct.unpack_from("<H", buffer, 4)
+            yield buffer[2], sequence, bytes(buffer[HEADER_SIZE:HEADER_SIZE + length])
+            del buffer[:size]
+
+
+def format_status(payload):
+    if len(payload) != struct.calcsize(STATUS_FORMAT):
+        return "status with a bad length (%d bytes)" % len(payload)
+    status = dict(zip(STATUS_FIELDS, struct.unpack(STATUS_FORMAT, payload)))
+    state = STATES[status["state"]] if status["state"] < len(STATES) else str(status["state"])
+    return ("t=%5u ms %-6s seg=%2u left=%4d%% right=%4d%% heading=%6.1f deg dist=%6u mm "
+            "ctrl=%5u cyc idle=%3u%% faults=0x%02X" % (
+                status["time_ms"], state, status["segment"], status["velocity_left"],
+                status["velocity_right"], status["heading"] * 360.0 / 65536.0,
+                status["distance_mm"], status["speed_ctrl_cycles"], status["idle_percent"],
+                status["fault_mask"]))
+
+
+def open_source(path):
+    """Yield the byte chunks of a capture file or a serial port."""
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        import serial  # pyserial
+        port = serial.Serial(path, BAUD_RATE, timeout=0.1)
+        while True:
+            yield port.read(256)
+    else:
+        with open(path, "rb") as capture:
+            while True:
+                chunk = capture.read(4096)
+                if not chunk:
+                    return
+                yield chunk
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("source", help="serial port or capture file")
+    args = parser.parse_args()
+
+    expected = None
+    lost = 0
+    try:
+        for frame_type, sequence, payload in frames(open_source(args.source)):
+            if expected is not None and sequence != expected:
+                missed = (sequence - expected) & 0xFFFF
+                lost += missed
+                print("-- %u frame(s) lost" % missed)
+            expected = (sequence + 1) & 0xFFFF
+            if frame_type == FRAME_STATUS:
+                print("#%5u %s" % (sequence, format_status(payload)))
+            else:
+                print("#%5u type %u: %s" % (sequence, frame_type, payload.hex()))
+    except KeyboardInterrupt:
+        pass
+    print("-- %u frame(s) lost in total" % lost, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()